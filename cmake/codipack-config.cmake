@@ -47,6 +47,7 @@ setVar(CheckExpressionArguments "Check for invalid arguments to expressions like
 setVar(CheckJacobianIsZero "Ignore Jacobians that are zero in Jacobian based tapes." BOOL)
 setVar(CheckTapeActivity "Makes it possible to ignore certain code parts. If turned of everything will be recorded." BOOL)
 setVar(CheckZeroIndex "Ignore active types that are not dependent on any input value in Jacobian tapes." BOOL)
+setVar(ChunkPoolHighWaterMark "Default maximum number of bytes that a ChunkPool retains for reuse." STRING)
 setVar(ChunkSize "Default size of chunks (ChunkBase) used in ChunkedData in reverse tape implementations." STRING)
 setVar(CopyOptimization "Do not store copy statements like a = b\; if the identity handler allows it." BOOL)
 setVar(EnableAssert "Enables asserts in CoDiPack for consistency checking." BOOL)
@@ -64,10 +65,12 @@ setVar(OverflowCheck "Check in the index manager if an overflow occurred." BOOL)
 setVar(PreaccEvents "Enable preaccumulation events. Disabled by default." BOOL)
 setVar(RemoveDuplicateJacobianArguments "Extra pass in Jacobian tapes that combines arguments with the same identifier." BOOL)
 setVar(ReversalZeroesAdjoints "With a linear index management, control if adjoints are set to zero during reversal." BOOL)
+setVar(ReversePrefetchDistance "Number of entries that Jacobian tapes look ahead in the reverse evaluation for prefetching adjoints." STRING)
 setVar(SkipZeroAdjointEvaluation "Do not perform a reverse evaluation of a statement if the seeding adjoint is zero." BOOL)
 setVar(SmallChunkSize "Default smaller size of chunks (ChunkBase) used in ChunkedData in reverse tape implementations." STRING)
 setVar(SortIndicesOnReset "Reuse index tapes will sort their indices on a reset." BOOL)
 setVar(StatementEvents "Enable statement events. Disabled by default." BOOL)
+setVar(StatementRunEvaluation "Linear primal value tapes evaluate runs of statements with the same handle with one call." BOOL)
 setVar(VariableAdjointInterfaceInPrimalTapes "Allow custom adjoint vector in primal values tapes." BOOL)
 
 set_target_properties(${CODIPACK_NAME} PROPERTIES
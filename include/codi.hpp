@@ -42,30 +42,44 @@
 #include "codi/expressions/real/allOperators.hpp"
 #include "codi/expressions/referenceActiveType.hpp"
 #include "codi/misc/enumBitset.hpp"
+#include "codi/tapes/data/allocationPolicies.hpp"
 #include "codi/tapes/data/blockData.hpp"
+#include "codi/tapes/data/chunkPool.hpp"
 #include "codi/tapes/data/chunkedData.hpp"
+#include "codi/tapes/data/compressedChunkedData.hpp"
+#include "codi/tapes/data/packedChunk.hpp"
 #include "codi/tapes/forwardEvaluation.hpp"
+#include "codi/tapes/indices/bitmapIndexManager.hpp"
+#include "codi/tapes/indices/deferredMultiUseIndexManager.hpp"
 #include "codi/tapes/indices/linearIndexManager.hpp"
 #include "codi/tapes/indices/multiUseIndexManager.hpp"
+#include "codi/tapes/indices/packedIdentifier.hpp"
 #include "codi/tapes/jacobianLinearTape.hpp"
 #include "codi/tapes/jacobianReuseTape.hpp"
 #include "codi/tapes/primalValueLinearTape.hpp"
 #include "codi/tapes/primalValueReuseTape.hpp"
 #include "codi/tapes/statementEvaluators/directStatementEvaluator.hpp"
 #include "codi/tapes/statementEvaluators/innerStatementEvaluator.hpp"
+#include "codi/tapes/statementEvaluators/opcodeStatementEvaluator.hpp"
 #include "codi/tapes/statementEvaluators/reverseStatementEvaluator.hpp"
 #include "codi/tapes/tagging/tagTapeForward.hpp"
 #include "codi/tapes/tagging/tagTapeReverse.hpp"
 #include "codi/tools/data/aggregatedTypeVectorAccessWrapper.hpp"
+#include "codi/tools/data/dependencyBits.hpp"
 #include "codi/tools/data/direction.hpp"
+#include "codi/tools/data/eliminationGraph.hpp"
 #include "codi/tools/data/externalFunctionUserData.hpp"
 #include "codi/tools/data/jacobian.hpp"
+#include "codi/tools/data/sparseHessian.hpp"
+#include "codi/tools/data/sparseJacobian.hpp"
+#include "codi/tools/data/sparsityPattern.hpp"
 #include "codi/tools/derivativeAccess.hpp"
 #include "codi/tools/helpers/customAdjointVectorHelper.hpp"
 #include "codi/tools/helpers/externalFunctionHelper.hpp"
 // #include "codi/tools/helpers/evaluationHelper.hpp" // Included at the end of this file.
 #include "codi/tools/helpers/linearSystem/linearSystemHandler.hpp"
 #include "codi/tools/helpers/preaccumulationHelper.hpp"
+#include "codi/tools/helpers/runtimeWidthAdjointVectorHelper.hpp"
 #include "codi/tools/helpers/statementPushHelper.hpp"
 #include "codi/tools/helpers/tapeHelper.hpp"
 #include "codi/tools/lowlevelFunctions/lowLevelFunctionCreationUtilities.hpp"
@@ -73,6 +87,11 @@
 #include "codi/traits/numericLimits.hpp"
 #include "codi/traits/tapeTraits.hpp"
 
+#if !defined(_WIN32)
+  #include "codi/tapes/data/mappedChunkedData.hpp"
+  #include "codi/tapes/data/spillingChunkedData.hpp"
+#endif
+
 #if CODI_EnableMPI
   #include "codi/tools/mpi/codiMpiTypes.hpp"
 #endif
@@ -108,6 +127,11 @@ namespace codi {
   template<size_t dim>
   using RealForwardVec = RealForwardGen<double, Direction<double, dim>>;
 
+  /// \copydoc codi::RealForwardVec <br><br>
+  /// The direction is aligned for explicit vectorization, see AlignedDirection.
+  template<size_t dim>
+  using RealForwardAlignedVec = RealForwardGen<double, AlignedDirection<double, dim>>;
+
   /// General reverse AD type. See \ref sec_reverseAD for a reverse mode AD explanation or \ref ActiveTypeList for a
   /// list of all types.
   ///
@@ -123,6 +147,11 @@ namespace codi {
   template<size_t dim>
   using RealReverseVec = RealReverseGen<double, Direction<double, dim>>;
 
+  /// \copydoc codi::RealReverseGen <br><br>
+  /// The direction is aligned for explicit vectorization, see AlignedDirection.
+  template<size_t dim>
+  using RealReverseAlignedVec = RealReverseGen<double, AlignedDirection<double, dim>>;
+
   /// General unchecked reverse AD type. See \ref sec_reverseAD for a reverse mode AD explanation or \ref ActiveTypeList
   /// for a list of all types.
   ///
@@ -151,6 +180,11 @@ namespace codi {
   template<size_t dim>
   using RealReverseIndexVec = RealReverseIndexGen<double, Direction<double, dim>>;
 
+  /// \copydoc codi::RealReverseIndexGen <br><br>
+  /// The direction is aligned for explicit vectorization, see AlignedDirection.
+  template<size_t dim>
+  using RealReverseIndexAlignedVec = RealReverseIndexGen<double, AlignedDirection<double, dim>>;
+
   /// General unchecked reverse AD type. See \ref sec_reverseAD for a reverse mode AD explanation or \ref ActiveTypeList
   /// for a list of all types.
   ///
@@ -86,6 +86,14 @@ namespace codi {
     size_t constexpr ByteDataChunkSize = CODI_ByteDataChunkSize;
 #undef CODI_ByteDataChunkSize
 
+#ifndef CODI_ChunkPoolHighWaterMark
+  /// See codi::Config::ChunkPoolHighWaterMark.
+  #define CODI_ChunkPoolHighWaterMark 1073741824
+#endif
+    /// Default maximum number of bytes that a ChunkPool retains for reuse.
+    size_t constexpr ChunkPoolHighWaterMark = CODI_ChunkPoolHighWaterMark;
+#undef CODI_ChunkPoolHighWaterMark
+
 #ifndef CODI_ChunkSize
   /// See codi::Config::ChunkSize.
   #define CODI_ChunkSize 2097152
@@ -125,6 +133,15 @@ namespace codi {
     /// Statement tag for low level functions.
     size_t constexpr StatementLowLevelFunctionTag = 254;
 
+#ifndef CODI_ReversePrefetchDistance
+  /// See codi::Config::ReversePrefetchDistance.
+  #define CODI_ReversePrefetchDistance 0
+#endif
+    /// Number of entries that Jacobian tapes look ahead in the reverse evaluation for prefetching adjoints. Zero
+    /// disables the prefetching.
+    size_t constexpr ReversePrefetchDistance = CODI_ReversePrefetchDistance;
+#undef CODI_ReversePrefetchDistance
+
 #ifndef CODI_SmallChunkSize
   /// See codi::Config::SmallChunkSize.
   #define CODI_SmallChunkSize 32768
@@ -264,6 +281,14 @@ namespace codi {
     bool constexpr SortIndicesOnReset = CODI_SortIndicesOnReset;
 #undef CODI_SortIndicesOnReset
 
+#ifndef CODI_StatementRunEvaluation
+  /// See codi::Config::StatementRunEvaluation.
+  #define CODI_StatementRunEvaluation false
+#endif
+    /// Linear primal value tapes evaluate runs of statements with the same handle with one call.
+    bool constexpr StatementRunEvaluation = CODI_StatementRunEvaluation;
+#undef CODI_StatementRunEvaluation
+
 #ifndef CODI_VariableAdjointInterfaceInPrimalTapes
   /// See codi::Config::VariableAdjointInterfaceInPrimalTapes.
   #define CODI_VariableAdjointInterfaceInPrimalTapes 0
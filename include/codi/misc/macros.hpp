@@ -64,6 +64,14 @@ namespace codi {
 /// Check for CPP 17 standard.
 #define CODI_IS_CPP17 (201703L <= __cplusplus)
 
+#if defined(__GNUC__) || defined(__clang__)
+  /// Hint that the memory at the address will be read and written soon.
+  #define CODI_PREFETCH_WRITE(address) __builtin_prefetch((address), 1)
+#else
+  /// Hint that the memory at the address will be read and written soon. Not supported by this compiler.
+  #define CODI_PREFETCH_WRITE(address) CODI_UNUSED(address)
+#endif
+
 /*******************************************************************************/
 /** @name Default template type declarations
  *  @anchor TemplateDeclarationHelpers
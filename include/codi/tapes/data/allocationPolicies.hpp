@@ -0,0 +1,369 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+#include <string>
+
+#if defined(__linux__)
+  #include <sys/mman.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+#include "../../config.h"
+#include "../../misc/macros.hpp"
+#include "chunk.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+  /**
+   * @brief Allocation policies select the memory for chunks and adjoint vectors.
+   *
+   * A policy is a type with the static functions
+   * - getMemoryResource(): The ChunkMemoryResource for the arrays, nullptr selects new[] and std::allocator.
+   * - getName(): Name of the policy for TapeValues.
+   *
+   * Policies are template arguments of ChunkedData, LocalAdjoints, and ThreadSafeGlobalAdjoints.
+   */
+  struct DefaultAllocationPolicy {
+    public:
+
+      /// No memory resource.
+      static ChunkMemoryResource* getMemoryResource() {
+        return nullptr;
+      }
+
+      /// Name for TapeValues.
+      static std::string getName() {
+        return "Default";
+      }
+  };
+
+  /// Page size of the mappings.
+  enum class HugePageMode {
+    None,         ///< Regular pages.
+    Transparent,  ///< Transparent huge pages, requested with madvise.
+    HugeTlb       ///< Huge pages from the hugetlbfs pool. Falls back to transparent huge pages if none are reserved.
+  };
+
+  /// Placement of the pages on NUMA nodes.
+  enum class NumaPlacement {
+    Default,     ///< Process policy.
+    FirstTouch,  ///< Pages are placed on the node of the thread that first writes to them.
+    Interleaved  ///< Pages are distributed round robin over all nodes.
+  };
+
+  /**
+   * @brief Memory resource that allocates anonymous mappings with the given page size and NUMA placement.
+   *
+   * Huge page mappings are aligned to and padded to 2 MB, other mappings to the page size or to larger requested
+   * alignments. NUMA placement is set with the mbind system call, such that
+   * libnuma is not required. All settings are hints: If the system does not support them, regular pages with the
+   * default placement are used. On non Linux systems, the memory is allocated with operator new.
+   */
+  struct MappedMemoryResource : public ChunkMemoryResource {
+    public:
+
+      static size_t constexpr HugePageSize = 2 * 1024 * 1024;  ///< Size of the huge pages.
+
+    private:
+
+      HugePageMode hugePages;
+      NumaPlacement placement;
+
+    public:
+
+      /// Constructor
+      MappedMemoryResource(HugePageMode hugePages, NumaPlacement placement)
+          : hugePages(hugePages), placement(placement) {}
+
+      /// \copydoc ChunkMemoryResource::allocate
+      void* allocate(size_t bytes, size_t alignment) {
+#if defined(__linux__)
+        size_t pageSize = getPageSize(alignment);
+        size_t size = mappingSize(bytes, alignment);
+        void* memory = MAP_FAILED;
+
+  #if defined(MAP_HUGETLB)
+        if (HugePageMode::HugeTlb == hugePages && alignment <= HugePageSize) {
+          memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        }
+  #endif
+
+        if (MAP_FAILED == memory) {
+          if (pageSize <= (size_t)sysconf(_SC_PAGESIZE)) {
+            // Regular mappings are page aligned.
+            memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+          } else {
+            memory = mapAligned(size, pageSize);
+          }
+        }
+
+        if (MAP_FAILED == memory) {
+          throw std::bad_alloc();
+        }
+
+        setPlacement(memory, size);
+
+        return memory;
+#else
+        return allocateWithNew(bytes, alignment);
+#endif
+      }
+
+      /// \copydoc ChunkMemoryResource::free
+      void free(void* memory, size_t bytes, size_t alignment) {
+#if defined(__linux__)
+        munmap(memory, mappingSize(bytes, alignment));
+#else
+        CODI_UNUSED(bytes);
+        freeWithNew(memory, alignment);
+#endif
+      }
+
+    private:
+
+#if defined(__linux__)
+      /// Alignment and size granularity of the mapping.
+      size_t getPageSize(size_t alignment) const {
+        size_t pageSize = HugePageMode::None == hugePages ? (size_t)sysconf(_SC_PAGESIZE) : (size_t)HugePageSize;
+
+        return std::max(pageSize, alignment);
+      }
+
+      size_t mappingSize(size_t bytes, size_t alignment) const {
+        size_t pageSize = getPageSize(alignment);
+
+        return (bytes + pageSize - 1) / pageSize * pageSize;
+      }
+
+      /// Map with the given alignment and request transparent huge pages if they are enabled.
+      void* mapAligned(size_t size, size_t alignment) const {
+        size_t padded = size + alignment;
+        void* mapping = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (MAP_FAILED == mapping) {
+          return mapping;
+        }
+
+        // Release the unaligned parts at the front and the back.
+        uintptr_t begin = (uintptr_t)mapping;
+        uintptr_t aligned = (begin + alignment - 1) / alignment * alignment;
+        if (aligned != begin) {
+          munmap(mapping, aligned - begin);
+        }
+        if (aligned + size != begin + padded) {
+          munmap((void*)(aligned + size), begin + padded - aligned - size);
+        }
+
+  #if defined(MADV_HUGEPAGE)
+        if (HugePageMode::None != hugePages) {
+          madvise((void*)aligned, size, MADV_HUGEPAGE);
+        }
+  #endif
+
+        return (void*)aligned;
+      }
+
+      void setPlacement(void* memory, size_t size) const {
+  #if defined(SYS_mbind)
+        int const MpolInterleave = 3;  // Values from linux/mempolicy.h.
+        int const MpolLocal = 4;
+
+        if (NumaPlacement::Interleaved == placement) {
+          unsigned long nodeMask = getOnlineNodes();
+          syscall(SYS_mbind, memory, size, MpolInterleave, &nodeMask, sizeof(nodeMask) * 8, 0);
+        } else if (NumaPlacement::FirstTouch == placement) {
+          syscall(SYS_mbind, memory, size, MpolLocal, nullptr, 0, 0);
+        }
+  #else
+        CODI_UNUSED(memory, size);
+  #endif
+      }
+
+      /// Bit mask of the online nodes, node 0 if it can not be determined.
+      static unsigned long getOnlineNodes() {
+        static unsigned long const mask = readOnlineNodes();
+
+        return mask;
+      }
+
+      static unsigned long readOnlineNodes() {
+        unsigned long mask = 0;
+
+        // Format is a list of ranges, e.g. 0-1,3.
+        FILE* file = fopen("/sys/devices/system/node/online", "r");
+        if (nullptr != file) {
+          unsigned int first = 0;
+          unsigned int last = 0;
+          int separator = 0;
+          while (1 == fscanf(file, "%u", &first)) {
+            last = first;
+            separator = fgetc(file);
+            if ('-' == separator) {
+              if (1 != fscanf(file, "%u", &last)) {
+                break;
+              }
+              separator = fgetc(file);
+            }
+
+            for (unsigned int node = first; node <= last && node < sizeof(mask) * 8; node += 1) {
+              mask |= 1ul << node;
+            }
+
+            if (',' != separator) {
+              break;
+            }
+          }
+          fclose(file);
+        }
+
+        if (0 == mask) {
+          mask = 1;
+        }
+
+        return mask;
+      }
+#endif
+  };
+
+  /**
+   * @brief Allocation policy for mappings with huge pages and NUMA placement. See MappedMemoryResource.
+   *
+   * @tparam hugePages  Page size of the mappings.
+   * @tparam placement  NUMA placement of the pages.
+   */
+  template<HugePageMode hugePages, NumaPlacement placement>
+  struct MappedAllocationPolicy {
+    public:
+
+      /// The memory resource for the settings.
+      static ChunkMemoryResource* getMemoryResource() {
+        static MappedMemoryResource resource(hugePages, placement);
+
+        return &resource;
+      }
+
+      /// Name for TapeValues.
+      static std::string getName() {
+        char const* const hugePageNames[] = {"Regular pages", "Transparent huge pages", "HugeTLB pages"};
+        char const* const placementNames[] = {"", ", first touch", ", interleaved"};
+
+        return std::string(hugePageNames[(int)hugePages]) + placementNames[(int)placement];
+      }
+  };
+
+  /// 2 MB transparent huge pages.
+  using TransparentHugePagePolicy = MappedAllocationPolicy<HugePageMode::Transparent, NumaPlacement::Default>;
+
+  /// 2 MB pages from the hugetlbfs pool.
+  using HugeTlbPolicy = MappedAllocationPolicy<HugePageMode::HugeTlb, NumaPlacement::Default>;
+
+  /// Pages are placed on the node of the thread that writes them first.
+  using FirstTouchNumaPolicy = MappedAllocationPolicy<HugePageMode::None, NumaPlacement::FirstTouch>;
+
+  /// Pages are interleaved over all NUMA nodes.
+  using InterleavedNumaPolicy = MappedAllocationPolicy<HugePageMode::None, NumaPlacement::Interleaved>;
+
+  /**
+   * @brief Standard allocator that uses the memory resource of an allocation policy.
+   *
+   * Used for the std::vector members of the adjoint implementations.
+   *
+   * @tparam T_T                 Value type.
+   * @tparam T_AllocationPolicy  See DefaultAllocationPolicy.
+   */
+  template<typename T_T, typename T_AllocationPolicy>
+  struct PolicyAllocator {
+    public:
+
+      using T = CODI_DD(T_T, CODI_ANY);                                                 ///< See PolicyAllocator.
+      using AllocationPolicy = CODI_DD(T_AllocationPolicy, DefaultAllocationPolicy);  ///< See PolicyAllocator.
+
+      using value_type = T;  ///< Allocator value type.
+
+      /// Rebind to another value type.
+      template<typename U>
+      struct rebind {
+        public:
+          using other = PolicyAllocator<U, AllocationPolicy>;  ///< Rebound allocator.
+      };
+
+      /// Constructor
+      PolicyAllocator() {}
+
+      /// Conversion constructor
+      template<typename U>
+      PolicyAllocator(PolicyAllocator<U, AllocationPolicy> const&) {}
+
+      /// Allocate n values. The memory is aligned to alignof(T), see ChunkMemoryResource::allocateWithNew for the
+      /// default policy.
+      T* allocate(size_t n) {
+        ChunkMemoryResource* resource = AllocationPolicy::getMemoryResource();
+        if (nullptr == resource) {
+          return static_cast<T*>(ChunkMemoryResource::allocateWithNew(n * sizeof(T), alignof(T)));
+        } else {
+          return static_cast<T*>(resource->allocate(n * sizeof(T), alignof(T)));
+        }
+      }
+
+      /// Deallocate memory from allocate().
+      void deallocate(T* p, size_t n) {
+        ChunkMemoryResource* resource = AllocationPolicy::getMemoryResource();
+        if (nullptr == resource) {
+          ChunkMemoryResource::freeWithNew(p, alignof(T));
+        } else {
+          resource->free(p, n * sizeof(T), alignof(T));
+        }
+      }
+
+      /// All allocators of a policy are interchangeable.
+      template<typename U>
+      bool operator==(PolicyAllocator<U, AllocationPolicy> const&) const {
+        return true;
+      }
+
+      /// All allocators of a policy are interchangeable.
+      template<typename U>
+      bool operator!=(PolicyAllocator<U, AllocationPolicy> const&) const {
+        return false;
+      }
+  };
+}
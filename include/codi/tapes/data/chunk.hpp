@@ -35,6 +35,7 @@
 #pragma once
 
 #include <cstddef>
+#include <new>
 
 #include "../../config.h"
 #include "../../misc/fileIo.hpp"
@@ -43,6 +44,55 @@
 /** \copydoc codi::Namespace */
 namespace codi {
 
+  /**
+   * @brief Provides the memory for the data arrays of chunks.
+   *
+   * By default, chunks allocate their arrays with new[]. A DataInterface implementation can provide a memory resource
+   * to its chunks in order to place the arrays in other kinds of memory, e.g., file backed mappings. The chunk
+   * constructs and destructs the entries in the provided memory.
+   */
+  struct ChunkMemoryResource {
+    public:
+
+      /// Destructor
+      virtual ~ChunkMemoryResource() {}
+
+      /// Allocate uninitialized memory with the given size. The memory is aligned to alignment, which is a power of
+      /// two.
+      virtual void* allocate(size_t bytes, size_t alignment) = 0;
+
+      /// Free memory that was obtained from allocate() with the same size and alignment.
+      virtual void free(void* memory, size_t bytes, size_t alignment) = 0;
+
+      /// Allocate with operator new. Alignments above the default alignment of operator new require C++17, before
+      /// C++17 the alignment is not guaranteed for them.
+      static void* allocateWithNew(size_t bytes, size_t alignment) {
+#if CODI_IS_CPP17
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+          return ::operator new(bytes, std::align_val_t(alignment));
+        }
+#else
+        CODI_UNUSED(alignment);
+#endif
+
+        return ::operator new(bytes);
+      }
+
+      /// Free memory that was obtained from allocateWithNew() with the same alignment.
+      static void freeWithNew(void* memory, size_t alignment) {
+#if CODI_IS_CPP17
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+          ::operator delete(memory, std::align_val_t(alignment));
+          return;
+        }
+#else
+        CODI_UNUSED(alignment);
+#endif
+
+        ::operator delete(memory);
+      }
+  };
+
   /**
    * @brief A chunk stores a contiguous block of data in CoDiPack.
    *
@@ -72,6 +122,7 @@ namespace codi {
    *   - allocateData() / deleteData(): Allocate / delete the data arrays.
    *   - readData() / writeData(): Read / write the data in the arrays to the IO object.
    *
+   * The data arrays are allocated with new[] unless a ChunkMemoryResource is provided in the constructor.
    */
   struct ChunkBase {
     public:
@@ -120,10 +171,13 @@ namespace codi {
       size_t size;      ///< Maximum size of arrays.
       size_t usedSize;  ///< Currently used size.
 
+      ChunkMemoryResource* memoryResource;  ///< Provides the memory for the arrays. new[] is used if not set.
+
     public:
 
       /// Constructor
-      CODI_INLINE explicit ChunkBase(size_t const& size) : size(size), usedSize(0) {}
+      CODI_INLINE explicit ChunkBase(size_t const& size, ChunkMemoryResource* memoryResource = nullptr)
+          : size(size), usedSize(0), memoryResource(memoryResource) {}
 
       /// Destructor
       CODI_INLINE virtual ~ChunkBase() {}
@@ -165,14 +219,49 @@ namespace codi {
         usedSize = usage;
       }
 
+      /// Get the memory resource of the data arrays. nullptr if new[] is used.
+      CODI_INLINE ChunkMemoryResource* getMemoryResource() const {
+        return memoryResource;
+      }
+
       /// @}
 
     protected:
 
+      /// Allocate an array with the given number of entries. Uses the memory resource if one is set.
+      template<typename Data>
+      CODI_INLINE Data* allocateArray(size_t const& count) {
+        if (nullptr == memoryResource) {
+          return new Data[count];
+        } else {
+          Data* array = static_cast<Data*>(memoryResource->allocate(count * sizeof(Data), alignof(Data)));
+          for (size_t i = 0; i < count; i += 1) {
+            new (&array[i]) Data;
+          }
+
+          return array;
+        }
+      }
+
+      /// Delete an array that was created with allocateArray().
+      template<typename Data>
+      CODI_INLINE void deleteArray(Data* array, size_t const& count) {
+        if (nullptr == memoryResource) {
+          delete[] array;
+        } else {
+          for (size_t i = 0; i < count; i += 1) {
+            array[i].~Data();
+          }
+
+          memoryResource->free(array, count * sizeof(Data), alignof(Data));
+        }
+      }
+
       /// Swap the entries of this base class.
       CODI_INLINE void swap(ChunkBase& other) {
         std::swap(size, other.size);
         std::swap(usedSize, other.usedSize);
+        std::swap(memoryResource, other.memoryResource);
       }
   };
 
@@ -187,6 +276,8 @@ namespace codi {
 
       using Base = ChunkBase;  ///< Abbreviation for the base class type.
 
+      using Pointer1 = Data1*;  ///< Pointer type for entry 1, see dataPointer().
+
     private:
 
       Data1* data1;
@@ -194,7 +285,8 @@ namespace codi {
     public:
 
       /// Constructor
-      CODI_INLINE Chunk1(size_t const& size) : ChunkBase(size), data1(nullptr) {
+      CODI_INLINE Chunk1(size_t const& size, ChunkMemoryResource* memoryResource = nullptr)
+          : ChunkBase(size, memoryResource), data1(nullptr) {
         allocateData();
       }
 
@@ -212,7 +304,7 @@ namespace codi {
       /// \copydoc ChunkBase::allocateData()
       CODI_INLINE void allocateData() {
         if (nullptr == data1) {
-          data1 = new Data1[size];
+          data1 = allocateArray<Data1>(size);
         }
       }
 
@@ -225,7 +317,7 @@ namespace codi {
       /// \copydoc ChunkBase::deleteData
       CODI_INLINE void deleteData() {
         if (nullptr != data1) {
-          delete[] data1;
+          deleteArray(data1, size);
           data1 = nullptr;
         }
       }
@@ -285,6 +377,9 @@ namespace codi {
 
       using Base = ChunkBase;  ///< Abbreviation for the base class type.
 
+      using Pointer1 = Data1*;  ///< Pointer type for entry 1, see dataPointer().
+      using Pointer2 = Data2*;  ///< Pointer type for entry 2, see dataPointer().
+
     private:
 
       Data1* data1;
@@ -293,7 +388,8 @@ namespace codi {
     public:
 
       /// Constructor
-      CODI_INLINE Chunk2(size_t const& size) : ChunkBase(size), data1(nullptr), data2(nullptr) {
+      CODI_INLINE Chunk2(size_t const& size, ChunkMemoryResource* memoryResource = nullptr)
+          : ChunkBase(size, memoryResource), data1(nullptr), data2(nullptr) {
         allocateData();
       }
 
@@ -311,11 +407,11 @@ namespace codi {
       /// \copydoc ChunkBase::allocateData()
       CODI_INLINE void allocateData() {
         if (nullptr == data1) {
-          data1 = new Data1[size];
+          data1 = allocateArray<Data1>(size);
         }
 
         if (nullptr == data2) {
-          data2 = new Data2[size];
+          data2 = allocateArray<Data2>(size);
         }
       }
 
@@ -329,12 +425,12 @@ namespace codi {
       /// \copydoc ChunkBase::deleteData
       CODI_INLINE void deleteData() {
         if (nullptr != data1) {
-          delete[] data1;
+          deleteArray(data1, size);
           data1 = nullptr;
         }
 
         if (nullptr != data2) {
-          delete[] data2;
+          deleteArray(data2, size);
           data2 = nullptr;
         }
       }
@@ -402,6 +498,10 @@ namespace codi {
 
       using Base = ChunkBase;  ///< Abbreviation for the base class type.
 
+      using Pointer1 = Data1*;  ///< Pointer type for entry 1, see dataPointer().
+      using Pointer2 = Data2*;  ///< Pointer type for entry 2, see dataPointer().
+      using Pointer3 = Data3*;  ///< Pointer type for entry 3, see dataPointer().
+
     private:
 
       Data1* data1;
@@ -411,7 +511,8 @@ namespace codi {
     public:
 
       /// Constructor
-      CODI_INLINE Chunk3(size_t const& size) : ChunkBase(size), data1(nullptr), data2(nullptr), data3(nullptr) {
+      CODI_INLINE Chunk3(size_t const& size, ChunkMemoryResource* memoryResource = nullptr)
+          : ChunkBase(size, memoryResource), data1(nullptr), data2(nullptr), data3(nullptr) {
         allocateData();
       }
 
@@ -430,15 +531,15 @@ namespace codi {
       /// \copydoc ChunkBase::allocateData()
       CODI_INLINE void allocateData() {
         if (nullptr == data1) {
-          data1 = new Data1[size];
+          data1 = allocateArray<Data1>(size);
         }
 
         if (nullptr == data2) {
-          data2 = new Data2[size];
+          data2 = allocateArray<Data2>(size);
         }
 
         if (nullptr == data3) {
-          data3 = new Data3[size];
+          data3 = allocateArray<Data3>(size);
         }
       }
 
@@ -453,17 +554,17 @@ namespace codi {
       /// \copydoc ChunkBase::deleteData
       CODI_INLINE void deleteData() {
         if (nullptr != data1) {
-          delete[] data1;
+          deleteArray(data1, size);
           data1 = nullptr;
         }
 
         if (nullptr != data2) {
-          delete[] data2;
+          deleteArray(data2, size);
           data2 = nullptr;
         }
 
         if (nullptr != data3) {
-          delete[] data3;
+          deleteArray(data3, size);
           data3 = nullptr;
         }
       }
@@ -539,6 +640,11 @@ namespace codi {
 
       using Base = ChunkBase;  ///< Abbreviation for the base class type.
 
+      using Pointer1 = Data1*;  ///< Pointer type for entry 1, see dataPointer().
+      using Pointer2 = Data2*;  ///< Pointer type for entry 2, see dataPointer().
+      using Pointer3 = Data3*;  ///< Pointer type for entry 3, see dataPointer().
+      using Pointer4 = Data4*;  ///< Pointer type for entry 4, see dataPointer().
+
     private:
 
       Data1* data1;
@@ -549,8 +655,8 @@ namespace codi {
     public:
 
       /// Constructor
-      CODI_INLINE Chunk4(size_t const& size)
-          : ChunkBase(size), data1(nullptr), data2(nullptr), data3(nullptr), data4(nullptr) {
+      CODI_INLINE Chunk4(size_t const& size, ChunkMemoryResource* memoryResource = nullptr)
+          : ChunkBase(size, memoryResource), data1(nullptr), data2(nullptr), data3(nullptr), data4(nullptr) {
         allocateData();
       }
 
@@ -569,19 +675,19 @@ namespace codi {
       /// \copydoc ChunkBase::allocateData()
       CODI_INLINE void allocateData() {
         if (nullptr == data1) {
-          data1 = new Data1[size];
+          data1 = allocateArray<Data1>(size);
         }
 
         if (nullptr == data2) {
-          data2 = new Data2[size];
+          data2 = allocateArray<Data2>(size);
         }
 
         if (nullptr == data3) {
-          data3 = new Data3[size];
+          data3 = allocateArray<Data3>(size);
         }
 
         if (nullptr == data4) {
-          data4 = new Data4[size];
+          data4 = allocateArray<Data4>(size);
         }
       }
 
@@ -598,22 +704,22 @@ namespace codi {
       /// \copydoc ChunkBase::deleteData
       CODI_INLINE void deleteData() {
         if (nullptr != data1) {
-          delete[] data1;
+          deleteArray(data1, size);
           data1 = nullptr;
         }
 
         if (nullptr != data2) {
-          delete[] data2;
+          deleteArray(data2, size);
           data2 = nullptr;
         }
 
         if (nullptr != data3) {
-          delete[] data3;
+          deleteArray(data3, size);
           data3 = nullptr;
         }
 
         if (nullptr != data4) {
-          delete[] data4;
+          deleteArray(data4, size);
           data4 = nullptr;
         }
       }
@@ -0,0 +1,270 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../config.h"
+#include "../../misc/macros.hpp"
+#include "../misc/tapeValues.hpp"
+#include "chunk.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+  /**
+   * @brief Memory resource that keeps the arrays of deleted chunks for later reuse.
+   *
+   * Arrays that are freed are stored in a free list for their size and alignment, up to the high-water mark of retained bytes.
+   * Arrays beyond the high-water mark are released to the system. Allocations are served from the free lists if
+   * possible. Tapes that are recorded repeatedly with a similar size therefore do not allocate memory after the first
+   * recording, and the pages of the reused arrays are already mapped.
+   *
+   * If pre-touching is enabled, new arrays are written once per page when they are allocated, such that the page
+   * faults do not occur during the recording. reserve() can be used to fill the pool before the first recording.
+   *
+   * All operations are thread safe.
+   */
+  struct ChunkPool : public ChunkMemoryResource {
+    public:
+
+      static size_t constexpr PageSize = 4096;  ///< Stride for pre-touching the memory.
+
+    private:
+
+      using ArrayKey = std::pair<size_t, size_t>;  // Size and alignment of the arrays.
+
+      std::map<ArrayKey, std::vector<void*>> freeArrays;
+
+      size_t retainedBytes;
+      size_t highWaterMark;
+      bool preTouch;
+
+      size_t reusedArrays;
+      size_t allocatedArrays;
+
+      std::mutex mutex;
+
+    public:
+
+      /// Constructor
+      explicit ChunkPool(size_t highWaterMark = Config::ChunkPoolHighWaterMark, bool preTouch = false)
+          : freeArrays(),
+            retainedBytes(0),
+            highWaterMark(highWaterMark),
+            preTouch(preTouch),
+            reusedArrays(0),
+            allocatedArrays(0),
+            mutex() {}
+
+      /// Destructor
+      ~ChunkPool() {
+        releaseFreeArrays(0);
+      }
+
+      /*******************************************************************************/
+      /// @name ChunkMemoryResource interface
+      /// @{
+
+      /// \copydoc ChunkMemoryResource::allocate
+      void* allocate(size_t bytes, size_t alignment) {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+
+          std::vector<void*>& list = freeArrays[ArrayKey(bytes, alignment)];
+          if (!list.empty()) {
+            void* memory = list.back();
+            list.pop_back();
+            retainedBytes -= bytes;
+            reusedArrays += 1;
+
+            return memory;
+          }
+
+          allocatedArrays += 1;
+        }
+
+        return createArray(bytes, alignment);
+      }
+
+      /// \copydoc ChunkMemoryResource::free
+      void free(void* memory, size_t bytes, size_t alignment) {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+
+          if (retainedBytes + bytes <= highWaterMark) {
+            freeArrays[ArrayKey(bytes, alignment)].push_back(memory);
+            retainedBytes += bytes;
+
+            return;
+          }
+        }
+
+        freeWithNew(memory, alignment);
+      }
+
+      /// @}
+      /*******************************************************************************/
+      /// @name Pool management
+      /// @{
+
+      /// Allocate the arrays for the given number of chunks and store them in the pool. The arrays are pre-touched
+      /// if this is enabled. Arrays beyond the high-water mark are released directly.
+      template<typename Chunk>
+      void reserve(size_t const& chunkSize, size_t const& count) {
+        std::vector<Chunk*> chunks(count);
+        for (size_t i = 0; i < count; i += 1) {
+          chunks[i] = new Chunk(chunkSize, this);
+        }
+        for (size_t i = 0; i < count; i += 1) {
+          delete chunks[i];
+        }
+      }
+
+      /// Release all retained arrays to the system.
+      void clear() {
+        releaseFreeArrays(0);
+      }
+
+      /// Maximum number of bytes that are retained. Retained arrays are released if the new mark is lower.
+      void setHighWaterMark(size_t const& bytes) {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          highWaterMark = bytes;
+        }
+        releaseFreeArrays(bytes);
+      }
+
+      /// \copydoc setHighWaterMark
+      size_t getHighWaterMark() const {
+        return highWaterMark;
+      }
+
+      /// Enable or disable the pre-touching of new arrays.
+      void setPreTouch(bool value) {
+        preTouch = value;
+      }
+
+      /// \copydoc setPreTouch
+      bool getPreTouch() const {
+        return preTouch;
+      }
+
+      /// Number of bytes in the free lists.
+      size_t getRetainedBytes() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return retainedBytes;
+      }
+
+      /// Adds: Pool retained, Pool reused arrays, Pool allocated arrays
+      void addToTapeValues(TapeValues& values) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        values.addDoubleEntry("Pool retained", (double)retainedBytes, false, false);
+        values.addUnsignedLongEntry("Pool reused arrays", reusedArrays);
+        values.addUnsignedLongEntry("Pool allocated arrays", allocatedArrays);
+      }
+
+      /// @}
+
+    private:
+
+      void* createArray(size_t bytes, size_t alignment) {
+        char* memory = static_cast<char*>(allocateWithNew(bytes, alignment));
+
+        if (preTouch) {
+          for (size_t pos = 0; pos < bytes; pos += PageSize) {
+            memory[pos] = 0;
+          }
+        }
+
+        return memory;
+      }
+
+      void releaseFreeArrays(size_t const& keepBytes) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        std::map<ArrayKey, std::vector<void*>>::iterator iter = freeArrays.begin();
+        while (retainedBytes > keepBytes && iter != freeArrays.end()) {
+          std::vector<void*>& list = iter->second;
+          while (retainedBytes > keepBytes && !list.empty()) {
+            freeWithNew(list.back(), iter->first.second);
+            list.pop_back();
+            retainedBytes -= iter->first.first;
+          }
+
+          ++iter;
+        }
+      }
+  };
+
+  /**
+   * @brief Allocation policy for a process wide ChunkPool. See DefaultAllocationPolicy.
+   *
+   * Each tag type has its own pool, e.g., the pool can be separated for different tape types.
+   *
+   * @tparam T_Tag  Any type.
+   */
+  template<typename T_Tag = void>
+  struct StaticChunkPool {
+    public:
+
+      using Tag = CODI_DD(T_Tag, void);  ///< See StaticChunkPool.
+
+      /// The pool for the tag.
+      static ChunkPool& getInstance() {
+        // Created before the first chunk that uses it, therefore destroyed after all chunks in static objects.
+        static ChunkPool pool;
+
+        return pool;
+      }
+
+      /// The pool as memory resource.
+      static ChunkMemoryResource* getMemoryResource() {
+        return &getInstance();
+      }
+
+      /// Name for TapeValues.
+      static std::string getName() {
+        return "Chunk pool";
+      }
+  };
+}
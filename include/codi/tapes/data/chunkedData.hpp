@@ -34,14 +34,18 @@
  */
 #pragma once
 
+#include <type_traits>
 #include <vector>
 
 #include "../../config.h"
 #include "../../misc/macros.hpp"
-#include "../../traits/misc/enableIfHelpers.hpp"
+#include "allocationPolicies.hpp"
 #include "chunk.hpp"
+#include "chunkPool.hpp"
+#include "chunkedDataBase.hpp"
 #include "dataInterface.hpp"
 #include "emptyData.hpp"
+#include "packedChunk.hpp"
 #include "pointerStore.hpp"
 #include "position.hpp"
 
@@ -54,199 +58,43 @@ namespace codi {
    *
    * See DataInterface documentation for details.
    *
-   * Each chunk has the size provided in the constructor.
+   * Each chunk has the size provided in the constructor. All chunks are kept in memory, see ChunkedDataBase.
    *
-   * @tparam T_Chunk            Has to implement ChunkBase. The chunk defines the data stored in this implementation.
-   * @tparam T_NestedData       Nested DataInterface.
-   * @tparam T_PointerInserter  Defines how data is appended to evaluate* function calls.
+   * The allocation policy selects the ChunkMemoryResource for the chunk arrays, e.g., huge pages or a NUMA placement.
+   * With StaticChunkPool, the arrays of deleted chunks, e.g., in resetHard() and erase(), are kept for the next
+   * recording.
+   *
+   * @tparam T_Chunk             Has to implement ChunkBase. The chunk defines the data stored in this implementation.
+   * @tparam T_NestedData        Nested DataInterface.
+   * @tparam T_PointerInserter   Defines how data is appended to evaluate* function calls.
+   * @tparam T_AllocationPolicy  Provides the memory resource for the chunks. See DefaultAllocationPolicy.
    */
-  template<typename T_Chunk, typename T_NestedData = EmptyData, typename T_PointerInserter = PointerStore<T_Chunk>>
-  struct ChunkedData : public DataInterface<T_NestedData> {
+  template<typename T_Chunk, typename T_NestedData = EmptyData, typename T_PointerInserter = PointerStore<T_Chunk>,
+           typename T_AllocationPolicy = DefaultAllocationPolicy>
+  struct ChunkedData
+      : public ChunkedDataBase<T_Chunk, T_NestedData, T_PointerInserter,
+                               ChunkedData<T_Chunk, T_NestedData, T_PointerInserter, T_AllocationPolicy>> {
     public:
 
       using Chunk = CODI_DD(T_Chunk, Chunk1<CODI_ANY>);                                 ///< See ChunkedData
       using NestedData = CODI_DD(T_NestedData, CODI_T(DataInterface<CODI_ANY>));        ///< See ChunkedData
       using PointerInserter = CODI_DD(T_PointerInserter, CODI_T(PointerStore<Chunk>));  ///< See ChunkedData
+      using AllocationPolicy = CODI_DD(T_AllocationPolicy, DefaultAllocationPolicy);    ///< See ChunkedData
 
-      using InternalPosHandle = size_t;                      ///< Position in the chunk
-      using NestedPosition = typename NestedData::Position;  ///< Position of NestedData
-
-      /// For selectedDepth == 0 create a pointer inserter that calls the function object.
-      template<int selectedDepth>
-      using NestingDepthPointerInserter =
-          typename std::conditional<selectedDepth == 0, TerminatingPointerStore<PointerInserter>,
-                                    PointerInserter>::type;
-
-      using Position = ChunkPosition<NestedPosition>;  ///< \copydoc DataInterface::Position
-
-    private:
-      std::vector<Chunk*> chunks;
-      std::vector<NestedPosition> positions;
-
-      Chunk* curChunk;
-      size_t curChunkIndex;
-
-      size_t chunkSize;
-
-      NestedData* nested;
-
-    public:
+      using Base = ChunkedDataBase<Chunk, NestedData, PointerInserter, ChunkedData>;  ///< Base class abbreviation.
+      friend Base;  ///< Allow the base class to call protected and private methods.
 
       /// Allocate chunkSize entries and set the nested DataInterface.
-      ChunkedData(size_t const& chunkSize, NestedData* nested)
-          : chunks(), positions(), curChunk(nullptr), curChunkIndex(0), chunkSize(chunkSize), nested(nullptr) {
-        setNested(nested);
+      ChunkedData(size_t const& chunkSize, NestedData* nested) : Base(chunkSize) {
+        Base::setNested(nested);
       }
 
       /// Allocate chunkSize entries. Requires a call to #setNested.
-      ChunkedData(size_t const& chunkSize)
-          : chunks(), positions(), curChunk(nullptr), curChunkIndex(0), chunkSize(chunkSize), nested(nullptr) {}
+      ChunkedData(size_t const& chunkSize) : Base(chunkSize) {}
 
       /// Destructor
       ~ChunkedData() {
-        for (size_t i = 0; i < chunks.size(); ++i) {
-          delete chunks[i];
-        }
-      }
-
-      /*******************************************************************************/
-      /// @name Adding items
-
-      /// \copydoc DataInterface::pushData
-      template<typename... Data>
-      CODI_INLINE void pushData(Data const&... data) {
-        // This method should only be called if reserveItems has been called.
-        curChunk->pushData(data...);
-      }
-
-      /// \copydoc DataInterface::getDataPointers
-      template<typename... Data>
-      CODI_INLINE void getDataPointers(Data*&... pointers) {
-        // This method should only be called if reserveItems has been called.
-        curChunk->dataPointer(curChunk->getUsedSize(), pointers...);
-      }
-
-      /// \copydoc DataInterface::addDataSize
-      CODI_INLINE void addDataSize(size_t size) {
-        // This method should only be called if reserveItems has been called.
-        curChunk->setUsedSize(curChunk->getUsedSize() + size);
-      }
-
-      /// \copydoc DataInterface::reserveItems <br><br>
-      /// Implementation: Creates a new chunk if not enough space is left.
-      CODI_INLINE InternalPosHandle reserveItems(size_t const& items) {
-        codiAssert(items <= chunkSize);
-
-        if (chunkSize < curChunk->getUsedSize() + items) {
-          nextChunk();
-        }
-
-        return curChunk->getUsedSize();
-      }
-
-      /*******************************************************************************/
-      /// @name Size management
-
-      /// \copydoc DataInterface::resize
-      void resize(size_t const& totalSize) {
-        size_t noOfChunks = totalSize / chunkSize;
-        if (0 != totalSize % chunkSize) {
-          noOfChunks += 1;
-        }
-
-        for (size_t i = chunks.size(); i < noOfChunks; ++i) {
-          chunks.push_back(new Chunk(chunkSize));
-          positions.push_back(nested->getPosition());
-        }
-      }
-
-      /// \copydoc DataInterface::reset
-      void reset() {
-        resetTo(getZeroPosition());
-      }
-
-      /// \copydoc DataInterface::resetHard
-      void resetHard() {
-        for (size_t i = 1; i < chunks.size(); ++i) {
-          delete chunks[i];
-        }
-
-        chunks.resize(1);
-        positions.resize(1);
-        curChunk = chunks[0];
-
-        curChunk->setUsedSize(0);
-        curChunkIndex = 0;
-
-        nested->resetHard();
-      }
-
-      /// \copydoc DataInterface::resetTo
-      void resetTo(Position const& pos) {
-        codiAssert(pos.chunk < chunks.size());
-        codiAssert(pos.data <= chunkSize);
-
-        for (size_t i = pos.chunk + 1; i <= curChunkIndex; i += 1) {
-          chunks[i]->reset();
-        }
-
-        curChunk = chunks[pos.chunk];
-        curChunk->setUsedSize(pos.data);
-        curChunkIndex = pos.chunk;
-
-        nested->resetTo(pos.inner);
-      }
-
-      /// \copydoc DataInterface::erase
-      /// Implementation: If the given range start..end does not only overlap with parts of chunks but contains complete
-      /// chunks, those completely contained chunks are deleted in the course of the erase.
-      void erase(Position const& start, Position const& end, bool recursive = true) {
-        size_t chunkRange = end.chunk - start.chunk;
-
-        if (chunkRange == 0) {
-          chunks[start.chunk]->erase(start.data, end.data);
-        } else {
-          // Treat first chunk.
-          chunks[start.chunk]->erase(start.data, chunks[start.chunk]->getUsedSize());
-
-          // Treat last chunk.
-          chunks[end.chunk]->erase(0, end.data);
-
-          // Erase completely covered chunks and free their memory. Covers also the case that there is no such chunk.
-          chunks.erase(chunks.begin() + start.chunk + 1, chunks.begin() + end.chunk);
-        }
-
-        if (recursive) {
-          nested->erase(start.inner, end.inner, recursive);
-        }
-      }
-
-      /*******************************************************************************/
-      /// @name Position functions
-
-      /// \copydoc DataInterface::getDataSize
-      CODI_INLINE size_t getDataSize() const {
-        size_t size = 0;
-        for (size_t i = 0; i < chunks.size(); ++i) {
-          size += chunks[i]->getUsedSize();
-        }
-
-        return size;
-      }
-
-      /// \copydoc DataInterface::getPosition
-      CODI_INLINE Position getPosition() const {
-        return Position(curChunkIndex, curChunk->getUsedSize(), nested->getPosition());
-      }
-
-      /// \copydoc DataInterface::getPushedDataCount
-      CODI_INLINE size_t getPushedDataCount(InternalPosHandle const& startPos) {
-        return curChunk->getUsedSize() - startPos;
-      }
-
-      /// \copydoc DataInterface::getZeroPosition
-      CODI_INLINE Position getZeroPosition() const {
-        return Position(0, 0, nested->getZeroPosition());
+        Base::deleteChunks();
       }
 
       /*******************************************************************************/
@@ -254,268 +102,68 @@ namespace codi {
       /// @{
 
       /// \copydoc DataInterface::addToTapeValues <br><br>
-      /// Implementation: Adds: Total number, Number of chunks, Memory used, Memory allocated
+      /// Implementation: Adds: Total number, Number of chunks, Memory used, Memory allocated, Allocation policy
       void addToTapeValues(TapeValues& values) const {
-        size_t numberOfChunks = chunks.size();
-        size_t dataEntries = getDataSize();
-        size_t entrySize = Chunk::EntrySize;
-
-        double memoryUsed = (double)dataEntries * (double)entrySize;
-        double memoryAlloc = (double)numberOfChunks * (double)chunkSize * (double)entrySize;
-
-        values.addUnsignedLongEntry("Total number", dataEntries);
-        values.addUnsignedLongEntry("Number of chunks", numberOfChunks);
-        values.addDoubleEntry("Memory used", memoryUsed, true, false);
-        values.addDoubleEntry("Memory allocated", memoryAlloc, false, true);
-      }
-
-      /// \copydoc DataInterface::extractPosition
-      template<typename TargetPosition, typename = typename enable_if_not_same<TargetPosition, Position>::type>
-      CODI_INLINE TargetPosition extractPosition(Position const& pos) const {
-        return nested->template extractPosition<TargetPosition>(pos.inner);
-      }
-
-      /// \copydoc DataInterface::extractPosition
-      template<typename TargetPosition, typename = typename enable_if_same<TargetPosition, Position>::type>
-      CODI_INLINE Position extractPosition(Position const& pos) const {
-        return pos;
-      }
-
-      /// \copydoc DataInterface::setNested
-      void setNested(NestedData* v) {
-        // Set nested is only called once during the initialization.
-        codiAssert(nullptr == this->nested);
-        codiAssert(v->getZeroPosition() == v->getPosition());
-
-        this->nested = v;
-
-        curChunk = new Chunk(chunkSize);
-        chunks.push_back(curChunk);
-        positions.push_back(nested->getZeroPosition());
+        Base::addToTapeValues(values);
+        values.addStringEntry("Allocation policy", AllocationPolicy::getName());
       }
 
       /// \copydoc DataInterface::swap
-      void swap(ChunkedData<Chunk, NestedData>& other) {
-        std::swap(chunks, other.chunks);
-        std::swap(positions, other.positions);
-        std::swap(curChunkIndex, other.curChunkIndex);
-        std::swap(chunkSize, other.chunkSize);
-
-        curChunk = chunks[curChunkIndex];
-        other.curChunk = other.chunks[other.curChunkIndex];
-
-        nested->swap(*other.nested);
-      }
-
-      /*******************************************************************************/
-      /// @name Iterator functions
-
-      /// \copydoc DataInterface::evaluateForward
-      template<int selectedDepth = -1, typename FunctionObject, typename... Args>
-      CODI_INLINE void evaluateForward(Position const& start, Position const& end, FunctionObject function,
-                                       Args&&... args) {
-        NestingDepthPointerInserter<selectedDepth> pHandle;
-
-        size_t curDataPos = start.data;
-        size_t endDataPos;
-        NestedPosition curInnerPos = start.inner;
-        NestedPosition endInnerPos;
-
-        size_t curChunk = start.chunk;
-        for (;;) {
-          // Update of end conditions.
-          if (curChunk != end.chunk) {
-            endInnerPos = positions[curChunk + 1];
-            endDataPos = chunks[curChunk]->getUsedSize();
-          } else {
-            endInnerPos = end.inner;
-            endDataPos = end.data;
-          }
-
-          pHandle.setPointers(0, chunks[curChunk]);
-          pHandle.template callNestedForward<selectedDepth - 1>(
-              /* arguments for callNestedForward */
-              nested, curDataPos, endDataPos,
-              /* arguments for nested->evaluateForward */
-              curInnerPos, endInnerPos, function, std::forward<Args>(args)...);
-
-          // After a full chunk is evaluated, the data position needs to be at the end data position.
-          codiAssert(curDataPos == endDataPos);
-
-          if (curChunk != end.chunk) {
-            curChunk += 1;
-            curInnerPos = endInnerPos;
-            curDataPos = 0;
-          } else {
-            break;
-          }
-        }
-      }
-
-      /// \copydoc DataInterface::evaluateReverse
-      template<int selectedDepth = -1, typename FunctionObject, typename... Args>
-      CODI_INLINE void evaluateReverse(Position const& start, Position const& end, FunctionObject function,
-                                       Args&&... args) {
-        NestingDepthPointerInserter<selectedDepth> pHandle;
-
-        size_t curDataPos = start.data;
-        size_t endDataPos;
-        NestedPosition curInnerPos = start.inner;
-        NestedPosition endInnerPos;
-
-        size_t curChunk = start.chunk;
-        for (;;) {
-          // Update of end conditions.
-          if (curChunk != end.chunk) {
-            endInnerPos = positions[curChunk];
-            endDataPos = 0;
-          } else {
-            endInnerPos = end.inner;
-            endDataPos = end.data;
-          }
-
-          pHandle.setPointers(0, chunks[curChunk]);
-
-          pHandle.template callNestedReverse<selectedDepth - 1>(
-              /* arguments for callNestedReverse */
-              nested, curDataPos, endDataPos,
-              /* arguments for nested->evaluateReverse */
-              curInnerPos, endInnerPos, function, std::forward<Args>(args)...);
-
-          // After a full chunk is evaluated, the data position needs to be at the end data position.
-          codiAssert(curDataPos == endDataPos);
-
-          if (curChunk != end.chunk) {
-            // Update of loop variables.
-            curChunk -= 1;
-            curInnerPos = endInnerPos;
-            curDataPos = chunks[curChunk]->getUsedSize();
-          } else {
-            break;
-          }
-        }
-      }
-
-      /// \copydoc DataInterface::forEachChunk
-      template<typename FunctionObject, typename... Args>
-      CODI_INLINE void forEachChunk(FunctionObject& function, bool recursive, Args&&... args) {
-        for (size_t chunkPos = 0; chunkPos < chunks.size(); chunkPos += 1) {
-          function(chunks[chunkPos], std::forward<Args>(args)...);
-        }
-
-        if (recursive) {
-          nested->forEachChunk(function, recursive, std::forward<Args>(args)...);
-        }
+      void swap(ChunkedData& other) {
+        Base::swap(other);
       }
 
-      /// \copydoc DataInterface::forEachForward
-      template<typename FunctionObject, typename... Args>
-      CODI_INLINE void forEachForward(Position const& start, Position const& end, FunctionObject function,
-                                      Args&&... args) {
-        codiAssert(start.chunk < end.chunk || (start.chunk == end.chunk && start.data <= end.data));
-        codiAssert(end.chunk < chunks.size());
-
-        size_t dataStart = start.data;
-        for (size_t chunkPos = start.chunk; chunkPos <= end.chunk; chunkPos += 1) {
-          size_t dataEnd;
-          if (chunkPos != end.chunk) {
-            dataEnd = chunks[chunkPos]->getUsedSize();
-          } else {
-            dataEnd = end.data;
-          }
-
-          forEachChunkEntryForward(chunkPos, dataStart, dataEnd, function, std::forward<Args>(args)...);
-
-          dataStart = 0;
-        }
-      }
-
-      /// \copydoc DataInterface::forEachReverse
-      template<typename FunctionObject, typename... Args>
-      CODI_INLINE void forEachReverse(Position const& start, Position const& end, FunctionObject function,
-                                      Args&&... args) {
-        codiAssert(start.chunk > end.chunk || (start.chunk == end.chunk && start.data >= end.data));
-        codiAssert(start.chunk < chunks.size());
-
-        size_t dataStart = start.data;
-        size_t chunkPos = start.chunk;
+      /// @}
 
-        // For loop break condition is illformed due to unsigned underflow of chunkPos. The condition would be
-        // chunkPos >= end.chunk which only breaks if chunkPos == -1 when end.chunk == 0. The minus one is not possible
-        // for unsigned types.
-        for (;;) {
-          size_t dataEnd;
-          if (chunkPos != end.chunk) {
-            dataEnd = 0;
-          } else {
-            dataEnd = end.data;
-          }
+    protected:
 
-          forEachChunkEntryReverse(chunkPos, dataStart, dataEnd, function, std::forward<Args>(args)...);
+      /// \copydoc ChunkedDataBase::newChunk <br><br>
+      /// Implementation: The arrays are allocated with the memory resource of the allocation policy.
+      Chunk* newChunk(typename Base::ChunkState& state) {
+        CODI_UNUSED(state);
 
-          if (chunkPos == end.chunk) {
-            break;
-          } else {
-            // Decrement of loop variable.
-            chunkPos -= 1;
-            dataStart = chunks[chunkPos]->getUsedSize();
-          }
-        }
+        return new Chunk(this->chunkSize, AllocationPolicy::getMemoryResource());
       }
+  };
 
-      /// @}
-
-    private:
-
-      template<typename FunctionObject, typename... Args>
-      CODI_INLINE void forEachChunkEntryForward(size_t const& chunkPos, size_t const& start, size_t const& end,
-                                                FunctionObject function, Args&&... args) {
-        codiAssert(start <= end);
-        codiAssert(chunkPos < chunks.size());
-
-        PointerInserter pHandle;
+  /**
+   * @brief Indicate whether a data type is a ChunkedData.
+   *
+   * The evaluation functions of ChunkedData provide pointers into the stored chunks. Modifications through these
+   * pointers are kept.
+   *
+   * @tparam Data  The type to be checked.
+   */
+  template<typename Data>
+  struct IsChunkedData : std::false_type {};
 
-        for (size_t dataPos = start; dataPos < end; dataPos += 1) {
-          pHandle.setPointers(dataPos, chunks[chunkPos]);
-          pHandle.call(function, std::forward<Args>(args)...);
-        }
-      }
+  /// \copydoc IsChunkedData
+  template<typename Chunk, typename NestedData, typename PointerInserter, typename AllocationPolicy>
+  struct IsChunkedData<ChunkedData<Chunk, NestedData, PointerInserter, AllocationPolicy>> : std::true_type {};
 
-      template<typename FunctionObject, typename... Args>
-      CODI_INLINE void forEachChunkEntryReverse(size_t const& chunkPos, size_t const& start, size_t const& end,
-                                                FunctionObject function, Args&&... args) {
-        codiAssert(start >= end);
-        codiAssert(chunkPos < chunks.size());
+  /// ChunkData DataInterface used in all regular tapes.
+  template<typename Chunk, typename NestedData = EmptyData>
+  using DefaultChunkedData = ChunkedData<Chunk, NestedData>;
 
-        PointerInserter pHandle;
+  /// ChunkData DataInterface that reuses the chunk arrays of all tapes through a process wide StaticChunkPool.
+  template<typename Chunk, typename NestedData = EmptyData>
+  using DefaultPooledChunkedData = ChunkedData<Chunk, NestedData, PointerStore<Chunk>, StaticChunkPool<>>;
 
-        // For loop break condition is illformed due to unsigned underflow of dataPos. The condition would be
-        // dataPos >= end which only breaks if dataPos == -1 when end == 0. The minus one is not possible
-        // for unsigned types.
-        for (size_t dataPos = start; dataPos > end; /* decrement is done inside the loop */) {
-          dataPos -= 1;  // Decrement of loop variable.
+  /// ChunkData DataInterface that stores the Jacobian data of Jacobian tapes in blocks of 8 items, see
+  /// PackedChunkLayout.
+  template<typename Chunk, typename NestedData = EmptyData>
+  using DefaultPackedChunkedData = ChunkedData<typename PackedChunkLayout<Chunk, 8>::Type, NestedData>;
 
-          pHandle.setPointers(dataPos, chunks[chunkPos]);
-          pHandle.call(function, std::forward<Args>(args)...);
-        }
-      }
+  /// ChunkData DataInterface that stores the Jacobian data of Jacobian tapes as padded structures, see
+  /// PackedChunkLayout.
+  template<typename Chunk, typename NestedData = EmptyData>
+  using DefaultStructChunkedData = ChunkedData<typename PackedChunkLayout<Chunk, 1>::Type, NestedData>;
 
-      /// Loads next chunk or creates a new one if none is available.
-      CODI_NO_INLINE void nextChunk() {
-        curChunkIndex += 1;
-        if (chunks.size() == curChunkIndex) {
-          curChunk = new Chunk(chunkSize);
-          chunks.push_back(curChunk);
-          positions.push_back(nested->getPosition());
-        } else {
-          curChunk = chunks[curChunkIndex];
-          curChunk->reset();
-          positions[curChunkIndex] = nested->getPosition();
-        }
-      }
-  };
+  /// ChunkData DataInterface with 2 MB transparent huge pages.
+  template<typename Chunk, typename NestedData = EmptyData>
+  using DefaultHugePageChunkedData = ChunkedData<Chunk, NestedData, PointerStore<Chunk>, TransparentHugePagePolicy>;
 
-  /// ChunkData DataInterface used in all regular tapes.
+  /// ChunkData DataInterface with pages interleaved over all NUMA nodes.
   template<typename Chunk, typename NestedData = EmptyData>
-  using DefaultChunkedData = ChunkedData<Chunk, NestedData>;
+  using DefaultInterleavedChunkedData = ChunkedData<Chunk, NestedData, PointerStore<Chunk>, InterleavedNumaPolicy>;
 }
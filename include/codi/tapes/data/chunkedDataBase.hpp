@@ -0,0 +1,666 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "../../config.h"
+#include "../../misc/macros.hpp"
+#include "../../traits/misc/enableIfHelpers.hpp"
+#include "chunk.hpp"
+#include "dataInterface.hpp"
+#include "emptyData.hpp"
+#include "pointerStore.hpp"
+#include "position.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+  /// How a chunk is accessed, see ChunkedDataBase.
+  enum class ChunkAccess {
+    ReadForward,   ///< Data is read in increasing order, e.g., by forEachForward().
+    ReadReverse,   ///< Data is read in decreasing order, e.g., by evaluateReverse() or forEachReverse().
+    WriteForward,  ///< Data is read and may be modified in increasing order, e.g., by evaluateForward().
+    Modify         ///< The chunk itself is modified, e.g., by erase() or forEachChunk(). It has to hold its data.
+  };
+
+  /// Chunk state for ChunkedDataBase implementations that do not need one.
+  struct EmptyChunkState {};
+
+  /**
+   * @brief Chunk management for all chunk-wise DataInterface implementations.
+   *
+   * See DataInterface documentation for details.
+   *
+   * Implements the recording, positions and iteration over a list of chunks. Each chunk has the size provided in the
+   * constructor. How the memory of the chunks is provided and where the data is kept between uses is defined by the
+   * implementation via the following functions, which are called with the index of the chunk:
+   *  - newChunk(ChunkState&) / deleteChunk(Chunk*, ChunkState&): Create and delete a chunk. Each chunk has a
+   *    ChunkState object that the implementation can use to store additional data.
+   *  - clearChunk(): Remove all data of the chunk, e.g., before it is reused for recording.
+   *  - beginRecording() / endRecording(): The chunk becomes or stops being the chunk that is used for recording.
+   *  - beginAccess() / endAccess(): The chunk is accessed by an evaluation or iteration, see ChunkAccess. beginAccess()
+   *    returns the chunk that contains the data.
+   *  - prefetchChunk(): The chunk is accessed next with the given access mode.
+   *
+   * The default implementations keep all chunks in memory. The chunk used for recording is always accessed directly.
+   *
+   * Implementations need to call setNested() in their constructor, since the chunk creation calls the implementation.
+   * Their destructor needs to call deleteChunks().
+   *
+   * @tparam T_Chunk            Has to implement ChunkBase. The chunk defines the data stored in this implementation.
+   * @tparam T_NestedData       Nested DataInterface.
+   * @tparam T_PointerInserter  Defines how data is appended to evaluate* function calls.
+   * @tparam T_Impl             Type of the full implementation.
+   * @tparam T_ChunkState       Additional data of the implementation for each chunk.
+   */
+  template<typename T_Chunk, typename T_NestedData, typename T_PointerInserter, typename T_Impl,
+           typename T_ChunkState = EmptyChunkState>
+  struct ChunkedDataBase : public DataInterface<T_NestedData> {
+    public:
+
+      using Chunk = CODI_DD(T_Chunk, Chunk1<CODI_ANY>);                                 ///< See ChunkedDataBase
+      using NestedData = CODI_DD(T_NestedData, CODI_T(DataInterface<CODI_ANY>));        ///< See ChunkedDataBase
+      using PointerInserter = CODI_DD(T_PointerInserter, CODI_T(PointerStore<Chunk>));  ///< See ChunkedDataBase
+      using Impl = CODI_DD(T_Impl, ChunkedDataBase);                                    ///< See ChunkedDataBase
+      using ChunkState = CODI_DD(T_ChunkState, EmptyChunkState);                        ///< See ChunkedDataBase
+
+      using InternalPosHandle = size_t;                      ///< Position in the chunk
+      using NestedPosition = typename NestedData::Position;  ///< Position of NestedData
+
+      /// For selectedDepth == 0 create a pointer inserter that calls the function object.
+      template<int selectedDepth>
+      using NestingDepthPointerInserter =
+          typename std::conditional<selectedDepth == 0, TerminatingPointerStore<PointerInserter>,
+                                    PointerInserter>::type;
+
+      using Position = ChunkPosition<NestedPosition>;  ///< \copydoc DataInterface::Position
+
+    protected:
+      std::vector<Chunk*> chunks;             ///< All chunks, also the ones that are not used.
+      std::vector<ChunkState> states;         ///< State of the implementation for each chunk.
+      std::vector<NestedPosition> positions;  ///< Nested position at the start of each chunk.
+
+      Chunk* curChunk;       ///< Chunk used for recording.
+      size_t curChunkIndex;  ///< Index of the chunk used for recording.
+
+      size_t chunkSize;  ///< Number of entries in each chunk.
+
+      NestedData* nested;  ///< Nested DataInterface.
+
+    public:
+
+      /// Allocate chunkSize entries. Requires a call to #setNested.
+      ChunkedDataBase(size_t const& chunkSize)
+          : chunks(),
+            states(),
+            positions(),
+            curChunk(nullptr),
+            curChunkIndex(0),
+            chunkSize(chunkSize),
+            nested(nullptr) {}
+
+      /*******************************************************************************/
+      /// @name Adding items
+
+      /// \copydoc DataInterface::pushData
+      template<typename... Data>
+      CODI_INLINE void pushData(Data const&... data) {
+        // This method should only be called if reserveItems has been called.
+        curChunk->pushData(data...);
+      }
+
+      /// \copydoc DataInterface::getDataPointers <br><br>
+      /// Implementation: The pointer types are defined by the chunk, see PackedChunk2.
+      template<typename... Pointers>
+      CODI_INLINE void getDataPointers(Pointers&... pointers) {
+        // This method should only be called if reserveItems has been called.
+        curChunk->dataPointer(curChunk->getUsedSize(), pointers...);
+      }
+
+      /// \copydoc DataInterface::addDataSize
+      CODI_INLINE void addDataSize(size_t size) {
+        // This method should only be called if reserveItems has been called.
+        curChunk->setUsedSize(curChunk->getUsedSize() + size);
+      }
+
+      /// \copydoc DataInterface::reserveItems <br><br>
+      /// Implementation: Creates a new chunk if not enough space is left.
+      CODI_INLINE InternalPosHandle reserveItems(size_t const& items) {
+        codiAssert(items <= chunkSize);
+
+        if (chunkSize < curChunk->getUsedSize() + items) {
+          nextChunk();
+        }
+
+        return curChunk->getUsedSize();
+      }
+
+      /*******************************************************************************/
+      /// @name Size management
+
+      /// \copydoc DataInterface::resize <br><br>
+      /// Implementation: The new chunks are cleared, see clearChunk().
+      void resize(size_t const& totalSize) {
+        size_t noOfChunks = totalSize / chunkSize;
+        if (0 != totalSize % chunkSize) {
+          noOfChunks += 1;
+        }
+
+        for (size_t i = chunks.size(); i < noOfChunks; ++i) {
+          createChunk();
+          positions.push_back(nested->getPosition());
+          cast().clearChunk(i);
+        }
+      }
+
+      /// \copydoc DataInterface::reset
+      void reset() {
+        cast().resetTo(getZeroPosition());
+      }
+
+      /// \copydoc DataInterface::resetHard
+      void resetHard() {
+        for (size_t i = 1; i < chunks.size(); ++i) {
+          cast().deleteChunk(chunks[i], states[i]);
+        }
+
+        chunks.resize(1);
+        states.resize(1);
+        positions.resize(1);
+
+        cast().clearChunk(0);
+        curChunkIndex = 0;
+        curChunk = cast().beginRecording(0);
+
+        nested->resetHard();
+      }
+
+      /// \copydoc DataInterface::resetTo
+      void resetTo(Position const& pos) {
+        codiAssert(pos.chunk < chunks.size());
+        codiAssert(pos.data <= chunkSize);
+
+        for (size_t i = pos.chunk + 1; i <= curChunkIndex; i += 1) {
+          cast().clearChunk(i);
+        }
+
+        curChunkIndex = pos.chunk;
+        curChunk = cast().beginRecording(curChunkIndex);
+        curChunk->setUsedSize(pos.data);
+
+        nested->resetTo(pos.inner);
+      }
+
+      /// \copydoc DataInterface::erase
+      /// Implementation: If the given range start..end does not only overlap with parts of chunks but contains complete
+      /// chunks, those completely contained chunks are deleted in the course of the erase.
+      void erase(Position const& start, Position const& end, bool recursive = true) {
+        size_t chunkRange = end.chunk - start.chunk;
+
+        Chunk* startChunk = cast().beginAccess(start.chunk, ChunkAccess::Modify);
+        if (chunkRange == 0) {
+          startChunk->erase(start.data, end.data);
+        } else {
+          Chunk* endChunk = cast().beginAccess(end.chunk, ChunkAccess::Modify);
+
+          // Treat first chunk.
+          startChunk->erase(start.data, startChunk->getUsedSize());
+
+          // Treat last chunk.
+          endChunk->erase(0, end.data);
+
+          // Erase completely covered chunks and free their memory. Covers also the case that there is no such chunk.
+          for (size_t i = start.chunk + 1; i < end.chunk; i += 1) {
+            cast().deleteChunk(chunks[i], states[i]);
+          }
+          chunks.erase(chunks.begin() + start.chunk + 1, chunks.begin() + end.chunk);
+          states.erase(states.begin() + start.chunk + 1, states.begin() + end.chunk);
+          positions.erase(positions.begin() + start.chunk + 1, positions.begin() + end.chunk);
+
+          if (curChunkIndex >= end.chunk) {
+            curChunkIndex -= chunkRange - 1;
+          }
+
+          cast().endAccess(end.chunk - (chunkRange - 1), ChunkAccess::Modify);
+        }
+        cast().endAccess(start.chunk, ChunkAccess::Modify);
+
+        if (recursive) {
+          nested->erase(start.inner, end.inner, recursive);
+        }
+      }
+
+      /*******************************************************************************/
+      /// @name Position functions
+
+      /// \copydoc DataInterface::getDataSize
+      CODI_INLINE size_t getDataSize() const {
+        size_t size = 0;
+        for (size_t i = 0; i < chunks.size(); ++i) {
+          size += chunks[i]->getUsedSize();
+        }
+
+        return size;
+      }
+
+      /// \copydoc DataInterface::getPosition
+      CODI_INLINE Position getPosition() const {
+        return Position(curChunkIndex, curChunk->getUsedSize(), nested->getPosition());
+      }
+
+      /// \copydoc DataInterface::getPushedDataCount
+      CODI_INLINE size_t getPushedDataCount(InternalPosHandle const& startPos) {
+        return curChunk->getUsedSize() - startPos;
+      }
+
+      /// \copydoc DataInterface::getZeroPosition
+      CODI_INLINE Position getZeroPosition() const {
+        return Position(0, 0, nested->getZeroPosition());
+      }
+
+      /*******************************************************************************/
+      /// @name Misc functions
+      /// @{
+
+      /// \copydoc DataInterface::addToTapeValues <br><br>
+      /// Implementation: Adds: Total number, Number of chunks, Memory used, Memory allocated
+      void addToTapeValues(TapeValues& values) const {
+        size_t numberOfChunks = chunks.size();
+        size_t dataEntries = getDataSize();
+        size_t entrySize = Chunk::EntrySize;
+
+        double memoryUsed = (double)dataEntries * (double)entrySize;
+        double memoryAlloc = (double)numberOfChunks * (double)chunkSize * (double)entrySize;
+
+        values.addUnsignedLongEntry("Total number", dataEntries);
+        values.addUnsignedLongEntry("Number of chunks", numberOfChunks);
+        values.addDoubleEntry("Memory used", memoryUsed, true, false);
+        values.addDoubleEntry("Memory allocated", memoryAlloc, false, true);
+      }
+
+      /// \copydoc DataInterface::extractPosition
+      template<typename TargetPosition, typename = typename enable_if_not_same<TargetPosition, Position>::type>
+      CODI_INLINE TargetPosition extractPosition(Position const& pos) const {
+        return nested->template extractPosition<TargetPosition>(pos.inner);
+      }
+
+      /// \copydoc DataInterface::extractPosition
+      template<typename TargetPosition, typename = typename enable_if_same<TargetPosition, Position>::type>
+      CODI_INLINE Position extractPosition(Position const& pos) const {
+        return pos;
+      }
+
+      /// \copydoc DataInterface::setNested
+      void setNested(NestedData* v) {
+        // Set nested is only called once during the initialization.
+        codiAssert(nullptr == this->nested);
+        codiAssert(v->getZeroPosition() == v->getPosition());
+
+        this->nested = v;
+
+        curChunk = createChunk();
+        positions.push_back(nested->getZeroPosition());
+      }
+
+      /// \copydoc DataInterface::swap
+      void swap(ChunkedDataBase& other) {
+        std::swap(chunks, other.chunks);
+        std::swap(states, other.states);
+        std::swap(positions, other.positions);
+        std::swap(curChunkIndex, other.curChunkIndex);
+        std::swap(chunkSize, other.chunkSize);
+
+        curChunk = chunks[curChunkIndex];
+        other.curChunk = other.chunks[other.curChunkIndex];
+
+        nested->swap(*other.nested);
+      }
+
+      /*******************************************************************************/
+      /// @name Iterator functions
+
+      /// \copydoc DataInterface::evaluateForward
+      template<int selectedDepth = -1, typename FunctionObject, typename... Args>
+      CODI_INLINE void evaluateForward(Position const& start, Position const& end, FunctionObject function,
+                                       Args&&... args) {
+        NestingDepthPointerInserter<selectedDepth> pHandle;
+
+        size_t curDataPos = start.data;
+        size_t endDataPos;
+        NestedPosition curInnerPos = start.inner;
+        NestedPosition endInnerPos;
+
+        size_t curChunk = start.chunk;
+        Chunk* chunk = cast().beginAccess(curChunk, ChunkAccess::WriteForward);
+        for (;;) {
+          // Update of end conditions.
+          if (curChunk != end.chunk) {
+            endInnerPos = positions[curChunk + 1];
+            endDataPos = chunks[curChunk]->getUsedSize();
+
+            cast().prefetchChunk(curChunk + 1, ChunkAccess::WriteForward);
+          } else {
+            endInnerPos = end.inner;
+            endDataPos = end.data;
+          }
+
+          pHandle.setPointers(0, chunk);
+          pHandle.template callNestedForward<selectedDepth - 1>(
+              /* arguments for callNestedForward */
+              nested, curDataPos, endDataPos,
+              /* arguments for nested->evaluateForward */
+              curInnerPos, endInnerPos, function, std::forward<Args>(args)...);
+
+          // After a full chunk is evaluated, the data position needs to be at the end data position.
+          codiAssert(curDataPos == endDataPos);
+
+          cast().endAccess(curChunk, ChunkAccess::WriteForward);
+
+          if (curChunk != end.chunk) {
+            curChunk += 1;
+            curInnerPos = endInnerPos;
+            curDataPos = 0;
+            chunk = cast().beginAccess(curChunk, ChunkAccess::WriteForward);
+          } else {
+            break;
+          }
+        }
+      }
+
+      /// \copydoc DataInterface::evaluateReverse
+      template<int selectedDepth = -1, typename FunctionObject, typename... Args>
+      CODI_INLINE void evaluateReverse(Position const& start, Position const& end, FunctionObject function,
+                                       Args&&... args) {
+        NestingDepthPointerInserter<selectedDepth> pHandle;
+
+        size_t curDataPos = start.data;
+        size_t endDataPos;
+        NestedPosition curInnerPos = start.inner;
+        NestedPosition endInnerPos;
+
+        size_t curChunk = start.chunk;
+        Chunk* chunk = cast().beginAccess(curChunk, ChunkAccess::ReadReverse);
+        for (;;) {
+          // Update of end conditions.
+          if (curChunk != end.chunk) {
+            endInnerPos = positions[curChunk];
+            endDataPos = 0;
+
+            cast().prefetchChunk(curChunk - 1, ChunkAccess::ReadReverse);
+          } else {
+            endInnerPos = end.inner;
+            endDataPos = end.data;
+          }
+
+          pHandle.setPointers(0, chunk);
+
+          pHandle.template callNestedReverse<selectedDepth - 1>(
+              /* arguments for callNestedReverse */
+              nested, curDataPos, endDataPos,
+              /* arguments for nested->evaluateReverse */
+              curInnerPos, endInnerPos, function, std::forward<Args>(args)...);
+
+          // After a full chunk is evaluated, the data position needs to be at the end data position.
+          codiAssert(curDataPos == endDataPos);
+
+          cast().endAccess(curChunk, ChunkAccess::ReadReverse);
+
+          if (curChunk != end.chunk) {
+            // Update of loop variables.
+            curChunk -= 1;
+            curInnerPos = endInnerPos;
+            chunk = cast().beginAccess(curChunk, ChunkAccess::ReadReverse);
+            curDataPos = chunks[curChunk]->getUsedSize();
+          } else {
+            break;
+          }
+        }
+      }
+
+      /// \copydoc DataInterface::forEachChunk
+      template<typename FunctionObject, typename... Args>
+      CODI_INLINE void forEachChunk(FunctionObject& function, bool recursive, Args&&... args) {
+        for (size_t chunkPos = 0; chunkPos < chunks.size(); chunkPos += 1) {
+          function(cast().beginAccess(chunkPos, ChunkAccess::Modify), std::forward<Args>(args)...);
+          cast().endAccess(chunkPos, ChunkAccess::Modify);
+        }
+
+        if (recursive) {
+          nested->forEachChunk(function, recursive, std::forward<Args>(args)...);
+        }
+      }
+
+      /// \copydoc DataInterface::forEachForward
+      template<typename FunctionObject, typename... Args>
+      CODI_INLINE void forEachForward(Position const& start, Position const& end, FunctionObject function,
+                                      Args&&... args) {
+        codiAssert(start.chunk < end.chunk || (start.chunk == end.chunk && start.data <= end.data));
+        codiAssert(end.chunk < chunks.size());
+
+        size_t dataStart = start.data;
+        for (size_t chunkPos = start.chunk; chunkPos <= end.chunk; chunkPos += 1) {
+          Chunk* chunk = cast().beginAccess(chunkPos, ChunkAccess::ReadForward);
+
+          size_t dataEnd;
+          if (chunkPos != end.chunk) {
+            dataEnd = chunks[chunkPos]->getUsedSize();
+            cast().prefetchChunk(chunkPos + 1, ChunkAccess::ReadForward);
+          } else {
+            dataEnd = end.data;
+          }
+
+          forEachChunkEntryForward(chunk, dataStart, dataEnd, function, std::forward<Args>(args)...);
+
+          cast().endAccess(chunkPos, ChunkAccess::ReadForward);
+
+          dataStart = 0;
+        }
+      }
+
+      /// \copydoc DataInterface::forEachReverse
+      template<typename FunctionObject, typename... Args>
+      CODI_INLINE void forEachReverse(Position const& start, Position const& end, FunctionObject function,
+                                      Args&&... args) {
+        codiAssert(start.chunk > end.chunk || (start.chunk == end.chunk && start.data >= end.data));
+        codiAssert(start.chunk < chunks.size());
+
+        size_t dataStart = start.data;
+        size_t chunkPos = start.chunk;
+
+        Chunk* chunk = cast().beginAccess(chunkPos, ChunkAccess::ReadReverse);
+
+        // For loop break condition is illformed due to unsigned underflow of chunkPos. The condition would be
+        // chunkPos >= end.chunk which only breaks if chunkPos == -1 when end.chunk == 0. The minus one is not possible
+        // for unsigned types.
+        for (;;) {
+          size_t dataEnd;
+          if (chunkPos != end.chunk) {
+            dataEnd = 0;
+            cast().prefetchChunk(chunkPos - 1, ChunkAccess::ReadReverse);
+          } else {
+            dataEnd = end.data;
+          }
+
+          forEachChunkEntryReverse(chunk, dataStart, dataEnd, function, std::forward<Args>(args)...);
+
+          cast().endAccess(chunkPos, ChunkAccess::ReadReverse);
+
+          if (chunkPos == end.chunk) {
+            break;
+          } else {
+            // Decrement of loop variable.
+            chunkPos -= 1;
+            chunk = cast().beginAccess(chunkPos, ChunkAccess::ReadReverse);
+            dataStart = chunks[chunkPos]->getUsedSize();
+          }
+        }
+      }
+
+      /// @}
+
+    protected:
+
+      /*******************************************************************************/
+      /// @name Chunk management
+      /// Default implementations, the implementation can provide its own versions.
+      /// @{
+
+      /// Create a new chunk and initialize its state.
+      Chunk* newChunk(ChunkState& state) {
+        CODI_UNUSED(state);
+
+        return new Chunk(chunkSize);
+      }
+
+      /// Delete the chunk and release the resources in its state.
+      void deleteChunk(Chunk* chunk, ChunkState& state) {
+        CODI_UNUSED(state);
+
+        delete chunk;
+      }
+
+      /// Remove all data of the chunk.
+      void clearChunk(size_t const& chunkPos) {
+        chunks[chunkPos]->reset();
+      }
+
+      /// The chunk is used for recording. Returns the chunk that receives the data.
+      Chunk* beginRecording(size_t const& chunkPos) {
+        return chunks[chunkPos];
+      }
+
+      /// The chunk is full and no longer used for recording.
+      void endRecording(size_t const& chunkPos) {
+        CODI_UNUSED(chunkPos);
+      }
+
+      /// The chunk is accessed with the given mode. Returns the chunk that contains the data.
+      CODI_INLINE Chunk* beginAccess(size_t const& chunkPos, ChunkAccess access) {
+        CODI_UNUSED(access);
+
+        return chunks[chunkPos];
+      }
+
+      /// The access with the given mode is finished.
+      CODI_INLINE void endAccess(size_t const& chunkPos, ChunkAccess access) {
+        CODI_UNUSED(chunkPos, access);
+      }
+
+      /// The chunk is accessed next with the given mode.
+      CODI_INLINE void prefetchChunk(size_t const& chunkPos, ChunkAccess access) {
+        CODI_UNUSED(chunkPos, access);
+      }
+
+      /// @}
+
+      /// Delete all chunks, has to be called in the destructor of the implementation.
+      void deleteChunks() {
+        for (size_t i = 0; i < chunks.size(); ++i) {
+          cast().deleteChunk(chunks[i], states[i]);
+        }
+
+        chunks.clear();
+        states.clear();
+      }
+
+    private:
+
+      CODI_INLINE Impl const& cast() const {
+        return static_cast<Impl const&>(*this);
+      }
+
+      CODI_INLINE Impl& cast() {
+        return static_cast<Impl&>(*this);
+      }
+
+      /// Creates a new chunk at the end of the chunk list.
+      Chunk* createChunk() {
+        states.push_back(ChunkState());
+        Chunk* chunk = cast().newChunk(states.back());
+        chunks.push_back(chunk);
+
+        return chunk;
+      }
+
+      template<typename FunctionObject, typename... Args>
+      CODI_INLINE void forEachChunkEntryForward(Chunk* chunk, size_t const& start, size_t const& end,
+                                                FunctionObject function, Args&&... args) {
+        codiAssert(start <= end);
+
+        PointerInserter pHandle;
+
+        for (size_t dataPos = start; dataPos < end; dataPos += 1) {
+          pHandle.setPointers(dataPos, chunk);
+          pHandle.call(function, std::forward<Args>(args)...);
+        }
+      }
+
+      template<typename FunctionObject, typename... Args>
+      CODI_INLINE void forEachChunkEntryReverse(Chunk* chunk, size_t const& start, size_t const& end,
+                                                FunctionObject function, Args&&... args) {
+        codiAssert(start >= end);
+
+        PointerInserter pHandle;
+
+        // For loop break condition is illformed due to unsigned underflow of dataPos. The condition would be
+        // dataPos >= end which only breaks if dataPos == -1 when end == 0. The minus one is not possible
+        // for unsigned types.
+        for (size_t dataPos = start; dataPos > end; /* decrement is done inside the loop */) {
+          dataPos -= 1;  // Decrement of loop variable.
+
+          pHandle.setPointers(dataPos, chunk);
+          pHandle.call(function, std::forward<Args>(args)...);
+        }
+      }
+
+      /// Loads next chunk or creates a new one if none is available.
+      CODI_NO_INLINE void nextChunk() {
+        cast().endRecording(curChunkIndex);
+
+        curChunkIndex += 1;
+        if (chunks.size() == curChunkIndex) {
+          createChunk();
+          positions.push_back(nested->getPosition());
+        } else {
+          cast().clearChunk(curChunkIndex);
+          positions[curChunkIndex] = nested->getPosition();
+        }
+
+        curChunk = cast().beginRecording(curChunkIndex);
+      }
+  };
+}
@@ -0,0 +1,591 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "../../config.h"
+#include "../../misc/macros.hpp"
+#include "chunk.hpp"
+#include "chunkedDataBase.hpp"
+#include "dataInterface.hpp"
+#include "emptyData.hpp"
+#include "pointerStore.hpp"
+#include "position.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+  /**
+   * @brief Lossless encoding of the data arrays of a chunk.
+   *
+   * Integral arrays, e.g., identifiers and argument counts, are delta encoded. The zigzag encoded differences are bit
+   * packed in blocks of #BlockSize entries, each block uses the bit width of its largest difference. All other arrays
+   * and arrays of char, which is used for raw byte data, are copied.
+   *
+   * The decoder unpacks a block with a fixed bit width in a branch free loop and computes the prefix sum in a second
+   * loop. Both loops can be vectorized by the compiler.
+   *
+   * The encoded data of all arrays is stored consecutively in one word vector.
+   */
+  struct ChunkEncoding {
+    public:
+
+      using Word = uint64_t;  ///< Storage type of the encoded data.
+
+      static size_t constexpr BlockSize = 128;  ///< Number of entries that are packed with the same bit width.
+      static size_t constexpr WordBits = 64;    ///< Number of bits in a word.
+
+      /// True if the array is delta encoded and bit packed, otherwise it is copied.
+      template<typename Data>
+      using IsPacked = std::integral_constant<bool, std::is_integral<Data>::value && !std::is_same<Data, char>::value>;
+
+      /// Encodes all arrays of a chunk. Use with PointerStore::call.
+      struct Encoder {
+        public:
+
+          std::vector<Word>& out;  ///< Output for the encoded data.
+          size_t count;            ///< Number of entries in each array.
+
+          /// Constructor
+          Encoder(std::vector<Word>& out, size_t count) : out(out), count(count) {}
+
+          /// Encode all arrays.
+          template<typename... Data>
+          void operator()(Data*... arrays) {
+            // Arrays are processed in order of the initializer list.
+            int expander[] = {0, (encodeArray(arrays, count, out), 0)...};
+            CODI_UNUSED(expander);
+          }
+      };
+
+      /// Decodes all arrays of a chunk. Use with PointerStore::call.
+      struct Decoder {
+        public:
+
+          Word const* in;  ///< Current read position in the encoded data.
+          size_t count;    ///< Number of entries in each array.
+
+          /// Constructor
+          Decoder(Word const* in, size_t count) : in(in), count(count) {}
+
+          /// Decode all arrays.
+          template<typename... Data>
+          void operator()(Data*... arrays) {
+            // Arrays are processed in order of the initializer list.
+            int expander[] = {0, (in = decodeArray(arrays, count, in), 0)...};
+            CODI_UNUSED(expander);
+          }
+      };
+
+      /// Updates the copied arrays in an encoding. The packed arrays are compared with the encoding, if one of them was
+      /// modified, packedChanged is set and the chunk needs to be encoded again. Use with PointerStore::call.
+      struct Updater {
+        public:
+
+          Word* out;           ///< Current write position in the encoded data.
+          size_t count;        ///< Number of entries in each array.
+          bool packedChanged;  ///< True if a packed array differs from the encoding.
+
+          /// Constructor
+          Updater(Word* out, size_t count) : out(out), count(count), packedChanged(false) {}
+
+          /// Update all copied arrays.
+          template<typename... Data>
+          void operator()(Data*... arrays) {
+            // Arrays are processed in order of the initializer list.
+            int expander[] = {0, (out = updateArray(arrays, count, out, packedChanged), 0)...};
+            CODI_UNUSED(expander);
+          }
+      };
+
+      /// Delta, zigzag and bit packing encoding for integral types.
+      template<typename Data>
+      static typename std::enable_if<IsPacked<Data>::value>::type encodeArray(Data const* array, size_t count,
+                                                                              std::vector<Word>& out) {
+        Word diffs[BlockSize];
+        Word prev = 0;
+
+        for (size_t blockStart = 0; blockStart < count; blockStart += BlockSize) {
+          size_t blockCount = std::min((size_t)BlockSize, count - blockStart);
+
+          Word maxDiff = 0;
+          for (size_t i = 0; i < blockCount; i += 1) {
+            Word cur = (Word)array[blockStart + i];
+            diffs[i] = zigzagEncode(cur - prev);
+            maxDiff |= diffs[i];
+            prev = cur;
+          }
+
+          size_t width = bitWidth(maxDiff);
+          out.push_back((Word)width);
+
+          if (0 != width) {
+            size_t words = blockWords(blockCount, width);
+            out.resize(out.size() + words, 0);
+            Word* packed = &out[out.size() - words];
+
+            for (size_t i = 0; i < blockCount; i += 1) {
+              size_t bitPos = i * width;
+              size_t word = bitPos / WordBits;
+              size_t offset = bitPos % WordBits;
+
+              // The second shift is split such that it is also defined for offset == 0.
+              packed[word] |= diffs[i] << offset;
+              packed[word + 1] |= (diffs[i] >> 1) >> (WordBits - 1 - offset);
+            }
+          }
+        }
+      }
+
+      /// Raw copy for all other types.
+      template<typename Data>
+      static typename std::enable_if<!IsPacked<Data>::value>::type encodeArray(Data const* array, size_t count,
+                                                                               std::vector<Word>& out) {
+        size_t wordStart = out.size();
+        out.resize(wordStart + rawWords<Data>(count));
+        std::memcpy((void*)&out[wordStart], (void const*)array, count * sizeof(Data));
+      }
+
+      /// Inverse of the integral encodeArray. Returns the position after the array.
+      template<typename Data>
+      static typename std::enable_if<IsPacked<Data>::value, Word const*>::type decodeArray(Data* array, size_t count,
+                                                                                           Word const* in) {
+        Word prev = 0;
+
+        for (size_t blockStart = 0; blockStart < count; blockStart += BlockSize) {
+          size_t blockCount = std::min((size_t)BlockSize, count - blockStart);
+          in += decodeBlock(&array[blockStart], blockCount, in, prev);
+        }
+
+        return in;
+      }
+
+      /// Inverse of the raw copy encodeArray. Returns the position after the array.
+      template<typename Data>
+      static typename std::enable_if<!IsPacked<Data>::value, Word const*>::type decodeArray(Data* array, size_t count,
+                                                                                            Word const* in) {
+        std::memcpy((void*)array, (void const*)in, count * sizeof(Data));
+
+        return in + rawWords<Data>(count);
+      }
+
+      /// Compares packed arrays with the encoding, changed is set if they differ. Returns the position after the array.
+      template<typename Data>
+      static typename std::enable_if<IsPacked<Data>::value, Word*>::type updateArray(Data const* array, size_t count,
+                                                                                     Word* out, bool& changed) {
+        Data block[BlockSize];
+        Word prev = 0;
+
+        for (size_t blockStart = 0; blockStart < count; blockStart += BlockSize) {
+          size_t blockCount = std::min((size_t)BlockSize, count - blockStart);
+          out += decodeBlock(block, blockCount, out, prev);
+
+          if (0 != std::memcmp((void const*)block, (void const*)&array[blockStart], blockCount * sizeof(Data))) {
+            changed = true;
+          }
+        }
+
+        return out;
+      }
+
+      /// Copies the array again. Returns the position after the array.
+      template<typename Data>
+      static typename std::enable_if<!IsPacked<Data>::value, Word*>::type updateArray(Data const* array, size_t count,
+                                                                                      Word* out, bool& changed) {
+        CODI_UNUSED(changed);
+
+        std::memcpy((void*)out, (void const*)array, count * sizeof(Data));
+
+        return out + rawWords<Data>(count);
+      }
+
+    private:
+
+      /// Decodes one block of an integral array. prev is the last value of the previous block. Returns the number of
+      /// words of the block.
+      template<typename Data>
+      static CODI_INLINE size_t decodeBlock(Data* array, size_t blockCount, Word const* in, Word& prev) {
+        Word diffs[BlockSize];
+
+        size_t width = (size_t)*in;
+        in += 1;
+
+        if (0 == width) {
+          for (size_t i = 0; i < blockCount; i += 1) {
+            array[i] = (Data)prev;
+          }
+
+          return 1;
+        } else {
+          Word mask = (WordBits == width) ? ~(Word)0 : (((Word)1 << width) - 1);
+          for (size_t i = 0; i < blockCount; i += 1) {
+            size_t bitPos = i * width;
+            size_t word = bitPos / WordBits;
+            size_t offset = bitPos % WordBits;
+
+            Word value = (in[word] >> offset) | ((in[word + 1] << 1) << (WordBits - 1 - offset));
+            diffs[i] = zigzagDecode(value & mask);
+          }
+
+          for (size_t i = 0; i < blockCount; i += 1) {
+            prev += diffs[i];
+            array[i] = (Data)prev;
+          }
+
+          return 1 + blockWords(blockCount, width);
+        }
+      }
+
+      static CODI_INLINE Word zigzagEncode(Word diff) {
+        return (diff << 1) ^ (Word)((int64_t)diff >> (WordBits - 1));
+      }
+
+      static CODI_INLINE Word zigzagDecode(Word value) {
+        return (value >> 1) ^ (~(value & 1) + 1);
+      }
+
+      static CODI_INLINE size_t bitWidth(Word value) {
+        size_t width = 0;
+        while (0 != value) {
+          width += 1;
+          value >>= 1;
+        }
+
+        return width;
+      }
+
+      /// Words of a packed block. One padding word allows branch free access to the next word.
+      static CODI_INLINE size_t blockWords(size_t count, size_t width) {
+        return (count * width + WordBits - 1) / WordBits + 1;
+      }
+
+      template<typename Data>
+      static CODI_INLINE size_t rawWords(size_t count) {
+        return (count * sizeof(Data) + sizeof(Word) - 1) / sizeof(Word);
+      }
+  };
+
+  /// Encoded data of one chunk in CompressedChunkedData.
+  struct CompressedChunkState {
+    public:
+      std::vector<ChunkEncoding::Word> encoded;  ///< Empty for uncompressed chunks.
+  };
+
+  /**
+   * @brief Data is stored chunk-wise. Finished chunks are compressed.
+   *
+   * See DataInterface documentation for details.
+   *
+   * Behaves like ChunkedData, but if a chunk is full during the recording, its data is encoded with ChunkEncoding and
+   * the memory of the chunk is released. Identifier streams and argument counts compress well, since the identifiers
+   * of consecutive entries are usually close to each other.
+   *
+   * For evaluations, each compressed chunk is decoded into a buffer chunk, which is then used in place of the
+   * compressed chunk. Forward evaluations may modify the data, e.g., the old primal values in primal value tapes,
+   * therefore the copied arrays are written back into the encoding after a forward evaluation. The packed arrays are
+   * compared with the encoding and the chunk is encoded again if they were modified. If the recording
+   * is reset to a position in a compressed chunk, this chunk is decompressed. The functions that modify whole chunks,
+   * i.e., erase() and forEachChunk(), decompress the chunks. See ChunkedDataBase for the chunk management.
+   *
+   * Each chunk has the size provided in the constructor.
+   *
+   * @tparam T_Chunk            Has to implement ChunkBase. The chunk defines the data stored in this implementation.
+   * @tparam T_NestedData       Nested DataInterface.
+   * @tparam T_PointerInserter  Defines how data is appended to evaluate* function calls.
+   */
+  template<typename T_Chunk, typename T_NestedData = EmptyData, typename T_PointerInserter = PointerStore<T_Chunk>>
+  struct CompressedChunkedData
+      : public ChunkedDataBase<T_Chunk, T_NestedData, T_PointerInserter,
+                               CompressedChunkedData<T_Chunk, T_NestedData, T_PointerInserter>, CompressedChunkState> {
+    public:
+
+      using Chunk = CODI_DD(T_Chunk, Chunk1<CODI_ANY>);                                 ///< See CompressedChunkedData
+      using NestedData = CODI_DD(T_NestedData, CODI_T(DataInterface<CODI_ANY>));        ///< See CompressedChunkedData
+      using PointerInserter = CODI_DD(T_PointerInserter, CODI_T(PointerStore<Chunk>));  ///< See CompressedChunkedData
+
+      /// Base class abbreviation.
+      using Base = ChunkedDataBase<Chunk, NestedData, PointerInserter, CompressedChunkedData, CompressedChunkState>;
+      friend Base;  ///< Allow the base class to call protected and private methods.
+
+      using Position = typename Base::Position;  ///< See ChunkedDataBase.
+
+    private:
+
+      static size_t constexpr NoChunk = (size_t)-1;
+
+      Chunk* decodeBuffer;
+      size_t decodedChunk;
+
+    public:
+
+      /// Allocate chunkSize entries and set the nested DataInterface.
+      CompressedChunkedData(size_t const& chunkSize, NestedData* nested)
+          : Base(chunkSize), decodeBuffer(nullptr), decodedChunk(NoChunk) {
+        Base::setNested(nested);
+      }
+
+      /// Allocate chunkSize entries. Requires a call to #setNested.
+      CompressedChunkedData(size_t const& chunkSize) : Base(chunkSize), decodeBuffer(nullptr), decodedChunk(NoChunk) {}
+
+      /// Destructor
+      ~CompressedChunkedData() {
+        Base::deleteChunks();
+
+        delete decodeBuffer;
+      }
+
+      /*******************************************************************************/
+      /// @name Size management
+
+      /// \copydoc DataInterface::resetHard
+      void resetHard() {
+        Base::resetHard();
+
+        delete decodeBuffer;
+        decodeBuffer = nullptr;
+        decodedChunk = NoChunk;
+      }
+
+      /// \copydoc ChunkedDataBase::erase
+      void erase(Position const& start, Position const& end, bool recursive = true) {
+        // Chunk indices change if chunks are erased.
+        decodedChunk = NoChunk;
+
+        Base::erase(start, end, recursive);
+      }
+
+      /*******************************************************************************/
+      /// @name Misc functions
+      /// @{
+
+      /// \copydoc DataInterface::addToTapeValues <br><br>
+      /// Implementation: Adds: Total number, Number of chunks, Compressed chunks, Memory used, Memory allocated
+      ///
+      /// For compressed chunks, the size of the encoded data is reported.
+      void addToTapeValues(TapeValues& values) const {
+        size_t numberOfChunks = this->chunks.size();
+        size_t compressedChunks = 0;
+        size_t dataEntries = this->getDataSize();
+        size_t entrySize = Chunk::EntrySize;
+
+        double memoryUsed = 0.0;
+        double memoryAlloc = 0.0;
+        for (size_t i = 0; i < this->chunks.size(); i += 1) {
+          std::vector<ChunkEncoding::Word> const& encoded = this->states[i].encoded;
+          if (isCompressed(i)) {
+            compressedChunks += 1;
+            memoryUsed += (double)encoded.size() * (double)sizeof(ChunkEncoding::Word);
+            memoryAlloc += (double)encoded.capacity() * (double)sizeof(ChunkEncoding::Word);
+          } else {
+            memoryUsed += (double)this->chunks[i]->getUsedSize() * (double)entrySize;
+            memoryAlloc += (double)this->chunkSize * (double)entrySize;
+          }
+        }
+        if (nullptr != decodeBuffer) {
+          memoryAlloc += (double)this->chunkSize * (double)entrySize;
+        }
+
+        values.addUnsignedLongEntry("Total number", dataEntries);
+        values.addUnsignedLongEntry("Number of chunks", numberOfChunks);
+        values.addUnsignedLongEntry("Compressed chunks", compressedChunks);
+        values.addDoubleEntry("Memory used", memoryUsed, true, false);
+        values.addDoubleEntry("Memory allocated", memoryAlloc, false, true);
+      }
+
+      /// \copydoc DataInterface::swap
+      void swap(CompressedChunkedData& other) {
+        Base::swap(other);
+
+        std::swap(decodeBuffer, other.decodeBuffer);
+        std::swap(decodedChunk, other.decodedChunk);
+      }
+
+      /// @}
+
+    protected:
+
+      /*******************************************************************************/
+      /// @name ChunkedDataBase implementation
+      /// @{
+
+      /// \copydoc ChunkedDataBase::clearChunk <br><br>
+      /// Implementation: The chunk is uncompressed afterwards.
+      void clearChunk(size_t const& chunkPos) {
+        if (isCompressed(chunkPos)) {
+          this->chunks[chunkPos]->allocateData();
+          std::vector<ChunkEncoding::Word>().swap(this->states[chunkPos].encoded);
+
+          if (decodedChunk == chunkPos) {
+            decodedChunk = NoChunk;
+          }
+        }
+
+        this->chunks[chunkPos]->reset();
+      }
+
+      /// \copydoc ChunkedDataBase::beginRecording
+      Chunk* beginRecording(size_t const& chunkPos) {
+        decompress(chunkPos);
+
+        return this->chunks[chunkPos];
+      }
+
+      /// \copydoc ChunkedDataBase::endRecording
+      void endRecording(size_t const& chunkPos) {
+        compress(chunkPos);
+      }
+
+      /// \copydoc ChunkedDataBase::beginAccess <br><br>
+      /// Implementation: For compressed chunks, the decoded buffer is returned. Modified chunks are decompressed.
+      CODI_INLINE Chunk* beginAccess(size_t const& chunkPos, ChunkAccess access) {
+        if (ChunkAccess::Modify == access) {
+          decompress(chunkPos);
+        }
+
+        if (!isCompressed(chunkPos)) {
+          return this->chunks[chunkPos];
+        } else {
+          if (decodedChunk != chunkPos) {
+            decodeToBuffer(chunkPos);
+          }
+
+          return decodeBuffer;
+        }
+      }
+
+      /// \copydoc ChunkedDataBase::endAccess
+      CODI_INLINE void endAccess(size_t const& chunkPos, ChunkAccess access) {
+        if (ChunkAccess::WriteForward == access) {
+          // The evaluation might have modified the data.
+          updateEncoding(chunkPos);
+        }
+      }
+
+      /// @}
+
+    private:
+
+      /*******************************************************************************/
+      /// @name Compression management
+
+      CODI_INLINE bool isCompressed(size_t const& chunkPos) const {
+        return !this->states[chunkPos].encoded.empty();
+      }
+
+      /// Encodes the data of the chunk and releases its memory.
+      void compress(size_t const& chunkPos) {
+        Chunk* chunk = this->chunks[chunkPos];
+
+        encode(chunk, chunk->getUsedSize(), this->states[chunkPos].encoded);
+        chunk->deleteData();
+      }
+
+      /// Decodes the data of the chunk into its own memory.
+      void decompress(size_t const& chunkPos) {
+        if (isCompressed(chunkPos)) {
+          Chunk* chunk = this->chunks[chunkPos];
+          std::vector<ChunkEncoding::Word>& encoded = this->states[chunkPos].encoded;
+
+          chunk->allocateData();
+          decode(encoded, chunk->getUsedSize(), chunk);
+          std::vector<ChunkEncoding::Word>().swap(encoded);
+
+          if (decodedChunk == chunkPos) {
+            decodedChunk = NoChunk;
+          }
+        }
+      }
+
+      CODI_NO_INLINE void decodeToBuffer(size_t const& chunkPos) {
+        if (nullptr == decodeBuffer) {
+          decodeBuffer = new Chunk(this->chunkSize);
+        }
+
+        size_t usedSize = this->chunks[chunkPos]->getUsedSize();
+        decode(this->states[chunkPos].encoded, usedSize, decodeBuffer);
+        decodeBuffer->setUsedSize(usedSize);
+        decodedChunk = chunkPos;
+      }
+
+      /// Copies the unpacked arrays of the decoded buffer back into the encoding, if the buffer holds the data of the
+      /// chunk. Evaluations usually only modify these arrays, e.g., the old primal values in primal value tapes. If a
+      /// packed array was modified, the chunk is encoded again.
+      CODI_INLINE void updateEncoding(size_t const& chunkPos) {
+        if (isCompressed(chunkPos) && decodedChunk == chunkPos) {
+          std::vector<ChunkEncoding::Word>& encoded = this->states[chunkPos].encoded;
+
+          ChunkEncoding::Updater updater(encoded.data(), decodeBuffer->getUsedSize());
+          PointerStore<Chunk> pHandle;
+          pHandle.setPointers(0, decodeBuffer);
+          pHandle.call(updater);
+
+          if (updater.packedChanged) {
+            encoded.clear();
+            encode(decodeBuffer, decodeBuffer->getUsedSize(), encoded);
+          }
+        }
+      }
+
+      static void encode(Chunk* chunk, size_t const& count, std::vector<ChunkEncoding::Word>& encoded) {
+        ChunkEncoding::Encoder encoder(encoded, count);
+        PointerStore<Chunk> pHandle;
+        pHandle.setPointers(0, chunk);
+        pHandle.call(encoder);
+
+        if (encoded.empty()) {
+          // Ensure a non empty encoding for chunks without entries.
+          encoded.push_back(0);
+        }
+        encoded.shrink_to_fit();
+      }
+
+      static void decode(std::vector<ChunkEncoding::Word> const& encoded, size_t const& count, Chunk* chunk) {
+        ChunkEncoding::Decoder decoder(encoded.data(), count);
+        PointerStore<Chunk> pHandle;
+        pHandle.setPointers(0, chunk);
+        pHandle.call(decoder);
+      }
+  };
+
+  /// CompressedChunkedData with the same template signature as DefaultChunkedData. Can be used for the Data template
+  /// argument of the tape types, e.g., JacobianTapeTypes.
+  template<typename Chunk, typename NestedData = EmptyData>
+  using DefaultCompressedChunkedData = CompressedChunkedData<Chunk, NestedData>;
+}
@@ -205,6 +205,9 @@ namespace codi {
        *    argVector.addDataSize(5);
        *  \endcode
        *
+       * Chunks with an interleaved layout, e.g. PackedChunk2, provide pointer like types instead of plain pointers. The
+       * types of the pointers are then given by the Pointer1, Pointer2, ... definitions of the chunk.
+       *
        * @param[in] pointers  The pointers that are populated with the data from the internal representation.
        * @tparam Data  Types of the pointers.
        */
@@ -0,0 +1,364 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../../config.h"
+#include "../../misc/exceptions.hpp"
+#include "../../misc/macros.hpp"
+#include "chunk.hpp"
+#include "chunkedDataBase.hpp"
+#include "dataInterface.hpp"
+#include "emptyData.hpp"
+#include "pointerStore.hpp"
+#include "position.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+  /**
+   * @brief Places the data arrays of one chunk in memory mapped files.
+   *
+   * Each array is mapped from its own file in the scratch directory. The files are unlinked directly after their
+   * creation, so they are removed by the operating system when the mapping is released. Since the mappings are shared
+   * file mappings, the operating system can write finished data to the file and reclaim the memory.
+   *
+   * The access functions forward hints about the upcoming access pattern to the operating system via madvise.
+   */
+  struct MappedChunkMemory : public ChunkMemoryResource {
+    private:
+
+      struct Region {
+          void* memory;
+          size_t bytes;
+      };
+
+      std::string directory;
+      std::vector<Region> regions;
+
+    public:
+
+      /// Constructor
+      MappedChunkMemory(std::string const& directory) : directory(directory), regions() {}
+
+      /// Destructor
+      ~MappedChunkMemory() {
+        // Chunks free their data before the memory resource is deleted. This is the fallback for remaining mappings.
+        for (Region& region : regions) {
+          munmap(region.memory, region.bytes);
+        }
+      }
+
+      /*******************************************************************************/
+      /// @name ChunkMemoryResource interface implementation
+      /// @{
+
+      /// \copydoc ChunkMemoryResource::allocate
+      void* allocate(size_t bytes, size_t alignment) {
+        // Mappings are page aligned.
+        codiAssert(alignment <= (size_t)sysconf(_SC_PAGESIZE));
+        CODI_UNUSED(alignment);
+
+        // Empty mappings are not allowed.
+        bytes = std::max(bytes, (size_t)1);
+
+        std::string fileTemplate = directory + "/codiTapeXXXXXX";
+        std::vector<char> fileName(fileTemplate.begin(), fileTemplate.end());
+        fileName.push_back('\0');
+
+        int fd = mkstemp(fileName.data());
+        if (-1 == fd) {
+          CODI_EXCEPTION("Could not create tape file in '%s': %s", directory.c_str(), strerror(errno));
+        }
+        unlink(fileName.data());
+
+        if (0 != ftruncate(fd, (off_t)bytes)) {
+          int error = errno;  // close may overwrite errno.
+          close(fd);
+          CODI_EXCEPTION("Could not resize tape file to %zu bytes: %s", bytes, strerror(error));
+        }
+
+        void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (MAP_FAILED == memory) {
+          int error = errno;  // close may overwrite errno.
+          close(fd);
+          CODI_EXCEPTION("Could not map tape file with %zu bytes: %s", bytes, strerror(error));
+        }
+        close(fd);  // The mapping keeps the file alive.
+
+        regions.push_back(Region{memory, bytes});
+
+        return memory;
+      }
+
+      /// \copydoc ChunkMemoryResource::free
+      void free(void* memory, size_t bytes, size_t alignment) {
+        CODI_UNUSED(bytes, alignment);
+
+        for (size_t i = 0; i < regions.size(); i += 1) {
+          if (regions[i].memory == memory) {
+            munmap(regions[i].memory, regions[i].bytes);
+            regions.erase(regions.begin() + i);
+            break;
+          }
+        }
+      }
+
+      /// @}
+      /*******************************************************************************/
+      /// @name Access hints
+      /// @{
+
+      /// The data is accessed in increasing order, e.g., during recording or forward evaluations.
+      void adviseForwardAccess() {
+        advise(MADV_SEQUENTIAL);
+      }
+
+      /// The data is accessed in decreasing order, e.g., during reverse evaluations.
+      ///
+      /// There is no hint for reverse sequential access. The forward read ahead is disabled and the data is requested.
+      void adviseReverseAccess() {
+        advise(MADV_RANDOM);
+        advise(MADV_WILLNEED);
+      }
+
+      /// The data is accessed in the near future. The operating system can start to read it in the background.
+      void adviseWillNeed() {
+        advise(MADV_WILLNEED);
+      }
+
+      /// The data is not accessed in the near future. The operating system can write it out and reclaim the memory.
+      void adviseFinished() {
+#ifdef MADV_COLD
+        advise(MADV_COLD);
+#else
+        // The pages are dropped from the process. For shared file mappings, the data is kept in the file.
+        advise(MADV_DONTNEED);
+#endif
+      }
+
+      /// @}
+      /*******************************************************************************/
+      /// @name Settings
+      /// @{
+
+      /// Directory for the tape files of all data streams that are created afterwards.
+      ///
+      /// Defaults to the value of the environment variable CODI_MAPPED_DATA_DIR or to /tmp.
+      static std::string& defaultDirectory() {
+        static std::string directory = []() {
+          char const* env = getenv("CODI_MAPPED_DATA_DIR");
+          return std::string(nullptr != env ? env : "/tmp");
+        }();
+
+        return directory;
+      }
+
+      /// @}
+
+    private:
+
+      void advise(int advice) {
+        for (Region& region : regions) {
+          madvise(region.memory, region.bytes, advice);
+        }
+      }
+  };
+
+  /// Mapped memory of one chunk in MappedChunkedData.
+  struct MappedChunkState {
+    public:
+      MappedChunkMemory* memory;  ///< Owned by MappedChunkedData.
+
+      /// Constructor
+      MappedChunkState() : memory(nullptr) {}
+  };
+
+  /**
+   * @brief Data is stored chunk-wise in memory mapped files. If a chunk runs out of space, a new chunk is created.
+   *
+   * See DataInterface documentation for details.
+   *
+   * Behaves like ChunkedData but places the data arrays of each chunk in memory mapped files, see MappedChunkMemory
+   * and ChunkedDataBase.
+   * The data can therefore grow beyond the physical memory. The operating system is informed about the access pattern:
+   *  - Recording: Chunks are written sequentially. Finished chunks are marked such that the operating system can page
+   *    them out.
+   *  - Evaluation: The chunk that is evaluated next is requested in advance. Evaluated chunks are marked such that the
+   *    operating system can page them out.
+   *
+   * Each chunk has the size provided in the constructor. The files are created in
+   * MappedChunkMemory::defaultDirectory(), or in the directory set with #setDirectory.
+   *
+   * The implementation requires the POSIX functions mmap and madvise.
+   *
+   * @tparam T_Chunk            Has to implement ChunkBase. The chunk defines the data stored in this implementation.
+   * @tparam T_NestedData       Nested DataInterface.
+   * @tparam T_PointerInserter  Defines how data is appended to evaluate* function calls.
+   */
+  template<typename T_Chunk, typename T_NestedData = EmptyData, typename T_PointerInserter = PointerStore<T_Chunk>>
+  struct MappedChunkedData
+      : public ChunkedDataBase<T_Chunk, T_NestedData, T_PointerInserter,
+                               MappedChunkedData<T_Chunk, T_NestedData, T_PointerInserter>, MappedChunkState> {
+    public:
+
+      using Chunk = CODI_DD(T_Chunk, Chunk1<CODI_ANY>);                                 ///< See MappedChunkedData
+      using NestedData = CODI_DD(T_NestedData, CODI_T(DataInterface<CODI_ANY>));        ///< See MappedChunkedData
+      using PointerInserter = CODI_DD(T_PointerInserter, CODI_T(PointerStore<Chunk>));  ///< See MappedChunkedData
+
+      /// Base class abbreviation.
+      using Base = ChunkedDataBase<Chunk, NestedData, PointerInserter, MappedChunkedData, MappedChunkState>;
+      friend Base;  ///< Allow the base class to call protected and private methods.
+
+    private:
+      std::string directory;
+
+    public:
+
+      /// Allocate chunkSize entries and set the nested DataInterface.
+      MappedChunkedData(size_t const& chunkSize, NestedData* nested)
+          : Base(chunkSize), directory(MappedChunkMemory::defaultDirectory()) {
+        Base::setNested(nested);
+      }
+
+      /// Allocate chunkSize entries. Requires a call to #setNested.
+      MappedChunkedData(size_t const& chunkSize) : Base(chunkSize), directory(MappedChunkMemory::defaultDirectory()) {}
+
+      /// Destructor
+      ~MappedChunkedData() {
+        Base::deleteChunks();
+      }
+
+      /*******************************************************************************/
+      /// @name Misc functions
+      /// @{
+
+      /// \copydoc DataInterface::addToTapeValues <br><br>
+      /// Implementation: Adds: Total number, Number of chunks, Memory used, Memory allocated
+      ///
+      /// The memory is reported as allocated even if it has been paged out to the files.
+      void addToTapeValues(TapeValues& values) const {
+        Base::addToTapeValues(values);
+      }
+
+      /// Directory for the files of chunks that are created afterwards.
+      void setDirectory(std::string const& dir) {
+        directory = dir;
+      }
+
+      /// \copydoc DataInterface::swap
+      void swap(MappedChunkedData& other) {
+        Base::swap(other);
+        std::swap(directory, other.directory);
+      }
+
+      /// @}
+
+    protected:
+
+      /*******************************************************************************/
+      /// @name ChunkedDataBase implementation
+      /// @{
+
+      /// \copydoc ChunkedDataBase::newChunk
+      Chunk* newChunk(MappedChunkState& state) {
+        state.memory = new MappedChunkMemory(directory);
+        state.memory->adviseForwardAccess();
+
+        return new Chunk(this->chunkSize, state.memory);
+      }
+
+      /// \copydoc ChunkedDataBase::deleteChunk
+      void deleteChunk(Chunk* chunk, MappedChunkState& state) {
+        delete chunk;
+        delete state.memory;
+      }
+
+      /// \copydoc ChunkedDataBase::beginRecording
+      Chunk* beginRecording(size_t const& chunkPos) {
+        this->states[chunkPos].memory->adviseForwardAccess();
+
+        return this->chunks[chunkPos];
+      }
+
+      /// \copydoc ChunkedDataBase::endRecording <br><br>
+      /// Implementation: The chunk can be paged out.
+      void endRecording(size_t const& chunkPos) {
+        this->states[chunkPos].memory->adviseFinished();
+      }
+
+      /// \copydoc ChunkedDataBase::beginAccess
+      CODI_INLINE Chunk* beginAccess(size_t const& chunkPos, ChunkAccess access) {
+        if (ChunkAccess::ReadReverse == access) {
+          this->states[chunkPos].memory->adviseReverseAccess();
+        } else if (ChunkAccess::Modify != access) {
+          this->states[chunkPos].memory->adviseForwardAccess();
+        }
+
+        return this->chunks[chunkPos];
+      }
+
+      /// \copydoc ChunkedDataBase::endAccess <br><br>
+      /// Implementation: Accessed chunks can be paged out. The chunk used for recording is kept.
+      CODI_INLINE void endAccess(size_t const& chunkPos, ChunkAccess access) {
+        if (ChunkAccess::Modify != access && chunkPos != this->curChunkIndex) {
+          this->states[chunkPos].memory->adviseFinished();
+        }
+      }
+
+      /// \copydoc ChunkedDataBase::prefetchChunk
+      CODI_INLINE void prefetchChunk(size_t const& chunkPos, ChunkAccess access) {
+        CODI_UNUSED(access);
+
+        this->states[chunkPos].memory->adviseWillNeed();
+      }
+
+      /// @}
+  };
+
+  /// MappedChunkedData with the same template signature as DefaultChunkedData. Can be used for the Data template
+  /// argument of the tape types, e.g., JacobianTapeTypes.
+  template<typename Chunk, typename NestedData = EmptyData>
+  using DefaultMappedChunkedData = MappedChunkedData<Chunk, NestedData>;
+}
@@ -0,0 +1,316 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "../../config.h"
+#include "../../misc/fileIo.hpp"
+#include "../../misc/macros.hpp"
+#include "chunk.hpp"
+#include "pointerStore.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+  /**
+   * @brief Pointer like access to one entry of the items in a PackedChunk2.
+   *
+   * Item i is stored in block i / blockSize at lane i % blockSize. The member offset selects the entry in the block.
+   * Supports the operations that the tape evaluations perform on the data pointers: indexing and moving the pointer.
+   *
+   * @tparam T_Data        Type of the entry.
+   * @tparam blockSize     Number of items in one block.
+   * @tparam blockBytes    Size of one block.
+   * @tparam memberOffset  Offset of the entry array in the block.
+   */
+  template<typename T_Data, size_t blockSize, size_t blockBytes, size_t memberOffset>
+  struct PackedPointer {
+    public:
+
+      using Data = CODI_DD(T_Data, int);  ///< See PackedPointer.
+
+    private:
+
+      char* blocks;
+      size_t offset;
+
+    public:
+
+      /// Constructor
+      CODI_INLINE PackedPointer() : blocks(nullptr), offset(0) {}
+
+      /// Constructor
+      CODI_INLINE PackedPointer(char* blocks, size_t offset) : blocks(blocks), offset(offset) {}
+
+      /// Access to item offset + index.
+      CODI_INLINE Data& operator[](size_t const& index) const {
+        size_t const pos = offset + index;
+
+        return *reinterpret_cast<Data*>(blocks + (pos / blockSize) * blockBytes + memberOffset +
+                                        (pos % blockSize) * sizeof(Data));
+      }
+
+      /// Move the pointer forward.
+      CODI_INLINE PackedPointer& operator+=(size_t const& count) {
+        offset += count;
+        return *this;
+      }
+
+      /// Move the pointer backward.
+      CODI_INLINE PackedPointer& operator-=(size_t const& count) {
+        offset -= count;
+        return *this;
+      }
+  };
+
+  /**
+   * @brief Chunk with two entries per item that are stored interleaved.
+   *
+   * Chunk2 stores each entry in its own array. Here, blocks of items are stored consecutively. Each block contains
+   * the arrays of the entries for blockSize items (array of structures of arrays, AoSoA). With a block size of one,
+   * each item is a padded structure (array of structures, AoS).
+   *
+   * Evaluations that access both entries of an item then read one memory stream instead of two. The data pointers
+   * are PackedPointer objects instead of plain pointers, so only code that is generic in the pointer types can work on
+   * this chunk. See PackedChunkedData.
+   *
+   * @tparam T_Data1     Any type.
+   * @tparam T_Data2     Any type.
+   * @tparam blockSize   Number of items in one block. Should be a power of two.
+   */
+  template<typename T_Data1, typename T_Data2, size_t blockSize>
+  struct PackedChunk2 final : public ChunkBase {
+    public:
+
+      using Base = ChunkBase;  ///< Abbreviation for the base class type.
+
+      using Data1 = CODI_DD(T_Data1, int);  ///< See PackedChunk2.
+      using Data2 = CODI_DD(T_Data2, int);  ///< See PackedChunk2.
+
+      /// Storage of blockSize items.
+      struct Block {
+        public:
+          Data1 data1[blockSize];  ///< First entries.
+          Data2 data2[blockSize];  ///< Second entries.
+      };
+
+      /// Offset of the second entries in the block.
+      static size_t constexpr Offset2 = (blockSize * sizeof(Data1) + alignof(Data2) - 1) / alignof(Data2) *
+                                        alignof(Data2);
+
+      using Pointer1 = PackedPointer<Data1, blockSize, sizeof(Block), 0>;        ///< Access to the first entries.
+      using Pointer2 = PackedPointer<Data2, blockSize, sizeof(Block), Offset2>;  ///< Access to the second entries.
+
+    private:
+
+      Block* blocks;
+
+    public:
+
+      /// Constructor
+      CODI_INLINE PackedChunk2(size_t const& size, ChunkMemoryResource* memoryResource = nullptr)
+          : ChunkBase(size, memoryResource), blocks(nullptr) {
+        allocateData();
+      }
+
+      /// Destructor
+      CODI_INLINE ~PackedChunk2() {
+        deleteData();
+      }
+
+      /*******************************************************************************/
+      /// @name ChunkBase interface implementation
+      /// @{
+
+      static size_t constexpr EntrySize = sizeof(Block) / blockSize;  ///< \copydoc ChunkBase::EntrySize
+
+      /// \copydoc ChunkBase::allocateData()
+      CODI_INLINE void allocateData() {
+        if (nullptr == blocks) {
+          blocks = allocateArray<Block>(getBlockCount());
+        }
+      }
+
+      /// \copydoc ChunkBase::dataPointer
+      CODI_INLINE void dataPointer(size_t const& index, Pointer1& pointer1, Pointer2& pointer2) {
+        codiAssert(index <= ChunkBase::size);
+        pointer1 = Pointer1(reinterpret_cast<char*>(blocks), index);
+        pointer2 = Pointer2(reinterpret_cast<char*>(blocks), index);
+      }
+
+      /// \copydoc ChunkBase::deleteData
+      CODI_INLINE void deleteData() {
+        if (nullptr != blocks) {
+          deleteArray(blocks, getBlockCount());
+          blocks = nullptr;
+        }
+      }
+
+      /// \copydoc ChunkBase::erase
+      void erase(size_t const& start, size_t const& end) {
+        codiAssert(start <= end);
+        codiAssert(start < usedSize);
+        codiAssert(end <= usedSize);
+
+        if (start != end) {
+          Pointer1 pointer1;
+          Pointer2 pointer2;
+          dataPointer(0, pointer1, pointer2);
+
+          for (size_t i = 0; i < usedSize - end; ++i) {
+            pointer1[start + i] = pointer1[end + i];
+            pointer2[start + i] = pointer2[end + i];
+          }
+          usedSize -= end - start;
+        }
+      }
+
+      /// \copydoc ChunkBase::pushData
+      CODI_INLINE void pushData(Data1 const& value1, Data2 const& value2) {
+        codiAssert(getUnusedSize() != 0);
+        Block& block = blocks[usedSize / blockSize];
+        block.data1[usedSize % blockSize] = value1;
+        block.data2[usedSize % blockSize] = value2;
+        usedSize += 1;
+      }
+
+      /// \copydoc ChunkBase::readData
+      CODI_INLINE void readData(FileIo& handle) {
+        allocateData();
+
+        handle.readData(blocks, getBlockCount());
+      }
+
+      /// \copydoc ChunkBase::swap
+      CODI_INLINE void swap(PackedChunk2& other) {
+        Base::swap(other);
+
+        std::swap(blocks, other.blocks);
+      }
+
+      /// \copydoc ChunkBase::writeData
+      CODI_INLINE void writeData(FileIo& handle) const {
+        handle.writeData(blocks, getBlockCount());
+      }
+
+      /// @}
+
+    private:
+
+      CODI_INLINE size_t getBlockCount() const {
+        return (size + blockSize - 1) / blockSize;
+      }
+  };
+
+  /**
+   * @brief Pointer store for PackedChunk2 data.
+   *
+   * See PointerStore for details.
+   */
+  template<typename T_Data1, typename T_Data2, size_t blockSize>
+  struct PointerStore<PackedChunk2<T_Data1, T_Data2, blockSize>> {
+    public:
+
+      using Data1 = CODI_DD(T_Data1, int);  ///< Data entry 1.
+      using Data2 = CODI_DD(T_Data2, int);  ///< Data entry 2.
+
+      using Chunk = PackedChunk2<Data1, Data2, blockSize>;  ///< Template specialization type.
+
+    private:
+      typename Chunk::Pointer1 p1;  ///< Internal pointer store.
+      typename Chunk::Pointer2 p2;  ///< Internal pointer store.
+
+    public:
+
+      /// \copydoc PointerStore::call
+      template<typename FuncObj, typename... Args>
+      void call(FuncObj& func, Args&&... args) {
+        func(p1, p2, std::forward<Args>(args)...);
+      }
+
+      /// \copydoc PointerStore::callAndAppend
+      template<typename FuncObj, typename... Args>
+      void callAndAppend(FuncObj& func, Args&&... args) {
+        func(std::forward<Args>(args)..., p1, p2);
+      }
+
+      /// \copydoc PointerStore::callNestedForward
+      template<int selectedDepth, typename Nested, typename... Args>
+      CODI_INLINE void callNestedForward(Nested* nested, size_t& start, size_t const& end, Args&&... args) {
+        nested->template evaluateForward<selectedDepth>(std::forward<Args>(args)..., start, end, p1, p2);
+      }
+
+      /// \copydoc PointerStore::callNestedReverse
+      template<int selectedDepth, typename Nested, typename... Args>
+      CODI_INLINE void callNestedReverse(Nested* nested, size_t& start, size_t const& end, Args&&... args) {
+        nested->template evaluateReverse<selectedDepth>(std::forward<Args>(args)..., start, end, p1, p2);
+      }
+
+      /// \copydoc PointerStore::setPointers
+      void setPointers(size_t const& dataPos, Chunk* chunk) {
+        chunk->dataPointer(dataPos, p1, p2);
+      }
+  };
+
+  /**
+   * @brief Selects the packed layout for a chunk.
+   *
+   * Only the Jacobian data of Jacobian tapes, a Chunk2 with a floating point first entry and an integral second entry,
+   * is packed. The tape evaluations for this data are generic in the pointer types. All other chunks are consumed
+   * through plain pointers and keep their layout.
+   *
+   * @tparam T_Chunk     Chunk requested by the tape.
+   * @tparam blockSize   See PackedChunk2.
+   */
+  template<typename T_Chunk, size_t blockSize, typename = void>
+  struct PackedChunkLayout {
+    public:
+
+      using Type = T_Chunk;  ///< Chunk that is used.
+  };
+
+#ifndef DOXYGEN_DISABLE
+  template<typename Data1, typename Data2, size_t blockSize>
+  struct PackedChunkLayout<
+      Chunk2<Data1, Data2>, blockSize,
+      typename std::enable_if<std::is_floating_point<Data1>::value && std::is_integral<Data2>::value>::type> {
+    public:
+
+      using Type = PackedChunk2<Data1, Data2, blockSize>;
+  };
+#endif
+}
@@ -0,0 +1,437 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <unistd.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../../config.h"
+#include "../../misc/fileIo.hpp"
+#include "../../misc/macros.hpp"
+#include "chunk.hpp"
+#include "chunkedDataBase.hpp"
+#include "dataInterface.hpp"
+#include "emptyData.hpp"
+#include "pointerStore.hpp"
+#include "position.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+  /// Settings for all SpillingChunkedData instances.
+  struct SpillingChunkedDataSettings {
+    public:
+
+      /// Directory for the spill files of all data streams.
+      ///
+      /// Defaults to the value of the environment variable CODI_SPILL_DIR or to /tmp.
+      static std::string& directory() {
+        static std::string directory = []() {
+          char const* env = getenv("CODI_SPILL_DIR");
+          return std::string(nullptr != env ? env : "/tmp");
+        }();
+
+        return directory;
+      }
+
+      /// Creates a unique file name in the spill directory.
+      static std::string createFileName() {
+        static std::atomic<size_t> counter(0);
+
+        return directory() + "/codiSpill_" + std::to_string(getpid()) + "_" + std::to_string(counter++) + ".bin";
+      }
+  };
+
+  /**
+   * @brief Executes the file operations of SpillingChunkedData in a background thread.
+   *
+   * The thread is started with the worker and runs until the worker is deleted. Tasks are executed in the order in
+   * which they are submitted.
+   */
+  struct SpillingIoWorker {
+    private:
+
+      std::mutex mutex;
+      std::condition_variable condition;
+      std::deque<std::packaged_task<void()>> tasks;
+      bool stop;
+
+      std::thread thread;  // Started last, after all other members are initialized.
+
+    public:
+
+      /// Constructor
+      SpillingIoWorker() : mutex(), condition(), tasks(), stop(false), thread(&SpillingIoWorker::run, this) {}
+
+      /// Destructor. Finishes all submitted tasks.
+      ~SpillingIoWorker() {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          stop = true;
+        }
+        condition.notify_one();
+
+        thread.join();
+      }
+
+      /// Add a task to the queue. The future is ready after the task was executed.
+      template<typename Task>
+      std::shared_future<void> submit(Task&& task) {
+        std::packaged_task<void()> packagedTask(std::forward<Task>(task));
+        std::shared_future<void> future = packagedTask.get_future().share();
+
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          tasks.push_back(std::move(packagedTask));
+        }
+        condition.notify_one();
+
+        return future;
+      }
+
+    private:
+
+      void run() {
+        for (;;) {
+          std::packaged_task<void()> task;
+          {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return stop || !tasks.empty(); });
+
+            if (tasks.empty()) {
+              return;  // Stop was requested and all tasks are finished.
+            }
+
+            task = std::move(tasks.front());
+            tasks.pop_front();
+          }
+
+          task();
+        }
+      }
+  };
+
+  /// Storage state of one chunk in SpillingChunkedData.
+  struct SpillState {
+    public:
+      std::string file;               ///< Spill file of the chunk.
+      bool resident;                  ///< Data is allocated in memory.
+      bool onDisk;                    ///< File contains the current data.
+      std::shared_future<void> task;  ///< Last pending background read or write.
+
+      /// Constructor
+      SpillState() : file(), resident(true), onDisk(false), task() {}
+  };
+
+  /**
+   * @brief Data is stored chunk-wise. Chunks that are not in use are written to disk in the background.
+   *
+   * See DataInterface documentation for details.
+   *
+   * Behaves like ChunkedData, but only a few chunks are kept in memory, see ChunkedDataBase for the chunk management:
+   *  - Recording: If a chunk is full, it is written to a file in the background and its memory is released. At most
+   *    #MaxPendingSpills chunks are written at the same time, recording waits if the disk can not keep up.
+   *  - Evaluation: While a chunk is evaluated, the next chunk in evaluation order is read in the background. Evaluated
+   *    chunks are released again. Chunks are only written again if their data was modified, that is, by forward
+   *    evaluations, e.g., in primal value tapes, by erase() or by forEachChunk(). Reverse evaluations and
+   *    forEachForward() / forEachReverse() only read the data.
+   *  - Chunks accessed by erase() or forEachChunk() stay in memory until they are used by an evaluation, since the
+   *    function of forEachChunk() may replace or delete the data.
+   *  - resize(): The new chunks allocate memory only when they are used for recording.
+   *
+   * The chunk that is used for recording is always kept in memory. The file operations are executed by one
+   * SpillingIoWorker per data stream and use the writeData() and readData() functions of the chunks.
+   *
+   * The files are created in SpillingChunkedDataSettings::directory() and removed if the chunk is deleted.
+   *
+   * @tparam T_Chunk            Has to implement ChunkBase. The chunk defines the data stored in this implementation.
+   * @tparam T_NestedData       Nested DataInterface.
+   * @tparam T_PointerInserter  Defines how data is appended to evaluate* function calls.
+   */
+  template<typename T_Chunk, typename T_NestedData = EmptyData, typename T_PointerInserter = PointerStore<T_Chunk>>
+  struct SpillingChunkedData
+      : public ChunkedDataBase<T_Chunk, T_NestedData, T_PointerInserter,
+                               SpillingChunkedData<T_Chunk, T_NestedData, T_PointerInserter>, SpillState> {
+    public:
+
+      using Chunk = CODI_DD(T_Chunk, Chunk1<CODI_ANY>);                                 ///< See SpillingChunkedData
+      using NestedData = CODI_DD(T_NestedData, CODI_T(DataInterface<CODI_ANY>));        ///< See SpillingChunkedData
+      using PointerInserter = CODI_DD(T_PointerInserter, CODI_T(PointerStore<Chunk>));  ///< See SpillingChunkedData
+
+      /// Base class abbreviation.
+      using Base = ChunkedDataBase<Chunk, NestedData, PointerInserter, SpillingChunkedData, SpillState>;
+      friend Base;  ///< Allow the base class to call protected and private methods.
+
+      static size_t constexpr MaxPendingSpills = 2;  ///< Maximum number of chunks that are written during recording.
+
+    private:
+
+      std::unique_ptr<SpillingIoWorker> worker;  // Created with the first file operation.
+
+    public:
+
+      /// Allocate chunkSize entries and set the nested DataInterface.
+      SpillingChunkedData(size_t const& chunkSize, NestedData* nested) : Base(chunkSize), worker() {
+        Base::setNested(nested);
+      }
+
+      /// Allocate chunkSize entries. Requires a call to #setNested.
+      SpillingChunkedData(size_t const& chunkSize) : Base(chunkSize), worker() {}
+
+      /// Destructor
+      ~SpillingChunkedData() {
+        Base::deleteChunks();
+      }
+
+      /*******************************************************************************/
+      /// @name Misc functions
+      /// @{
+
+      /// \copydoc DataInterface::addToTapeValues <br><br>
+      /// Implementation: Adds: Total number, Number of chunks, Resident chunks, Memory used, Memory allocated
+      ///
+      /// Only the resident chunks are counted as allocated memory.
+      void addToTapeValues(TapeValues& values) const {
+        size_t numberOfChunks = this->chunks.size();
+        size_t residentChunks = 0;
+        for (SpillState const& state : this->states) {
+          if (state.resident) {
+            residentChunks += 1;
+          }
+        }
+        size_t dataEntries = this->getDataSize();
+        size_t entrySize = Chunk::EntrySize;
+
+        double memoryUsed = (double)dataEntries * (double)entrySize;
+        double memoryAlloc = (double)residentChunks * (double)this->chunkSize * (double)entrySize;
+
+        values.addUnsignedLongEntry("Total number", dataEntries);
+        values.addUnsignedLongEntry("Number of chunks", numberOfChunks);
+        values.addUnsignedLongEntry("Resident chunks", residentChunks);
+        values.addDoubleEntry("Memory used", memoryUsed, true, false);
+        values.addDoubleEntry("Memory allocated", memoryAlloc, false, true);
+      }
+
+      /// \copydoc DataInterface::swap
+      void swap(SpillingChunkedData& other) {
+        Base::swap(other);
+
+        // Pending tasks only refer to the chunks and files, they are moved with them.
+        std::swap(worker, other.worker);
+      }
+
+      /// @}
+
+    protected:
+
+      /*******************************************************************************/
+      /// @name ChunkedDataBase implementation
+      /// @{
+
+      /// \copydoc ChunkedDataBase::newChunk
+      Chunk* newChunk(SpillState& state) {
+        state.file = SpillingChunkedDataSettings::createFileName();
+
+        return new Chunk(this->chunkSize);
+      }
+
+      /// \copydoc ChunkedDataBase::deleteChunk <br><br>
+      /// Implementation: Also removes the file.
+      void deleteChunk(Chunk* chunk, SpillState& state) {
+        if (state.task.valid()) {
+          state.task.wait();
+        }
+
+        delete chunk;
+        std::remove(state.file.c_str());
+      }
+
+      /// \copydoc ChunkedDataBase::clearChunk <br><br>
+      /// Implementation: Neither the memory nor the file contain valid data afterwards.
+      void clearChunk(size_t const& chunkPos) {
+        waitForTask(chunkPos);
+
+        this->chunks[chunkPos]->reset();
+        this->chunks[chunkPos]->deleteData();
+        this->states[chunkPos].resident = false;
+        this->states[chunkPos].onDisk = false;
+      }
+
+      /// \copydoc ChunkedDataBase::beginRecording
+      Chunk* beginRecording(size_t const& chunkPos) {
+        acquire(chunkPos);
+        this->states[chunkPos].onDisk = false;
+
+        return this->chunks[chunkPos];
+      }
+
+      /// \copydoc ChunkedDataBase::endRecording <br><br>
+      /// Implementation: Writes the chunk in the background and limits the number of pending writes.
+      void endRecording(size_t const& chunkPos) {
+        spill(chunkPos);
+
+        // Limit the memory of chunks that are still written.
+        if (chunkPos >= MaxPendingSpills) {
+          waitForTask(chunkPos - MaxPendingSpills);
+        }
+      }
+
+      /// \copydoc ChunkedDataBase::beginAccess
+      CODI_INLINE Chunk* beginAccess(size_t const& chunkPos, ChunkAccess access) {
+        acquire(chunkPos);
+
+        if (ChunkAccess::WriteForward == access || ChunkAccess::Modify == access) {
+          this->states[chunkPos].onDisk = false;
+        }
+
+        return this->chunks[chunkPos];
+      }
+
+      /// \copydoc ChunkedDataBase::endAccess
+      CODI_INLINE void endAccess(size_t const& chunkPos, ChunkAccess access) {
+        if (ChunkAccess::Modify != access) {
+          release(chunkPos);
+        }
+      }
+
+      /// \copydoc ChunkedDataBase::prefetchChunk
+      CODI_INLINE void prefetchChunk(size_t const& chunkPos, ChunkAccess access) {
+        CODI_UNUSED(access);
+
+        prefetch(chunkPos);
+      }
+
+      /// @}
+
+    private:
+
+      /*******************************************************************************/
+      /// @name Spill management
+
+      SpillingIoWorker& getWorker() {
+        if (nullptr == worker) {
+          worker.reset(new SpillingIoWorker());
+        }
+
+        return *worker;
+      }
+
+      /// Waits for background tasks of the chunk. Exceptions of the task are forwarded.
+      void waitForTask(size_t const& chunkPos) {
+        SpillState& state = this->states[chunkPos];
+        if (state.task.valid()) {
+          std::shared_future<void> task = state.task;
+          state.task = std::shared_future<void>();
+
+          task.get();
+        }
+      }
+
+      /// Ensures that the data of the chunk is in memory.
+      CODI_NO_INLINE void acquire(size_t const& chunkPos) {
+        waitForTask(chunkPos);
+
+        SpillState& state = this->states[chunkPos];
+        if (!state.resident) {
+          if (state.onDisk) {
+            FileIo io(state.file, false);
+            this->chunks[chunkPos]->readData(io);
+          } else {
+            this->chunks[chunkPos]->allocateData();
+          }
+
+          state.resident = true;
+        }
+      }
+
+      /// Starts a background read of the chunk data.
+      CODI_NO_INLINE void prefetch(size_t const& chunkPos) {
+        SpillState& state = this->states[chunkPos];
+        if (!state.resident && state.onDisk) {
+          Chunk* chunk = this->chunks[chunkPos];
+          std::string file = state.file;
+
+          state.task = getWorker().submit([chunk, file]() {
+            FileIo io(file, false);
+            chunk->readData(io);
+          });
+          state.resident = true;
+        }
+      }
+
+      /// Releases the memory of the chunk. The chunk used for recording is kept in memory.
+      CODI_INLINE void release(size_t const& chunkPos) {
+        if (chunkPos != this->curChunkIndex && this->states[chunkPos].resident) {
+          spill(chunkPos);
+        }
+      }
+
+      /// Writes the chunk data in the background, if the file is not up to date, and releases the memory.
+      CODI_NO_INLINE void spill(size_t const& chunkPos) {
+        SpillState& state = this->states[chunkPos];
+        Chunk* chunk = this->chunks[chunkPos];
+        std::string file = state.file;
+        bool write = !state.onDisk;
+
+        // Tasks are executed in order, a pending task of the chunk is finished before this one starts.
+        state.task = getWorker().submit([chunk, file, write]() {
+          if (write) {
+            FileIo io(file, true);
+            chunk->writeData(io);
+          }
+          chunk->deleteData();
+        });
+        state.resident = false;
+        state.onDisk = true;
+      }
+  };
+
+  /// SpillingChunkedData with the same template signature as DefaultChunkedData. Can be used for the Data template
+  /// argument of the tape types, e.g., JacobianTapeTypes.
+  template<typename Chunk, typename NestedData = EmptyData>
+  using DefaultSpillingChunkedData = SpillingChunkedData<Chunk, NestedData>;
+}
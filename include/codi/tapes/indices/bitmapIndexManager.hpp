@@ -0,0 +1,70 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include "indexReusePolicies.hpp"
+#include "multiUseIndexManager.hpp"
+#include "reuseIndexManager.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+  /**
+   * @brief Reuse index manager that stores the free indices in a hierarchical bitmap.
+   *
+   * Same behavior and interface as the ReuseIndexManager, but the free indices are kept in a
+   * LowestFirstIndexReusePolicy. Each created index costs two bits of bookkeeping instead of one vector entry per free
+   * index, assignIndex and freeIndex are amortized O(1) and a reset only combines the bitmaps, no sorting is required.
+   * The smallest free index is always assigned first, which keeps the adjoint vector dense.
+   *
+   * Usable with the JacobianReuseTape and PrimalValueReuseTape, e.g.
+   * `RealReverseIndexGen<double, double, BitmapIndexManager<int>>`.
+   *
+   * @tparam Index  Type for the identifier, usually an integer type.
+   */
+  template<typename Index>
+  using BitmapIndexManager = ReuseIndexManager<Index, LowestFirstIndexReusePolicy<Index>>;
+
+  /**
+   * @brief MultiUseIndexManager that stores the free indices in a hierarchical bitmap.
+   *
+   * The copy optimization of the MultiUseIndexManager with the free index storage of the BitmapIndexManager. The
+   * reference counts still require one Index per created index.
+   *
+   * @tparam Index  Type for the identifier, usually an integer type.
+   */
+  template<typename Index>
+  using MultiUseBitmapIndexManager = MultiUseIndexManager<Index, LowestFirstIndexReusePolicy<Index>>;
+}
@@ -0,0 +1,265 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <vector>
+
+#include "../../config.h"
+#include "../../misc/macros.hpp"
+#include "reuseIndexManager.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+  /**
+   * @brief MultiUseIndexManager variant that updates the reference counts in batches.
+   *
+   * The MultiUseIndexManager updates the reference count of an index on every assign, copy and free, which is a
+   * scattered read-modify-write in the count vector. This index manager appends +index or -index to a sequential log
+   * instead. The log is resolved, i.e., the counts are updated and indices with a zero count are freed, when the reuse
+   * index pools run empty or the log is full.
+   *
+   * Since the count of the left hand side is not known on an assignment, the index is not reused in place as in the
+   * MultiUseIndexManager. The old index is logged as freed and a new one is taken from the pools. If the pools are
+   * empty, the log is resolved first, so the old index can still be handed out again.
+   *
+   * Freed indices are only available after the log is resolved. The index free events are reported during the
+   * resolution.
+   *
+   * @tparam T_Index        Type for the identifier, usually an integer type.
+   * @tparam T_ReusePolicy  Storage and reuse order of the freed indices, see IndexReusePolicyInterface.
+   */
+  template<typename T_Index, typename T_ReusePolicy = LifoIndexReusePolicy<T_Index>>
+  struct DeferredMultiUseIndexManager : public ReuseIndexManager<T_Index, T_ReusePolicy> {
+    public:
+
+      using Index = CODI_DD(T_Index, int);  ///< See DeferredMultiUseIndexManager.
+      using ReusePolicy = CODI_DD(T_ReusePolicy, LifoIndexReusePolicy<Index>);  ///< See DeferredMultiUseIndexManager.
+      using Base = ReuseIndexManager<Index, ReusePolicy>;                       ///< Base class abbreviation.
+
+      /*******************************************************************************/
+      /// @name IndexManagerInterface: Constants
+      /// @{
+
+      static bool constexpr CopyNeedsStatement =
+          !Config::CopyOptimization;           ///< Copy optimization only active if configured.
+      static bool constexpr IsLinear = false;  ///< See ReuseIndexManager.
+      using Base::NeedsStaticStorage;          ///< See ReuseIndexManager.
+
+      /// @}
+
+    private:
+
+      std::vector<Index> indexUse;  ///< Reference counting for each index, valid after the log is resolved.
+
+      std::vector<Index> useLog;  ///< Pending reference count changes, +index for a new use, -index for a release.
+      size_t useLogPos;           ///< Number of pending changes.
+
+    public:
+
+      /// Constructor
+      DeferredMultiUseIndexManager(Index const& reservedIndices)
+          : Base(reservedIndices), indexUse(), useLog(Config::SmallChunkSize), useLogPos(0) {
+        resizeUseVector();
+      }
+
+      /*******************************************************************************/
+      /// @name ReuseIndexManager: Overwrites
+      /// @{
+
+      /// \copydoc ReuseIndexManager::addToTapeValues <br><br>
+      /// Implementation: Additionally adds memory consumed by the index use vector and the use log.
+      void addToTapeValues(TapeValues& values) const {
+        Base::addToTapeValues(values);
+
+        double memoryIndexUseVector = (double)indexUse.size() * (double)(sizeof(Index));
+        double memoryUseLog = (double)useLog.size() * (double)(sizeof(Index));
+
+        values.addDoubleEntry("Memory: index use vector", memoryIndexUseVector, true, true);
+        values.addDoubleEntry("Memory: index use log", memoryUseLog, true, true);
+      }
+
+      /// \copydoc ReuseIndexManager::assignIndex
+      template<typename Tape>
+      CODI_INLINE bool assignIndex(Index& index) {
+        if (Base::InactiveIndex != index) {
+          logUse<Tape>(-index);
+          index = Base::InactiveIndex;
+        }
+
+        if (CODI_Unlikely(this->usedIndices.empty() && this->unusedIndices.empty())) {
+          resolveUseLog<Tape>();
+        }
+
+        bool generatedNewIndex = Base::template assignIndex<Tape>(index);
+        if (generatedNewIndex) {
+          resizeUseVector();
+        }
+
+        logUse<Tape>(index);
+
+        return generatedNewIndex;
+      }
+
+      /// \copydoc ReuseIndexManager::assignUnusedIndex
+      template<typename Tape>
+      CODI_INLINE bool assignUnusedIndex(Index& index) {
+        freeIndex<Tape>(index);  // Zero check is performed inside.
+
+        bool generatedNewIndex = Base::template assignUnusedIndex<Tape>(index);
+        if (generatedNewIndex) {
+          resizeUseVector();
+        }
+
+        logUse<Tape>(index);
+
+        return generatedNewIndex;
+      }
+
+      /// \copydoc ReuseIndexManager::copyIndex
+      template<typename Tape>
+      CODI_INLINE void copyIndex(Index& lhs, Index const& rhs) {
+        if (Config::CopyOptimization) {
+          // Skip the logic if the indices are the same.
+          // This also prevents the bug that if &lhs == &rhs, the left hand side will always be deactivated.
+          if (lhs != rhs) {
+            freeIndex<Tape>(lhs);
+
+            if (Base::InactiveIndex != rhs) {  // Do not handle the zero index.
+              EventSystem<Tape>::notifyIndexCopyListeners(rhs);
+
+              logUse<Tape>(rhs);
+              lhs = rhs;
+            }
+          }
+        } else {
+          // Path if copy optimizations are disabled.
+          assignIndex<Tape>(lhs);
+        }
+      }
+
+      /// \copydoc ReuseIndexManager::freeIndex
+      template<typename Tape>
+      CODI_INLINE void freeIndex(Index& index) {
+        if (Base::valid && Base::InactiveIndex != index) {  // Do not free the zero index.
+          logUse<Tape>(-index);
+          index = Base::InactiveIndex;
+        }
+      }
+
+      /// \copydoc ReuseIndexManager::getNumberOfLiveReferences <br><br>
+      /// Implementation: The sum of the reference counts after the pending log is applied. Each log entry changes the
+      /// sum by one, so the log is accounted for without modifying the counts.
+      size_t getNumberOfLiveReferences() const {
+        size_t references = 0;
+        for (Index const& use : indexUse) {
+          references += (size_t)use;
+        }
+
+        for (size_t pos = 0; pos < useLogPos; ++pos) {
+          if (useLog[pos] > 0) {
+            references += 1;
+          } else {
+            references -= 1;
+          }
+        }
+
+        return references;
+      }
+
+      /// \copydoc ReuseIndexManager::renumberIndices <br><br>
+      /// Implementation: Applies the pending log and moves the reference counts to the new indices. Indices whose count
+      /// dropped to zero are not live and therefore discarded by the renumbering.
+      void renumberIndices(std::vector<Index> const& newIndices, Index const& largestIndex) {
+        for (size_t pos = 0; pos < useLogPos; ++pos) {
+          Index const entry = useLog[pos];
+          if (entry > 0) {
+            indexUse[entry] += 1;
+          } else {
+            indexUse[-entry] -= 1;
+          }
+        }
+        useLogPos = 0;
+
+        std::vector<Index> newIndexUse((size_t)largestIndex + 1, Index(0));
+        for (size_t index = 1; index < newIndices.size() && index < indexUse.size(); index += 1) {
+          if (Base::InactiveIndex != newIndices[index]) {
+            newIndexUse[newIndices[index]] = indexUse[index];
+          }
+        }
+        indexUse.swap(newIndexUse);
+
+        Base::renumberIndices(newIndices, largestIndex);
+      }
+
+      /// @}
+
+    private:
+
+      CODI_NO_INLINE void resizeUseVector() {
+        indexUse.resize(this->getLargestCreatedIndex() + 1);
+      }
+
+      template<typename Tape>
+      CODI_INLINE void logUse(Index const& entry) {
+        if (CODI_Unlikely(useLogPos == useLog.size())) {
+          resolveUseLog<Tape>();
+        }
+
+        useLog[useLogPos] = entry;
+        useLogPos += 1;
+      }
+
+      /// Apply the pending changes and free all released indices with a zero count.
+      /// A count can drop to zero only once per log, since the index is not handed out again before it is freed.
+      template<typename Tape>
+      CODI_NO_INLINE void resolveUseLog() {
+        for (size_t pos = 0; pos < useLogPos; ++pos) {
+          Index entry = useLog[pos];
+          if (entry > 0) {
+            indexUse[entry] += 1;
+          } else {
+            entry = -entry;
+            indexUse[entry] -= 1;
+            if (0 == indexUse[entry]) {
+              Base::template freeIndex<Tape>(entry);
+            }
+          }
+        }
+
+        useLogPos = 0;
+      }
+  };
+}
@@ -0,0 +1,510 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../../config.h"
+#include "../../misc/macros.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+  /**
+   * @brief Storage and reuse order for the freed indices of a ReuseIndexManagerBase.
+   *
+   * The index manager keeps two sets of indices, the ones freed in the current recording and the ones not used since
+   * the last reset. Both are stored in a reuse policy. The policy decides which index is handed out next and thereby
+   * how the adjoint vector is accessed.
+   *
+   * Implementations:
+   *  - LifoIndexReusePolicy: The most recently freed index is reused first. Sorted on reset if
+   *    Config::SortIndicesOnReset is set.
+   *  - LowestFirstIndexReusePolicy: The smallest free index is reused first. Based on a hierarchical bitmap, a reset
+   *    is linear in the number of indices divided by 64.
+   *  - BlockLocalIndexReusePolicy: The free index closest to the last handed out index is reused first.
+   *
+   * @tparam T_Index  Type for the identifier, usually an integer type.
+   */
+  template<typename T_Index>
+  struct IndexReusePolicyInterface {
+    public:
+
+      using Index = CODI_DD(T_Index, int);  ///< See IndexReusePolicyInterface.
+
+      /*******************************************************************************/
+      /// @name Interface definition
+
+      static std::string getName();  ///< Name of the policy for the tape values.
+
+      size_t size() const;  ///< Number of stored indices.
+      bool empty() const;   ///< True if no indices are stored.
+
+      void push(Index const& index);                    ///< Add one index.
+      void pushRange(Index const& first, size_t count);  ///< Add first, first + 1, ..., first + count - 1.
+      void pushAll(Index const* begin, Index const* end);  ///< Add all indices in [begin, end).
+
+      Index pop();  ///< Take one index. The policy must not be empty.
+
+      /// Take up to count indices and store them in indices, which is resized. Returns the number of taken indices.
+      size_t popBlock(std::vector<Index>& indices, size_t count);
+
+      /// Move all indices of freed into this policy, called during the reset of the index manager.
+      void mergeOnReset(IndexReusePolicyInterface& freed);
+
+      /// Call func(index) for each stored index.
+      template<typename Func>
+      void forEach(Func&& func) const;
+
+      void clear();  ///< Remove all indices.
+
+      double getMemoryUsed() const;       ///< Memory in bytes required for the stored indices.
+      double getMemoryAllocated() const;  ///< Memory in bytes that is allocated.
+  };
+
+  /// Last in first out index reuse, see IndexReusePolicyInterface.
+  template<typename T_Index>
+  struct LifoIndexReusePolicy : public IndexReusePolicyInterface<T_Index> {
+    public:
+
+      using Index = CODI_DD(T_Index, int);  ///< See LifoIndexReusePolicy.
+
+    private:
+
+      std::vector<Index> indices;
+      size_t indicesPos;
+
+    public:
+
+      /// Constructor
+      LifoIndexReusePolicy() : indices(Config::SmallChunkSize), indicesPos(0) {}
+
+      /// \copydoc IndexReusePolicyInterface::getName
+      static std::string getName() {
+        return "LIFO";
+      }
+
+      /// \copydoc IndexReusePolicyInterface::size
+      CODI_INLINE size_t size() const {
+        return indicesPos;
+      }
+
+      /// \copydoc IndexReusePolicyInterface::empty
+      CODI_INLINE bool empty() const {
+        return 0 == indicesPos;
+      }
+
+      /// \copydoc IndexReusePolicyInterface::push
+      CODI_INLINE void push(Index const& index) {
+        if (CODI_Unlikely(indicesPos == indices.size())) {
+          reserve(indicesPos + 1);
+        }
+
+        indices[indicesPos] = index;
+        indicesPos += 1;
+      }
+
+      /// \copydoc IndexReusePolicyInterface::pushRange
+      void pushRange(Index const& first, size_t count) {
+        reserve(indicesPos + count);
+        for (size_t pos = 0; pos < count; ++pos) {
+          indices[indicesPos + pos] = first + Index(pos);
+        }
+        indicesPos += count;
+      }
+
+      /// \copydoc IndexReusePolicyInterface::pushAll
+      void pushAll(Index const* begin, Index const* end) {
+        reserve(indicesPos + (end - begin));
+        indicesPos = std::copy(begin, end, indices.begin() + indicesPos) - indices.begin();
+      }
+
+      /// \copydoc IndexReusePolicyInterface::pop
+      CODI_INLINE Index pop() {
+        codiAssert(0 != indicesPos);
+
+        indicesPos -= 1;
+        return indices[indicesPos];
+      }
+
+      /// \copydoc IndexReusePolicyInterface::popBlock <br><br>
+      /// Implementation: Takes the most recently added indices.
+      size_t popBlock(std::vector<Index>& target, size_t count) {
+        count = std::min(count, indicesPos);
+        target.assign(indices.begin() + (indicesPos - count), indices.begin() + indicesPos);
+        indicesPos -= count;
+
+        return count;
+      }
+
+      /// \copydoc IndexReusePolicyInterface::mergeOnReset <br><br>
+      /// Implementation: Sorts all indices if Config::SortIndicesOnReset is set.
+      void mergeOnReset(LifoIndexReusePolicy& freed) {
+        pushAll(freed.indices.data(), freed.indices.data() + freed.indicesPos);
+        freed.indicesPos = 0;
+
+        if (Config::SortIndicesOnReset) {
+          std::sort(indices.begin(), indices.begin() + indicesPos);
+        }
+      }
+
+      /// \copydoc IndexReusePolicyInterface::forEach
+      template<typename Func>
+      void forEach(Func&& func) const {
+        for (size_t pos = 0; pos < indicesPos; ++pos) {
+          func(indices[pos]);
+        }
+      }
+
+      /// \copydoc IndexReusePolicyInterface::clear
+      void clear() {
+        indicesPos = 0;
+      }
+
+      /// \copydoc IndexReusePolicyInterface::getMemoryUsed
+      double getMemoryUsed() const {
+        return (double)indicesPos * (double)sizeof(Index);
+      }
+
+      /// \copydoc IndexReusePolicyInterface::getMemoryAllocated
+      double getMemoryAllocated() const {
+        return (double)indices.size() * (double)sizeof(Index);
+      }
+
+    private:
+
+      /// Grow in multiples of Config::SmallChunkSize.
+      CODI_NO_INLINE void reserve(size_t minimalSize) {
+        if (indices.size() < minimalSize) {
+          size_t increaseMul = (minimalSize - indices.size()) / Config::SmallChunkSize + 1;  // +1 always rounds up.
+          indices.resize(indices.size() + increaseMul * Config::SmallChunkSize);
+        }
+      }
+  };
+
+  /**
+   * @brief Index reuse based on a hierarchical bitmap of the free indices.
+   *
+   * One bit per index marks if it is free. Two summary levels mark the nonzero words of the level below, so a free
+   * index is found with three find-first-set operations. The memory is about one bit per created index, instead of one
+   * vector entry per free index.
+   *
+   * See LowestFirstIndexReusePolicy and BlockLocalIndexReusePolicy.
+   *
+   * @tparam T_Index       Type for the identifier, usually an integer type.
+   * @tparam T_BlockLocal  If the index closest to the last handed out index is preferred.
+   */
+  template<typename T_Index, bool T_BlockLocal>
+  struct BitmapIndexReusePolicy : public IndexReusePolicyInterface<T_Index> {
+    public:
+
+      using Index = CODI_DD(T_Index, int);              ///< See BitmapIndexReusePolicy.
+      static bool constexpr BlockLocal = T_BlockLocal;  ///< See BitmapIndexReusePolicy.
+
+    private:
+
+      using Word = uint64_t;
+      static size_t constexpr WordBits = 64;
+
+      std::vector<Word> words;    ///< Bit i of word w is set if index w * 64 + i is free.
+      std::vector<Word> summary;  ///< Bit i of summary word s is set if word s * 64 + i is not zero.
+      std::vector<Word> top;      ///< Bit i of top word t is set if summary word t * 64 + i is not zero.
+      size_t count;               ///< Number of free indices.
+      size_t firstTop;            ///< All top words before this one are zero.
+      size_t lastIndex;           ///< Last handed out index.
+
+    public:
+
+      /// Constructor
+      BitmapIndexReusePolicy() : words(), summary(), top(), count(0), firstTop(0), lastIndex(0) {}
+
+      /// \copydoc IndexReusePolicyInterface::getName
+      static std::string getName() {
+        return BlockLocal ? "Block local" : "Lowest first";
+      }
+
+      /// \copydoc IndexReusePolicyInterface::size
+      CODI_INLINE size_t size() const {
+        return count;
+      }
+
+      /// \copydoc IndexReusePolicyInterface::empty
+      CODI_INLINE bool empty() const {
+        return 0 == count;
+      }
+
+      /// \copydoc IndexReusePolicyInterface::push
+      CODI_INLINE void push(Index const& index) {
+        size_t const word = (size_t)index / WordBits;
+        if (CODI_Unlikely(word >= words.size())) {
+          resize(word + 1);
+        }
+
+        codiAssert(0 == (words[word] & bit(index)));
+        if (0 == words[word]) {
+          markWord(word);
+        }
+        words[word] |= bit(index);
+        count += 1;
+      }
+
+      /// \copydoc IndexReusePolicyInterface::pushRange <br><br>
+      /// Implementation: Full words are set at once.
+      void pushRange(Index const& first, size_t count) {
+        size_t const begin = (size_t)first;
+        size_t const end = begin + count;
+        resize((end + WordBits - 1) / WordBits);
+
+        size_t pos = begin;
+        while (pos < end) {
+          size_t const word = pos / WordBits;
+          size_t const wordEnd = std::min(end, (word + 1) * WordBits);
+          size_t const length = wordEnd - pos;
+
+          Word mask = (WordBits == length) ? ~Word(0) : ((Word(1) << length) - 1) << (pos % WordBits);
+          codiAssert(0 == (words[word] & mask));
+          if (0 == words[word]) {
+            markWord(word);
+          }
+          words[word] |= mask;
+
+          pos = wordEnd;
+        }
+
+        this->count += count;
+      }
+
+      /// \copydoc IndexReusePolicyInterface::pushAll
+      void pushAll(Index const* begin, Index const* end) {
+        for (Index const* cur = begin; cur != end; ++cur) {
+          push(*cur);
+        }
+      }
+
+      /// \copydoc IndexReusePolicyInterface::pop
+      CODI_INLINE Index pop() {
+        codiAssert(0 != count);
+
+        if (BlockLocal) {
+          return popNearLast();
+        } else {
+          return popLowest();
+        }
+      }
+
+      /// \copydoc IndexReusePolicyInterface::popBlock
+      size_t popBlock(std::vector<Index>& target, size_t count) {
+        count = std::min(count, this->count);
+        target.resize(count);
+        for (Index& index : target) {
+          index = pop();
+        }
+
+        return count;
+      }
+
+      /// \copydoc IndexReusePolicyInterface::mergeOnReset <br><br>
+      /// Implementation: Combines the bitmaps word by word, no sorting is required.
+      void mergeOnReset(BitmapIndexReusePolicy& freed) {
+        if (freed.words.size() > words.size()) {
+          resize(freed.words.size());
+        }
+
+        orInto(words, freed.words);
+        orInto(summary, freed.summary);
+        orInto(top, freed.top);
+
+        count += freed.count;
+        firstTop = std::min(firstTop, freed.firstTop);
+        freed.clear();
+      }
+
+      /// \copydoc IndexReusePolicyInterface::forEach
+      template<typename Func>
+      void forEach(Func&& func) const {
+        for (size_t word = 0; word < words.size(); ++word) {
+          Word bits = words[word];
+          while (0 != bits) {
+            func(Index(word * WordBits + countTrailingZeros(bits)));
+            bits &= bits - 1;
+          }
+        }
+      }
+
+      /// \copydoc IndexReusePolicyInterface::clear
+      void clear() {
+        std::fill(words.begin(), words.end(), Word(0));
+        std::fill(summary.begin(), summary.end(), Word(0));
+        std::fill(top.begin(), top.end(), Word(0));
+        count = 0;
+        firstTop = top.size();
+      }
+
+      /// \copydoc IndexReusePolicyInterface::getMemoryUsed
+      double getMemoryUsed() const {
+        return getMemoryAllocated();
+      }
+
+      /// \copydoc IndexReusePolicyInterface::getMemoryAllocated
+      double getMemoryAllocated() const {
+        return (double)(words.size() + summary.size() + top.size()) * (double)sizeof(Word);
+      }
+
+    private:
+
+      static CODI_INLINE Word bit(size_t const& pos) {
+        return Word(1) << (pos % WordBits);
+      }
+
+      static CODI_INLINE size_t countTrailingZeros(Word const& value) {
+        codiAssert(0 != value);
+#if defined(__GNUC__) || defined(__clang__)
+        return (size_t)__builtin_ctzll(value);
+#else
+        size_t result = 0;
+        while (0 == (value & bit(result))) {
+          result += 1;
+        }
+        return result;
+#endif
+      }
+
+      static CODI_INLINE size_t highestBit(Word const& value) {
+        codiAssert(0 != value);
+#if defined(__GNUC__) || defined(__clang__)
+        return WordBits - 1 - (size_t)__builtin_clzll(value);
+#else
+        size_t result = WordBits - 1;
+        while (0 == (value & bit(result))) {
+          result -= 1;
+        }
+        return result;
+#endif
+      }
+
+      static void orInto(std::vector<Word>& target, std::vector<Word> const& source) {
+        for (size_t pos = 0; pos < source.size(); ++pos) {
+          target[pos] |= source[pos];
+        }
+      }
+
+      /// Resize to at least the given number of words, rounded up to a full top word.
+      CODI_NO_INLINE void resize(size_t minimalWords) {
+        if (words.size() < minimalWords) {
+          size_t constexpr Granularity = WordBits * WordBits;
+
+          size_t newWords = std::max(minimalWords, 2 * words.size());
+          newWords = (newWords + Granularity - 1) / Granularity * Granularity;
+
+          words.resize(newWords, Word(0));
+          summary.resize(newWords / WordBits, Word(0));
+          top.resize(newWords / Granularity, Word(0));
+        }
+      }
+
+      /// Word is about to become nonzero.
+      CODI_INLINE void markWord(size_t const& word) {
+        size_t const summaryWord = word / WordBits;
+        if (0 == summary[summaryWord]) {
+          size_t const topWord = summaryWord / WordBits;
+          top[topWord] |= bit(summaryWord);
+          firstTop = std::min(firstTop, topWord);
+        }
+        summary[summaryWord] |= bit(word);
+      }
+
+      CODI_INLINE Index take(size_t const& word, size_t const& pos) {
+        words[word] &= ~bit(pos);
+        if (0 == words[word]) {
+          size_t const summaryWord = word / WordBits;
+          summary[summaryWord] &= ~bit(word);
+          if (0 == summary[summaryWord]) {
+            top[summaryWord / WordBits] &= ~bit(summaryWord);
+          }
+        }
+        count -= 1;
+
+        lastIndex = word * WordBits + pos;
+        return Index(lastIndex);
+      }
+
+      CODI_INLINE Index popLowest() {
+        while (0 == top[firstTop]) {
+          firstTop += 1;
+        }
+
+        size_t const summaryWord = firstTop * WordBits + countTrailingZeros(top[firstTop]);
+        size_t const word = summaryWord * WordBits + countTrailingZeros(summary[summaryWord]);
+        return take(word, countTrailingZeros(words[word]));
+      }
+
+      /// Search the 4096 indices around the last index, first upwards then downwards.
+      CODI_INLINE Index popNearLast() {
+        size_t const lastWord = lastIndex / WordBits;
+        size_t const summaryWord = lastWord / WordBits;
+
+        if (summaryWord >= summary.size() || 0 == summary[summaryWord]) {
+          return popLowest();
+        }
+
+        Word const upperWords = summary[summaryWord] & (~Word(0) << (lastWord % WordBits));
+        if (0 != upperWords) {
+          size_t const word = summaryWord * WordBits + countTrailingZeros(upperWords);
+          Word bits = words[word];
+          if (word == lastWord) {
+            Word const upperBits = bits & (~Word(0) << (lastIndex % WordBits));
+            if (0 != upperBits) {
+              bits = upperBits;
+            }
+          }
+          return take(word, countTrailingZeros(bits));
+        } else {
+          size_t const word = summaryWord * WordBits + highestBit(summary[summaryWord]);
+          return take(word, highestBit(words[word]));
+        }
+      }
+  };
+
+  /// Reuses the smallest free index first, see IndexReusePolicyInterface.
+  template<typename Index>
+  using LowestFirstIndexReusePolicy = BitmapIndexReusePolicy<Index, false>;
+
+  /// Reuses the free index closest to the last handed out one first, see IndexReusePolicyInterface.
+  template<typename Index>
+  using BlockLocalIndexReusePolicy = BitmapIndexReusePolicy<Index, true>;
+}
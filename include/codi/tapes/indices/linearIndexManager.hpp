@@ -34,6 +34,7 @@
  */
 #pragma once
 
+#include <limits>
 #include <vector>
 
 #include "../../config.h"
@@ -123,7 +124,7 @@ namespace codi {
       /// \copydoc IndexManagerInterface::assignIndex
       template<typename Tape>
       CODI_INLINE bool assignIndex(Index& index) {
-        if (CODI_ENABLE_CHECK(Config::OverflowCheck, count > count + 1)) {
+        if (CODI_ENABLE_CHECK(Config::OverflowCheck, std::numeric_limits<Index>::max() == count)) {
           CODI_EXCEPTION("Overflow in linear index handler. Use a larger index type or a reuse index manager.");
         }
         count += 1;
@@ -0,0 +1,202 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../../config.h"
+#include "../../misc/exceptions.hpp"
+#include "../../misc/macros.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+  /**
+   * @brief Lock-free pool of index batches that is shared by multiple threads.
+   *
+   * Threads push batches of freed indices with push() and take them with pop(). Each batch is copied into pool owned
+   * storage. The storage is never released while the pool exists, it is reused for later batches.
+   *
+   * Batches are kept in two Treiber stacks, one for filled and one for empty batches. The stack heads combine the
+   * batch number with a modification counter, which prevents ABA problems. The compare-and-swap operations are not
+   * part of AtomicInterface, therefore std::atomic is used directly.
+   *
+   * @tparam T_Index  Type for the identifier, usually an integer type.
+   */
+  template<typename T_Index>
+  struct LockFreeIndexBatchPool {
+    public:
+
+      using Index = CODI_DD(T_Index, int);  ///< See LockFreeIndexBatchPool.
+
+    private:
+
+      using Head = uint64_t;
+
+      static uint32_t constexpr NoBatch = 0;     ///< Batch numbers in the heads are shifted by one.
+      static size_t constexpr BlockSize = 1024;  ///< Number of batches allocated at once.
+      static size_t constexpr MaxBlocks = 4096;  ///< Limits the pool to MaxBlocks * BlockSize batches.
+
+      struct Batch {
+        public:
+          std::vector<Index> indices;
+          std::atomic<uint32_t> next;
+
+          Batch() : indices(), next(NoBatch) {}
+      };
+
+      std::atomic<Batch*> blocks[MaxBlocks];
+      std::atomic<uint32_t> createdBatches;
+
+      std::atomic<Head> filledBatches;
+      std::atomic<Head> emptyBatches;
+
+      // Signed, since a pop can decrement the counter before the increment of the matching push is visible.
+      std::atomic<std::ptrdiff_t> numberOfFilledBatches;
+
+    public:
+
+      /// Constructor
+      LockFreeIndexBatchPool() : createdBatches(0), filledBatches(0), emptyBatches(0), numberOfFilledBatches(0) {
+        for (std::atomic<Batch*>& block : blocks) {
+          block.store(nullptr);
+        }
+      }
+
+      /// Destructor
+      ~LockFreeIndexBatchPool() {
+        for (std::atomic<Batch*>& block : blocks) {
+          delete[] block.load();
+        }
+      }
+
+      /// Add a copy of the indices [begin, end) to the pool.
+      void push(Index const* begin, Index const* end) {
+        uint32_t batch = popBatch(emptyBatches);
+        if (NoBatch == batch) {
+          batch = createBatch();
+        }
+
+        getBatch(batch).indices.assign(begin, end);
+        pushBatch(filledBatches, batch);
+        numberOfFilledBatches.fetch_add(1);
+      }
+
+      /// @brief Copy the indices of one batch into indices, starting at position pos.
+      ///
+      /// indices is resized if required. Returns the number of indices that were added. Zero if the pool is empty.
+      size_t pop(std::vector<Index>& indices, size_t pos) {
+        uint32_t batch = popBatch(filledBatches);
+        if (NoBatch == batch) {
+          return 0;
+        }
+        numberOfFilledBatches.fetch_sub(1);
+
+        std::vector<Index> const& batchIndices = getBatch(batch).indices;
+        size_t const size = batchIndices.size();
+        if (indices.size() < pos + size) {
+          indices.resize(pos + size);
+        }
+        std::copy(batchIndices.begin(), batchIndices.end(), indices.begin() + pos);
+
+        pushBatch(emptyBatches, batch);
+
+        return size;
+      }
+
+      /// Number of batches that can currently be taken from the pool. Only an estimate if other threads modify the
+      /// pool.
+      size_t getNumberOfBatches() const {
+        std::ptrdiff_t const number = numberOfFilledBatches.load();
+        return number < 0 ? 0 : (size_t)number;
+      }
+
+    private:
+
+      CODI_INLINE Batch& getBatch(uint32_t const& batch) {
+        size_t const id = batch - 1;
+        return blocks[id / BlockSize].load()[id % BlockSize];
+      }
+
+      CODI_NO_INLINE uint32_t createBatch() {
+        size_t const id = createdBatches.fetch_add(1);
+        size_t const block = id / BlockSize;
+
+        if (block >= MaxBlocks) {
+          CODI_EXCEPTION("Number of index batches exceeded, maximum is %d.", (int)(MaxBlocks * BlockSize));
+        }
+
+        if (nullptr == blocks[block].load()) {
+          Batch* newBlock = new Batch[BlockSize];
+          Batch* expected = nullptr;
+          if (!blocks[block].compare_exchange_strong(expected, newBlock)) {
+            delete[] newBlock;  // Another thread was faster.
+          }
+        }
+
+        return (uint32_t)(id + 1);
+      }
+
+      CODI_INLINE static Head makeHead(Head const& oldHead, uint32_t const& batch) {
+        return (((oldHead >> 32) + 1) << 32) | (Head)batch;
+      }
+
+      void pushBatch(std::atomic<Head>& head, uint32_t const& batch) {
+        Batch& data = getBatch(batch);
+        Head oldHead = head.load();
+        do {
+          data.next.store((uint32_t)oldHead);
+        } while (!head.compare_exchange_weak(oldHead, makeHead(oldHead, batch)));
+      }
+
+      uint32_t popBatch(std::atomic<Head>& head) {
+        Head oldHead = head.load();
+        uint32_t batch;
+        do {
+          batch = (uint32_t)oldHead;
+          if (NoBatch == batch) {
+            return NoBatch;
+          }
+          // The batch might be taken by another thread in between, the counter in the head detects this.
+        } while (!head.compare_exchange_weak(oldHead, makeHead(oldHead, getBatch(batch).next.load())));
+
+        return batch;
+      }
+  };
+}
@@ -51,14 +51,16 @@ namespace codi {
    * Performs reference counting for each index. If the reference count is zero, then the index is freed and given back
    * to the ReuseIndexManager.
    *
-   * @tparam T_Index   Type for the identifier, usually an integer type.
+   * @tparam T_Index        Type for the identifier, usually an integer type.
+   * @tparam T_ReusePolicy  Storage and reuse order of the freed indices, see IndexReusePolicyInterface.
    */
-  template<typename T_Index>
-  struct MultiUseIndexManager : public ReuseIndexManager<T_Index> {
+  template<typename T_Index, typename T_ReusePolicy = LifoIndexReusePolicy<T_Index>>
+  struct MultiUseIndexManager : public ReuseIndexManager<T_Index, T_ReusePolicy> {
     public:
 
-      using Index = CODI_DD(T_Index, int);    ///< See MultiUseIndexManager.
-      using Base = ReuseIndexManager<Index>;  ///< Base class abbreviation.
+      using Index = CODI_DD(T_Index, int);  ///< See MultiUseIndexManager.
+      using ReusePolicy = CODI_DD(T_ReusePolicy, LifoIndexReusePolicy<Index>);  ///< See MultiUseIndexManager.
+      using Base = ReuseIndexManager<Index, ReusePolicy>;                       ///< Base class abbreviation.
 
       /*******************************************************************************/
       /// @name IndexManagerInterface: Constants
@@ -174,6 +176,31 @@ namespace codi {
         }
       }
 
+      /// \copydoc ReuseIndexManager::getNumberOfLiveReferences <br><br>
+      /// Implementation: The sum of the reference counts, an index can be held by multiple variables.
+      size_t getNumberOfLiveReferences() const {
+        size_t references = 0;
+        for (Index const& use : indexUse) {
+          references += (size_t)use;
+        }
+
+        return references;
+      }
+
+      /// \copydoc ReuseIndexManager::renumberIndices <br><br>
+      /// Implementation: Additionally moves the reference counts to the new indices.
+      void renumberIndices(std::vector<Index> const& newIndices, Index const& largestIndex) {
+        std::vector<Index> newIndexUse((size_t)largestIndex + 1, Index(0));
+        for (size_t index = 1; index < newIndices.size() && index < indexUse.size(); index += 1) {
+          if (Base::InactiveIndex != newIndices[index]) {
+            newIndexUse[newIndices[index]] = indexUse[index];
+          }
+        }
+        indexUse.swap(newIndexUse);
+
+        Base::renumberIndices(newIndices, largestIndex);
+      }
+
       /// @}
 
     private:
@@ -0,0 +1,167 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+#include "../../config.h"
+#include "../../misc/macros.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+#pragma pack(push, 1)
+  /**
+   * @brief Signed integer identifier that is stored in T_Bytes bytes.
+   *
+   * Can be used as the Index type of the index managers if more than 2^31 identifiers are required, e.g.
+   * `RealReverseGen<double, double, PackedIdentifier<5>>`. Since the chunks store each entry in its own array, the
+   * identifier streams of the tape require only T_Bytes per entry instead of the eight bytes of int64_t.
+   *
+   * All arithmetic is performed on int64_t, the value is truncated to 8 * T_Bytes bits on assignment. Loads and stores
+   * are unaligned.
+   *
+   * @tparam T_Bytes  Number of bytes for the storage, from 4 to 7.
+   */
+  template<size_t T_Bytes>
+  struct PackedIdentifier {
+    public:
+
+      static size_t constexpr Bytes = T_Bytes;  ///< See PackedIdentifier.
+      static_assert(4 <= Bytes && Bytes <= 7, "Packed identifiers need between 4 and 7 bytes.");
+
+      using Integer = int64_t;  ///< Type for the arithmetic.
+
+      static size_t constexpr Bits = 8 * Bytes;                       ///< Number of stored bits.
+      static Integer constexpr Max = (Integer(1) << (Bits - 1)) - 1;  ///< Largest representable value.
+      static Integer constexpr Min = -Max - 1;                        ///< Smallest representable value.
+
+    private:
+
+      Integer value : Bits;
+
+    public:
+
+      /// Constructor, uninitialized like the built-in integers.
+      PackedIdentifier() = default;
+
+      /// Constructor
+      constexpr PackedIdentifier(Integer value) : value(value) {}
+
+      /// Conversion to the arithmetic type.
+      constexpr CODI_INLINE operator Integer() const {
+        return value;
+      }
+
+      /*******************************************************************************/
+      /// @name Assignment operators
+      /// @{
+
+      /// Addition
+      CODI_INLINE PackedIdentifier& operator+=(Integer const& other) {
+        value = value + other;
+        return *this;
+      }
+
+      /// Subtraction
+      CODI_INLINE PackedIdentifier& operator-=(Integer const& other) {
+        value = value - other;
+        return *this;
+      }
+
+      /// Prefix increment
+      CODI_INLINE PackedIdentifier& operator++() {
+        return *this += 1;
+      }
+
+      /// Postfix increment
+      CODI_INLINE PackedIdentifier operator++(int) {
+        PackedIdentifier old = *this;
+        *this += 1;
+        return old;
+      }
+
+      /// Prefix decrement
+      CODI_INLINE PackedIdentifier& operator--() {
+        return *this -= 1;
+      }
+
+      /// Postfix decrement
+      CODI_INLINE PackedIdentifier operator--(int) {
+        PackedIdentifier old = *this;
+        *this -= 1;
+        return old;
+      }
+
+      /// @}
+  };
+#pragma pack(pop)
+
+  /// 40 bit identifier, up to 2^39 - 1 identifiers.
+  using Identifier40 = PackedIdentifier<5>;
+
+  /// 48 bit identifier, up to 2^47 - 1 identifiers.
+  using Identifier48 = PackedIdentifier<6>;
+}
+
+namespace std {
+
+  /// Specialization of std::numeric_limits for the packed identifiers.
+  template<size_t Bytes>
+  struct numeric_limits<codi::PackedIdentifier<Bytes>> : public numeric_limits<int64_t> {
+    public:
+
+      using Type = codi::PackedIdentifier<Bytes>;  ///< Abbreviation.
+
+      static int constexpr digits = (int)Type::Bits - 1;      ///< See numeric_limits
+      static int constexpr digits10 = digits * 301 / 1000;  ///< See numeric_limits
+
+      /// See numeric_limits
+      static constexpr Type min() {
+        return Type(Type::Min);
+      }
+
+      /// See numeric_limits
+      static constexpr Type max() {
+        return Type(Type::Max);
+      }
+
+      /// See numeric_limits
+      static constexpr Type lowest() {
+        return Type(Type::Min);
+      }
+  };
+}
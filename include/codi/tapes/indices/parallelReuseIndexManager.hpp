@@ -40,6 +40,7 @@
 #include "../../config.h"
 #include "../../misc/macros.hpp"
 #include "../../tools/parallel/parallelToolbox.hpp"
+#include "lockFreeIndexBatchPool.hpp"
 #include "reuseIndexManagerBase.hpp"
 
 /** \copydoc codi::Namespace */
@@ -52,18 +53,27 @@ namespace codi {
    * management, see ReuseIndexManagerBase. The key difference is that multiple tape-local index managers can acquire
    * non-overlapping ranges of indices from the same global management.
    *
+   * Freed indices are not bound to the index manager that freed them. If a manager holds more than two blocks of freed
+   * indices, it moves one block to a global lock-free pool. Managers that run out of indices take blocks from this pool
+   * before they create new indices. This keeps the number of indices bounded if variables are created on one thread and
+   * destroyed on another one. The same rules as for indices that are freed on another thread apply to taken blocks.
+   * Taken blocks are only used by assignIndex, assignUnusedIndex always creates new indices.
+   *
    * @tparam T_Index            Type for the identifier, usually an integer type.
    * @tparam T_ParallelToolbox  Tools used to make this index manager thread-safe.
+   * @tparam T_ReusePolicy      Storage and reuse order of the freed indices, see IndexReusePolicyInterface.
    */
-  template<typename T_Index, typename T_ParallelToolbox>
+  template<typename T_Index, typename T_ParallelToolbox, typename T_ReusePolicy = LifoIndexReusePolicy<T_Index>>
   struct ParallelReuseIndexManager
-      : public ReuseIndexManagerBase<T_Index, ParallelReuseIndexManager<T_Index, T_ParallelToolbox>> {
+      : public ReuseIndexManagerBase<T_Index, ParallelReuseIndexManager<T_Index, T_ParallelToolbox, T_ReusePolicy>,
+                                     T_ReusePolicy> {
     public:
 
       using Index = CODI_DD(T_Index, int);  ///< See ParallelReuseIndexManager.
       using ParallelToolbox = CODI_DD(T_ParallelToolbox,
-                                      CODI_DEFAULT_PARALLEL_TOOLBOX);        ///< See ParallelReuseIndexManager.
-      using Base = ReuseIndexManagerBase<Index, ParallelReuseIndexManager>;  ///< Base class abbreviation.
+                                      CODI_DEFAULT_PARALLEL_TOOLBOX);  ///< See ParallelReuseIndexManager.
+      using ReusePolicy = CODI_DD(T_ReusePolicy, LifoIndexReusePolicy<Index>);  ///< See ParallelReuseIndexManager.
+      using Base = ReuseIndexManagerBase<Index, ParallelReuseIndexManager, ReusePolicy>;  ///< Base class abbreviation.
       friend Base;  ///< Allow the base class to access protected and private members.
 
     private:
@@ -92,12 +102,17 @@ namespace codi {
       static bool globalMaximumIndexInitialized;      ///< Indicates whether globalMaximumIndex is initialized.
       static ReadWriteMutex globalMaximumIndexMutex;  ///< Safeguards globalMaximumIndex, globalMaximumIndexInitialized.
 
+      static Atomic<unsigned long> globalStolenIndices;  ///< Number of indices taken from the global pool.
+      static Atomic<unsigned long> globalMintedIndices;  ///< Number of indices created by generateNewIndices.
+
+      std::vector<Index> transferIndices;  ///< Buffer for blocks that are exchanged with the global pool.
+
     public:
 
       /// Constructor
       /// For a tape class that uses this index manager, all tape instances are expected to pass the same number of
       /// reservedIndices to this constructor.
-      ParallelReuseIndexManager(Index const& reservedIndices) {
+      ParallelReuseIndexManager(Index const& reservedIndices) : transferIndices() {
         globalMaximumIndexMutex.lockWrite();
         if (!globalMaximumIndexInitialized) {
           globalMaximumIndex = reservedIndices;
@@ -115,13 +130,17 @@ namespace codi {
       /// @{
 
       /// \copydoc IndexManagerInterface::addToTapeValues <br><br>
-      /// Implementation: Adds max live indices, cur live indices, indices stored, memory used, memory allocated.
+      /// Implementation: Adds max live indices, indices stolen from the global pool, newly created indices, pooled
+      /// index blocks, indices stored, memory used, memory allocated.
       void addToTapeValues(TapeValues& values) const {
         unsigned long maximumGlobalIndex = globalMaximumIndex;
 
         values.addUnsignedLongEntry("Max. live indices", maximumGlobalIndex);
         // The number of current live indices cannot be computed from one instance alone.
         // It equals the number of maximum live indices minus the number of indices stored across all instances.
+        values.addUnsignedLongEntry("Indices stolen", globalStolenIndices);
+        values.addUnsignedLongEntry("Indices minted", globalMintedIndices);
+        values.addUnsignedLongEntry("Pooled index blocks", getPool().getNumberOfBatches());
 
         Base::addToTapeValues(values);
       }
@@ -138,33 +157,63 @@ namespace codi {
 
     private:
 
+      using Pool = LockFreeIndexBatchPool<Index>;
+
+      /// The pool is never destroyed, index managers of static tapes might still free indices at program exit.
+      static Pool& getPool() {
+        static Pool* pool = new Pool();
+        return *pool;
+      }
+
+      /// Take a block of indices from the global pool.
+      CODI_NO_INLINE bool acquireFreedIndices() {
+        size_t stolen = getPool().pop(transferIndices, 0);
+        this->usedIndices.pushAll(transferIndices.data(), transferIndices.data() + stolen);
+        globalStolenIndices += (unsigned long)stolen;
+
+        return 0 != stolen;
+      }
+
+      /// Move a block of freed indices to the global pool if the local list holds more than two blocks.
+      CODI_INLINE void checkUsedIndices() {
+        if (CODI_Unlikely(this->usedIndices.size() > 2 * this->indexSizeIncrement)) {
+          moveBlockToPool();
+        }
+      }
+
+      CODI_NO_INLINE void moveBlockToPool() {
+        size_t moved = this->usedIndices.popBlock(transferIndices, this->indexSizeIncrement);
+        getPool().push(transferIndices.data(), transferIndices.data() + moved);
+      }
+
       CODI_NO_INLINE void generateNewIndices() {
         // This method is only called when unused indices are empty.
-        // Initially, a number of unused indices is created which
-        // equals the number of indices we generate now, therefore
-        // we do not have to check for size.
-
-        codiAssert(this->unusedIndices.size() >= this->indexSizeIncrement);
+        codiAssert(this->unusedIndices.empty());
 
         Index upperIndexRangeBound = globalMaximumIndex += this->indexSizeIncrement;  // note: atomic operation
         Index lowerIndexRangeBound = upperIndexRangeBound - this->indexSizeIncrement;
+        globalMintedIndices += (unsigned long)this->indexSizeIncrement;
 
-        for (size_t pos = 0; pos < this->indexSizeIncrement; ++pos) {
-          this->unusedIndices[this->unusedIndicesPos + pos] = lowerIndexRangeBound + Index(pos) + 1;
-        }
-
-        this->unusedIndicesPos = this->indexSizeIncrement;
+        this->unusedIndices.pushRange(lowerIndexRangeBound + 1, this->indexSizeIncrement);
       }
   };
 
-  template<typename Index, typename ParallelToolbox>
-  typename ParallelReuseIndexManager<Index, ParallelToolbox>::template Atomic<Index>
-      ParallelReuseIndexManager<Index, ParallelToolbox>::globalMaximumIndex;
+  template<typename Index, typename ParallelToolbox, typename ReusePolicy>
+  typename ParallelReuseIndexManager<Index, ParallelToolbox, ReusePolicy>::template Atomic<Index>
+      ParallelReuseIndexManager<Index, ParallelToolbox, ReusePolicy>::globalMaximumIndex;
+
+  template<typename Index, typename ParallelToolbox, typename ReusePolicy>
+  bool ParallelReuseIndexManager<Index, ParallelToolbox, ReusePolicy>::globalMaximumIndexInitialized = false;
+
+  template<typename Index, typename ParallelToolbox, typename ReusePolicy>
+  typename ParallelReuseIndexManager<Index, ParallelToolbox, ReusePolicy>::ReadWriteMutex
+      ParallelReuseIndexManager<Index, ParallelToolbox, ReusePolicy>::globalMaximumIndexMutex;
 
-  template<typename Index, typename ParallelToolbox>
-  bool ParallelReuseIndexManager<Index, ParallelToolbox>::globalMaximumIndexInitialized = false;
+  template<typename Index, typename ParallelToolbox, typename ReusePolicy>
+  typename ParallelReuseIndexManager<Index, ParallelToolbox, ReusePolicy>::template Atomic<unsigned long>
+      ParallelReuseIndexManager<Index, ParallelToolbox, ReusePolicy>::globalStolenIndices;
 
-  template<typename Index, typename ParallelToolbox>
-  typename ParallelReuseIndexManager<Index, ParallelToolbox>::ReadWriteMutex
-      ParallelReuseIndexManager<Index, ParallelToolbox>::globalMaximumIndexMutex;
+  template<typename Index, typename ParallelToolbox, typename ReusePolicy>
+  typename ParallelReuseIndexManager<Index, ParallelToolbox, ReusePolicy>::template Atomic<unsigned long>
+      ParallelReuseIndexManager<Index, ParallelToolbox, ReusePolicy>::globalMintedIndices;
 }
@@ -47,14 +47,17 @@ namespace codi {
    *
    * This index manager is not thread-safe.
    *
-   * @tparam T_Index   Type for the identifier, usually an integer type.
+   * @tparam T_Index        Type for the identifier, usually an integer type.
+   * @tparam T_ReusePolicy  Storage and reuse order of the freed indices, see IndexReusePolicyInterface.
    */
-  template<typename T_Index>
-  struct ReuseIndexManager : public ReuseIndexManagerBase<T_Index, ReuseIndexManager<T_Index>> {
+  template<typename T_Index, typename T_ReusePolicy = LifoIndexReusePolicy<T_Index>>
+  struct ReuseIndexManager
+      : public ReuseIndexManagerBase<T_Index, ReuseIndexManager<T_Index, T_ReusePolicy>, T_ReusePolicy> {
     public:
 
-      using Index = CODI_DD(T_Index, int);                           ///< See ReuseIndexManager.
-      using Base = ReuseIndexManagerBase<Index, ReuseIndexManager>;  ///< Base class abbreviation.
+      using Index = CODI_DD(T_Index, int);  ///< See ReuseIndexManager.
+      using ReusePolicy = CODI_DD(T_ReusePolicy, LifoIndexReusePolicy<Index>);  ///< See ReuseIndexManager.
+      using Base = ReuseIndexManagerBase<Index, ReuseIndexManager, ReusePolicy>;  ///< Base class abbreviation.
 
       friend Base;  ///< Allow the base class to call protected and private methods.
 
@@ -70,12 +73,14 @@ namespace codi {
 
     private:
 
+      Index reservedIndices;     ///< Indices that are never assigned.
       Index globalMaximumIndex;  ///< The largest created index.
 
     public:
 
       /// Constructor
-      ReuseIndexManager(Index const& reservedIndices) : globalMaximumIndex(reservedIndices) {
+      ReuseIndexManager(Index const& reservedIndices)
+          : reservedIndices(reservedIndices), globalMaximumIndex(reservedIndices) {
         generateNewIndices();
       }
 
@@ -90,7 +95,7 @@ namespace codi {
       /// Implementation: Adds max live indices, cur live indices.
       void addToTapeValues(TapeValues& values) const {
         unsigned long maximumGlobalIndex = globalMaximumIndex;
-        unsigned long storedIndices = this->usedIndicesPos + this->unusedIndicesPos;
+        unsigned long storedIndices = this->usedIndices.size() + this->unusedIndices.size();
         long currentLiveIndices = maximumGlobalIndex - storedIndices;
 
         values.addUnsignedLongEntry("Max. live indices", maximumGlobalIndex);
@@ -109,21 +114,53 @@ namespace codi {
 
       /// @}
 
+      /*******************************************************************************/
+      /// @name Index renumbering
+      /// @{
+
+      /// Number of variables that hold an index. Each assigned index is held by exactly one variable.
+      size_t getNumberOfLiveReferences() const {
+        return (size_t)(globalMaximumIndex - reservedIndices) - this->usedIndices.size() - this->unusedIndices.size();
+      }
+
+      /**
+       * @brief Apply a renumbering of all indices, see JacobianReuseTape::compactIdentifiers.
+       *
+       * Freed indices that have a new number are kept as used indices. All other freed indices are discarded. New
+       * indices are created after largestIndex. The new indices start at one, so no indices may be reserved.
+       *
+       * @param newIndices    Maps old indices to new ones. InactiveIndex if the index is dropped.
+       * @param largestIndex  The largest new index.
+       */
+      void renumberIndices(std::vector<Index> const& newIndices, Index const& largestIndex) {
+        codiAssert(0 == reservedIndices);
+
+        std::vector<Index> freedIndices;
+        freedIndices.reserve(this->usedIndices.size() + this->unusedIndices.size());
+        auto collect = [&freedIndices](Index const& index) { freedIndices.push_back(index); };
+        this->usedIndices.forEach(collect);
+        this->unusedIndices.forEach(collect);
+
+        this->usedIndices.clear();
+        this->unusedIndices.clear();
+        for (Index const& index : freedIndices) {
+          if ((size_t)index < newIndices.size() && Base::InactiveIndex != newIndices[index]) {
+            this->usedIndices.push(newIndices[index]);
+          }
+        }
+
+        globalMaximumIndex = largestIndex;
+      }
+
+      /// @}
+
     private:
 
       CODI_NO_INLINE void generateNewIndices() {
         // This method is only called when unused indices are empty.
-        // Initially, a number of unused indices is created which
-        // equals the number of indices we generate now, therefore
-        // we do not have to check for size.
-
-        codiAssert(this->unusedIndices.size() >= this->indexSizeIncrement);
-
-        for (size_t pos = 0; pos < this->indexSizeIncrement; ++pos) {
-          this->unusedIndices[this->unusedIndicesPos + pos] = globalMaximumIndex + Index(pos) + 1;
-        }
+        codiAssert(this->unusedIndices.empty());
 
-        this->unusedIndicesPos = this->indexSizeIncrement;
+        this->unusedIndices.pushRange(globalMaximumIndex + 1, this->indexSizeIncrement);
         globalMaximumIndex += this->indexSizeIncrement;
       }
   };
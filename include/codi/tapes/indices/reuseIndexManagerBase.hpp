@@ -34,13 +34,11 @@
  */
 #pragma once
 
-#include <algorithm>
-#include <vector>
-
 #include "../../config.h"
 #include "../../misc/macros.hpp"
 #include "../data/emptyData.hpp"
 #include "indexManagerInterface.hpp"
+#include "indexReusePolicies.hpp"
 
 /** \copydoc codi::Namespace */
 namespace codi {
@@ -57,18 +55,21 @@ namespace codi {
    * For generalization reasons, it also extends from the EmptyData DataInterface.
    *
    * This class contains the basic logic for index reuse. The implementing class has to add a mechanism to generate new
-   * indices.
+   * indices. The order in which freed indices are reused is defined by the reuse policy, see
+   * IndexReusePolicyInterface.
    *
-   * @tparam T_Index   Type for the identifier, usually an integer type.
-   * @tparam T_Impl    Implementing class.
+   * @tparam T_Index        Type for the identifier, usually an integer type.
+   * @tparam T_Impl         Implementing class.
+   * @tparam T_ReusePolicy  Storage and reuse order of the freed indices, see IndexReusePolicyInterface.
    */
-  template<typename T_Index, typename T_Impl>
+  template<typename T_Index, typename T_Impl, typename T_ReusePolicy>
   struct ReuseIndexManagerBase : public IndexManagerInterface<T_Index>, public EmptyData {
     public:
 
       using Index = CODI_DD(T_Index, int);                ///< See ReuseIndexManagerBase.
       using Impl = CODI_DD(T_Impl, CODI_IMPLEMENTATION);  ///< See ReuseIndexManagerBase.
-      using Base = IndexManagerInterface<Index>;          ///< Base class abbreviation.
+      using ReusePolicy = CODI_DD(T_ReusePolicy, IndexReusePolicyInterface<Index>);  ///< See ReuseIndexManagerBase.
+      using Base = IndexManagerInterface<Index>;                                      ///< Base class abbreviation.
 
       using Position = EmptyData::Position;  ///< See EmptyData.
 
@@ -84,11 +85,8 @@ namespace codi {
 
     protected:
 
-      std::vector<Index> usedIndices;  ///< Pool of indices that have already been used in this recording.
-      size_t usedIndicesPos;           ///< Number of remaining used indices.
-
-      std::vector<Index> unusedIndices;  ///< Pool of indices that have not been used in this recording yet.
-      size_t unusedIndicesPos;           ///< Number of remaining unused indices.
+      ReusePolicy usedIndices;    ///< Pool of indices that have already been used in this recording.
+      ReusePolicy unusedIndices;  ///< Pool of indices that have not been used in this recording yet.
 
       size_t indexSizeIncrement;  ///< Block size for index pool enlargement.
 
@@ -111,19 +109,29 @@ namespace codi {
 
       /// @}
 
+    protected:
+
+      /*******************************************************************************/
+      /// @name Customization points, can be overwritten by the implementing class.
+      /// @{
+
+      /// Called when usedIndices and unusedIndices are empty. Can add indices freed elsewhere to usedIndices.
+      /// Returns true if indices were added, otherwise new indices are generated.
+      CODI_INLINE bool acquireFreedIndices() {
+        return false;
+      }
+
+      /// Called after an index was added to usedIndices. Can move freed indices elsewhere.
+      CODI_INLINE void checkUsedIndices() {}
+
+      /// @}
+
     public:
 
       /// Constructor
       /// The constructor of the implementing class is expected to call generateNewIndices.
       ReuseIndexManagerBase()
-          : usedIndices(),
-            usedIndicesPos(0),
-            unusedIndices(),
-            unusedIndicesPos(0),
-            indexSizeIncrement(Config::SmallChunkSize),
-            valid(true) {
-        increaseIndicesSize(unusedIndices);
-      }
+          : usedIndices(), unusedIndices(), indexSizeIncrement(Config::SmallChunkSize), valid(true) {}
 
       /// Destructor
       ~ReuseIndexManagerBase() {
@@ -140,17 +148,15 @@ namespace codi {
         bool generatedNewIndex = false;
 
         if (Base::InactiveIndex == index) {
-          if (0 == usedIndicesPos) {
-            if (0 == unusedIndicesPos) {
-              generateNewIndices();
-              generatedNewIndex = true;
-            }
-
-            unusedIndicesPos -= 1;
-            index = unusedIndices[unusedIndicesPos];
+          if (usedIndices.empty() && unusedIndices.empty() && !cast().acquireFreedIndices()) {
+            generateNewIndices();
+            generatedNewIndex = true;
+          }
+
+          if (usedIndices.empty()) {
+            index = unusedIndices.pop();
           } else {
-            usedIndicesPos -= 1;
-            index = usedIndices[usedIndicesPos];
+            index = usedIndices.pop();
           }
         }
 
@@ -165,13 +171,12 @@ namespace codi {
         freeIndex<Tape>(index);  // Zero check is performed inside.
 
         bool generatedNewIndex = false;
-        if (0 == unusedIndicesPos) {
+        if (unusedIndices.empty()) {
           generateNewIndices();
           generatedNewIndex = true;
         }
 
-        unusedIndicesPos -= 1;
-        index = unusedIndices[unusedIndicesPos];
+        index = unusedIndices.pop();
 
         EventSystem<Tape>::notifyIndexAssignListeners(index);
 
@@ -195,12 +200,8 @@ namespace codi {
 
           EventSystem<Tape>::notifyIndexFreeListeners(index);
 
-          if (usedIndicesPos == usedIndices.size()) {
-            increaseIndicesSize(usedIndices);
-          }
-
-          usedIndices[usedIndicesPos] = index;
-          usedIndicesPos += 1;
+          usedIndices.push(index);
+          cast().checkUsedIndices();
 
           index = Base::InactiveIndex;
         }
@@ -208,53 +209,24 @@ namespace codi {
 
       /// \copydoc codi::IndexManagerInterface::reset
       CODI_INLINE void reset() {
-        size_t totalSize = usedIndicesPos + unusedIndicesPos;
-        if (totalSize > unusedIndices.size()) {
-          increaseIndicesSizeTo(unusedIndices, totalSize);
-        }
-
-        for (size_t pos = 0; pos < usedIndicesPos; ++pos) {
-          unusedIndices[unusedIndicesPos + pos] = usedIndices[pos];
-        }
-        unusedIndicesPos = totalSize;
-        usedIndicesPos = 0;
-
-        if (Config::SortIndicesOnReset) {
-          if (totalSize == unusedIndices.size()) {
-            std::sort(unusedIndices.begin(), unusedIndices.end());
-          } else {
-            std::sort(&unusedIndices[0], &unusedIndices[unusedIndicesPos]);
-          }
-        }
+        unusedIndices.mergeOnReset(usedIndices);
       }
 
       /// \copydoc codi::IndexManagerInterface::addToTapeValues <br><br>
-      /// Implementation: Adds indices stored, memory used, memory allocated.
+      /// Implementation: Adds reuse policy, indices stored, memory used, memory allocated.
       void addToTapeValues(TapeValues& values) const {
-        unsigned long storedIndices = this->usedIndicesPos + this->unusedIndicesPos;
-        unsigned long allocatedIndices = this->usedIndices.size() + this->unusedIndices.size();
+        unsigned long storedIndices = this->usedIndices.size() + this->unusedIndices.size();
 
-        double memoryStoredIndices = (double)storedIndices * (double)(sizeof(Index));
-        double memoryAllocatedIndices = (double)allocatedIndices * (double)(sizeof(Index));
+        double memoryStoredIndices = this->usedIndices.getMemoryUsed() + this->unusedIndices.getMemoryUsed();
+        double memoryAllocatedIndices =
+            this->usedIndices.getMemoryAllocated() + this->unusedIndices.getMemoryAllocated();
 
+        values.addStringEntry("Reuse policy", ReusePolicy::getName());
         values.addUnsignedLongEntry("Indices stored", storedIndices);
         values.addDoubleEntry("Memory used", memoryStoredIndices, true, false);
         values.addDoubleEntry("Memory allocated", memoryAllocatedIndices, false, true);
       }
 
       /// @}
-
-    private:
-
-      CODI_NO_INLINE void increaseIndicesSize(std::vector<Index>& v) {
-        v.resize(v.size() + indexSizeIncrement);
-      }
-
-      CODI_NO_INLINE void increaseIndicesSizeTo(std::vector<Index>& v, size_t minimalSize) {
-        codiAssert(v.size() < minimalSize);
-
-        size_t increaseMul = (minimalSize - v.size()) / indexSizeIncrement + 1;  // +1 always rounds up.
-        v.resize(v.size() + increaseMul * indexSizeIncrement);
-      }
   };
 }
@@ -141,6 +141,11 @@ namespace codi {
       using StatementData = typename TapeTypes::StatementData;  ///< See JacobianTapeTypes.
       using JacobianData = typename TapeTypes::JacobianData;    ///< See JacobianTapeTypes.
 
+      /// Access to the Jacobians in the Jacobian data, a plain pointer unless the data uses a packed layout.
+      using JacobianPointer = typename JacobianData::Chunk::Pointer1;
+      /// Access to the argument identifiers in the Jacobian data, a plain pointer unless the data uses a packed layout.
+      using RhsIdentifierPointer = typename JacobianData::Chunk::Pointer2;
+
       using Adjoints = typename TapeTypes::template Adjoints<Impl>;  ///< See JacobianTapeTypes.
 
       using PassiveReal = RealTraits::PassiveReal<Real>;  ///< Basic computation type.
@@ -377,15 +382,14 @@ namespace codi {
             cast().pushStmtData(lhs.cast().getIdentifier(), (Config::ArgumentSize)numberOfArguments);
 
             if (Config::StatementEvents) {
-              Real* jacobians;
-              Identifier* rhsIdentifiers;
+              JacobianPointer jacobians;
+              RhsIdentifierPointer rhsIdentifiers;
               jacobianData.getDataPointers(jacobians, rhsIdentifiers);
               jacobians -= numberOfArguments;
               rhsIdentifiers -= numberOfArguments;
 
-              EventSystem<Impl>::notifyStatementStoreOnTapeListeners(cast(), lhs.cast().getIdentifier(),
-                                                                     rhs.cast().getValue(), numberOfArguments,
-                                                                     rhsIdentifiers, jacobians);
+              notifyStatementStore(lhs.cast().getIdentifier(), rhs.cast().getValue(), numberOfArguments, jacobians,
+                                   rhsIdentifiers);
             }
           } else {
             indexManager.get().template freeIndex<Impl>(lhs.cast().getIdentifier());
@@ -497,6 +501,7 @@ namespace codi {
         values.addSection("Adjoint vector");
         values.addUnsignedLongEntry("Number of adjoints", nAdjoints);
         values.addDoubleEntry("Memory allocated", memoryAdjoints, true, true);
+        adjoints.addToTapeValues(values);
 
         values.addSection("Index manager");
         indexManager.get().addToTapeValues(values);
@@ -515,17 +520,28 @@ namespace codi {
 
     protected:
 
+      /// Prefetch the adjoint of the identifier that is accessed Config::ReversePrefetchDistance entries after the
+      /// current position in a reverse evaluation. The identifiers are stored in reverse order of the evaluation.
+      template<typename Adjoint, typename Identifiers>
+      CODI_INLINE static void prefetchAdjoint(Adjoint* adjointVector, Identifiers const& identifiers,
+                                              size_t const& curPos) {
+        if (0 != Config::ReversePrefetchDistance && Config::ReversePrefetchDistance <= curPos) {
+          CODI_PREFETCH_WRITE(&adjointVector[identifiers[curPos - Config::ReversePrefetchDistance]]);
+        }
+      }
+
       /// Performs the AD \ref sec_reverseAD "reverse" equation for a statement.
       template<typename Adjoint>
       CODI_INLINE static void incrementAdjoints(Adjoint* adjointVector, Adjoint const& lhsAdjoint,
                                                 Config::ArgumentSize const& numberOfArguments, size_t& curJacobianPos,
-                                                Real const* const rhsJacobians,
-                                                Identifier const* const rhsIdentifiers) {
+                                                JacobianPointer const& rhsJacobians,
+                                                RhsIdentifierPointer const& rhsIdentifiers) {
         size_t endJacobianPos = curJacobianPos - numberOfArguments;
 
         if (CODI_ENABLE_CHECK(Config::SkipZeroAdjointEvaluation, !RealTraits::isTotalZero(lhsAdjoint))) CODI_Likely {
           while (endJacobianPos < curJacobianPos) CODI_Likely {
             curJacobianPos -= 1;
+            prefetchAdjoint(adjointVector, rhsIdentifiers, curJacobianPos);
             adjointVector[rhsIdentifiers[curJacobianPos]] += rhsJacobians[curJacobianPos] * lhsAdjoint;
           }
         } else CODI_Unlikely {
@@ -541,8 +557,8 @@ namespace codi {
       template<typename Adjoint>
       CODI_INLINE static void incrementTangents(Adjoint const* const adjointVector, Adjoint& lhsAdjoint,
                                                 Config::ArgumentSize const& numberOfArguments, size_t& curJacobianPos,
-                                                Real const* const rhsJacobians,
-                                                Identifier const* const rhsIdentifiers) {
+                                                JacobianPointer const& rhsJacobians,
+                                                RhsIdentifierPointer const& rhsIdentifiers) {
         size_t endJacobianPos = curJacobianPos + numberOfArguments;
 
         while (curJacobianPos < endJacobianPos) CODI_Likely {
@@ -737,15 +753,14 @@ namespace codi {
         if (Config::StatementEvents) {
           if (this->manualPushCounter == this->manualPushGoal) {
             // emit statement event
-            Real* jacobians;
-            Identifier* rhsIdentifiers;
+            JacobianPointer jacobians;
+            RhsIdentifierPointer rhsIdentifiers;
             jacobianData.getDataPointers(jacobians, rhsIdentifiers);
             jacobians -= this->manualPushGoal;
             rhsIdentifiers -= this->manualPushGoal;
 
-            EventSystem<Impl>::notifyStatementStoreOnTapeListeners(cast(), this->manualPushLhsIdentifier,
-                                                                   this->manualPushLhsValue, this->manualPushGoal,
-                                                                   rhsIdentifiers, jacobians);
+            notifyStatementStore(this->manualPushLhsIdentifier, this->manualPushLhsValue, this->manualPushGoal,
+                                 jacobians, rhsIdentifiers);
           }
         }
       }
@@ -869,5 +884,27 @@ namespace codi {
         // overallocate as next multiple of Config::ChunkSize
         adjoints.resize(getNextMultiple((size_t)indexManager.get().getLargestCreatedIndex() + 1, Config::ChunkSize));
       }
+
+      /// Plain pointers are passed to the listeners directly.
+      CODI_INLINE void notifyStatementStore(Identifier const& lhsIdentifier, Real const& lhsValue,
+                                            size_t numberOfArguments, Real* jacobians, Identifier* rhsIdentifiers) {
+        EventSystem<Impl>::notifyStatementStoreOnTapeListeners(cast(), lhsIdentifier, lhsValue, numberOfArguments,
+                                                               rhsIdentifiers, jacobians);
+      }
+
+      /// Packed data is copied to plain arrays for the listeners.
+      template<typename Jacobians, typename RhsIdentifiers>
+      CODI_INLINE void notifyStatementStore(Identifier const& lhsIdentifier, Real const& lhsValue,
+                                            size_t numberOfArguments, Jacobians const& jacobians,
+                                            RhsIdentifiers const& rhsIdentifiers) {
+        Real jacobianArray[Config::MaxArgumentSize];
+        Identifier identifierArray[Config::MaxArgumentSize];
+        for (size_t i = 0; i < numberOfArguments; i += 1) {
+          jacobianArray[i] = jacobians[i];
+          identifierArray[i] = rhsIdentifiers[i];
+        }
+
+        notifyStatementStore(lhsIdentifier, lhsValue, numberOfArguments, jacobianArray, identifierArray);
+      }
   };
 }
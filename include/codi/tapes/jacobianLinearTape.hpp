@@ -75,6 +75,9 @@ namespace codi {
       using Identifier = typename TapeTypes::Identifier;      ///< See TapeTypesInterface.
       using Position = typename Base::Position;               ///< See TapeTypesInterface.
 
+      using JacobianPointer = typename Base::JacobianPointer;            ///< See JacobianBaseTape.
+      using RhsIdentifierPointer = typename Base::RhsIdentifierPointer;  ///< See JacobianBaseTape.
+
       CODI_STATIC_ASSERT(IndexManager::IsLinear, "This class requires an index manager with a linear scheme.");
 
       /// Constructor
@@ -93,8 +96,8 @@ namespace codi {
         IndexPosition startIndex = this->llfByteData.template extractPosition<IndexPosition>(start);
         IndexPosition endIndex = this->llfByteData.template extractPosition<IndexPosition>(end);
 
-        startIndex = std::min(startIndex, (IndexPosition)this->adjoints.size() - 1);
-        endIndex = std::min(endIndex, (IndexPosition)this->adjoints.size() - 1);
+        startIndex = std::min<IndexPosition>(startIndex, (IndexPosition)this->adjoints.size() - 1);
+        endIndex = std::min<IndexPosition>(endIndex, (IndexPosition)this->adjoints.size() - 1);
 
         for (IndexPosition curPos = endIndex + 1; curPos <= startIndex; curPos += 1) {
           this->adjoints[curPos] = Gradient();
@@ -105,6 +108,22 @@ namespace codi {
         }
       }
 
+      /**
+       * @brief Call the function for all statements between start and end in the order of the recording.
+       *
+       * The signature is func(lhsIdentifier, numberOfArguments, jacobians, rhsIdentifiers, argumentPos). The
+       * arguments of the statement are jacobians[argumentPos + i] and rhsIdentifiers[argumentPos + i] for i <
+       * numberOfArguments. Inputs and low level functions are reported with Config::StatementInputTag and
+       * Config::StatementLowLevelFunctionTag as the number of arguments.
+       *
+       * Used for analyses of the tape structure, e.g. OpenMPWavefrontEvaluator.
+       */
+      template<typename Func>
+      void iterateStatements(Position const& start, Position const& end, Func& func) {
+        Base::llfByteData.evaluateForward(start, end, JacobianLinearTape::template internalIterateStatements<Func>,
+                                          &func);
+      }
+
     protected:
 
       /// \copydoc codi::JacobianBaseTape::pushStmtData <br><br>
@@ -126,8 +145,8 @@ namespace codi {
           size_t& curLLFInfoDataPos, size_t const& endLLFInfoDataPos, Config::LowLevelFunctionToken* const tokenPtr,
           Config::LowLevelFunctionDataSize* const dataSizePtr,
           /* data from jacobian vector */
-          size_t& curJacobianPos, size_t const& endJacobianPos, Real const* const rhsJacobians,
-          Identifier const* const rhsIdentifiers,
+          size_t& curJacobianPos, size_t const& endJacobianPos, JacobianPointer const& rhsJacobians,
+          RhsIdentifierPointer const& rhsIdentifiers,
           /* data from statement vector */
           size_t& curStmtPos, size_t const& endStmtPos, Config::ArgumentSize const* const numberOfJacobians,
           /* data from index handler */
@@ -172,8 +191,8 @@ namespace codi {
           size_t& curLLFInfoDataPos, size_t const& endLLFInfoDataPos, Config::LowLevelFunctionToken* const tokenPtr,
           Config::LowLevelFunctionDataSize* const dataSizePtr,
           /* data from jacobianData */
-          size_t& curJacobianPos, size_t const& endJacobianPos, Real const* const rhsJacobians,
-          Identifier const* const rhsIdentifiers,
+          size_t& curJacobianPos, size_t const& endJacobianPos, JacobianPointer const& rhsJacobians,
+          RhsIdentifierPointer const& rhsIdentifiers,
           /* data from statementData */
           size_t& curStmtPos, size_t const& endStmtPos, Config::ArgumentSize const* const numberOfJacobians,
           /* data from index handler */
@@ -196,6 +215,10 @@ namespace codi {
           } else CODI_Likely {
             // No input value, perform regular statement evaluation.
 
+            if (0 != Config::ReversePrefetchDistance && Config::ReversePrefetchDistance <= curAdjointPos) {
+              CODI_PREFETCH_WRITE(&adjointVector[curAdjointPos - Config::ReversePrefetchDistance]);
+            }
+
             Adjoint const lhsAdjoint = adjointVector[curAdjointPos];  // We do not use the zero index, decrement of
                                                                       // curAdjointPos at the end of the loop.
 
@@ -212,5 +235,44 @@ namespace codi {
           curAdjointPos -= 1;
         }
       }
+
+    private:
+
+      template<typename Func>
+      static CODI_INLINE void internalIterateStatements(
+          /* data from call */
+          Func* func,
+          /* data from low level function byte data vector */
+          size_t& curLLFByteDataPos, size_t const& endLLFByteDataPos, char* dataPtr,
+          /* data from low level function info data vector */
+          size_t& curLLFInfoDataPos, size_t const& endLLFInfoDataPos, Config::LowLevelFunctionToken* const tokenPtr,
+          Config::LowLevelFunctionDataSize* const dataSizePtr,
+          /* data from jacobian vector */
+          size_t& curJacobianPos, size_t const& endJacobianPos, JacobianPointer const& rhsJacobians,
+          RhsIdentifierPointer const& rhsIdentifiers,
+          /* data from statement vector */
+          size_t& curStmtPos, size_t const& endStmtPos, Config::ArgumentSize const* const numberOfJacobians,
+          /* data from index handler */
+          size_t const& startAdjointPos, size_t const& endAdjointPos) {
+        CODI_UNUSED(endLLFByteDataPos, dataPtr, endLLFInfoDataPos, tokenPtr, endJacobianPos, endStmtPos);
+
+        size_t curAdjointPos = startAdjointPos;
+
+        while (curAdjointPos < endAdjointPos) {
+          curAdjointPos += 1;
+
+          Config::ArgumentSize const argsSize = numberOfJacobians[curStmtPos];
+          (*func)((Identifier)curAdjointPos, argsSize, rhsJacobians, rhsIdentifiers, curJacobianPos);
+
+          if (Config::StatementLowLevelFunctionTag == argsSize) {
+            curLLFByteDataPos += dataSizePtr[curLLFInfoDataPos];
+            curLLFInfoDataPos += 1;
+          } else if (Config::StatementInputTag != argsSize) {
+            curJacobianPos += argsSize;
+          }
+
+          curStmtPos += 1;
+        }
+      }
   };
 }
@@ -36,6 +36,7 @@
 
 #include <algorithm>
 #include <type_traits>
+#include <vector>
 
 #include "../config.h"
 #include "../expressions/lhsExpressionInterface.hpp"
@@ -79,6 +80,9 @@ namespace codi {
       using Position = typename Base::Position;                 ///< See TapeTypesInterface.
       using StatementData = typename TapeTypes::StatementData;  ///< See JacobianTapeTypes.
 
+      using JacobianPointer = typename Base::JacobianPointer;            ///< See JacobianBaseTape.
+      using RhsIdentifierPointer = typename Base::RhsIdentifierPointer;  ///< See JacobianBaseTape.
+
       CODI_STATIC_ASSERT(!IndexManager::IsLinear, "This class requires an index manager with a reuse scheme.");
 
       /// Constructor
@@ -120,6 +124,22 @@ namespace codi {
 
       /// @}
 
+      /**
+       * @brief Call the function for all statements between start and end in the order of the recording.
+       *
+       * The signature is func(lhsIdentifier, numberOfArguments, jacobians, rhsIdentifiers, argumentPos). The
+       * arguments of the statement are jacobians[argumentPos + i] and rhsIdentifiers[argumentPos + i] for i <
+       * numberOfArguments. Low level functions are reported with Config::StatementLowLevelFunctionTag as the number of
+       * arguments.
+       *
+       * Used for analyses of the tape structure, e.g. the vertex elimination in PreaccumulationHelper.
+       */
+      template<typename Func>
+      void iterateStatements(Position const& start, Position const& end, Func& func) {
+        this->llfByteData.evaluateForward(start, end, JacobianReuseTape::template internalIterateStatements<Func>,
+                                          &func);
+      }
+
     protected:
 
       /*******************************************************************************/
@@ -143,8 +163,8 @@ namespace codi {
           size_t& curLLFInfoDataPos, size_t const& endLLFInfoDataPos, Config::LowLevelFunctionToken* const tokenPtr,
           Config::LowLevelFunctionDataSize* const dataSizePtr,
           /* data from jacobian vector */
-          size_t& curJacobianPos, size_t const& endJacobianPos, Real const* const rhsJacobians,
-          Identifier const* const rhsIdentifiers,
+          size_t& curJacobianPos, size_t const& endJacobianPos, JacobianPointer const& rhsJacobians,
+          RhsIdentifierPointer const& rhsIdentifiers,
           /* data from statement vector */
           size_t& curStmtPos, size_t const& endStmtPos, Identifier const* const lhsIdentifiers,
           Config::ArgumentSize const* const numberOfJacobians) {
@@ -184,8 +204,8 @@ namespace codi {
           size_t& curLLFInfoDataPos, size_t const& endLLFInfoDataPos, Config::LowLevelFunctionToken* const tokenPtr,
           Config::LowLevelFunctionDataSize* const dataSizePtr,
           /* data from jacobianData */
-          size_t& curJacobianPos, size_t const& endJacobianPos, Real const* const rhsJacobians,
-          Identifier const* const rhsIdentifiers,
+          size_t& curJacobianPos, size_t const& endJacobianPos, JacobianPointer const& rhsJacobians,
+          RhsIdentifierPointer const& rhsIdentifiers,
           /* data from statementData */
           size_t& curStmtPos, size_t const& endStmtPos, Identifier const* const lhsIdentifiers,
           Config::ArgumentSize const* const numberOfJacobians) {
@@ -202,6 +222,8 @@ namespace codi {
             Base::template callLowLevelFunction<LowLevelFunctionEntryCallKind::Reverse>(
                 tape, false, curLLFByteDataPos, dataPtr, curLLFInfoDataPos, tokenPtr, dataSizePtr, &vectorAccess);
           } else CODI_Likely {
+            Base::prefetchAdjoint(adjointVector, lhsIdentifiers, curStmtPos);
+
             Adjoint const lhsAdjoint = adjointVector[lhsIdentifiers[curStmtPos]];
 
             EventSystem<JacobianReuseTape>::notifyStatementEvaluateListeners(
@@ -249,9 +271,191 @@ namespace codi {
       }
 
       /// @}
+      /*******************************************************************************/
+      /// @name Identifier compaction
+      /// @{
+
+      /// False if the tape contains low level functions, see compactIdentifiers.
+      bool canCompactIdentifiers() const {
+        return 0 == this->llfInfoData.getDataSize();
+      }
+
+      /**
+       * @brief Renumber all identifiers densely in the order of their first use in the reverse sweep.
+       *
+       * After a long recording with many freed and reused identifiers, the identifiers on the tape are scattered over
+       * the range of all identifiers that were ever created. This method renumbers the identifiers on the tape and
+       * the ones in liveIdentifiers to 1, 2, ..., n. The adjoint vector is shrunk to the new size and its values are
+       * moved to the new identifiers. A reverse evaluation then accesses the adjoint vector mostly sequentially.
+       *
+       * The index manager does not know which identifiers are held by active variables. All active variables have to
+       * be given in liveIdentifiers, e.g., the inputs and outputs. Otherwise, the identifiers of the missing variables
+       * would become invalid and their destruction would free identifiers that are reused. Therefore, the number of
+       * given variables is checked against the references counted by the index manager before anything is modified.
+       * liveIdentifiers may contain the same pointer more than once.
+       *
+       * Only tapes without low level functions, e.g. external functions, can be compacted since their data can
+       * contain identifiers. The identifiers are rewritten in place, which requires ChunkedData for the Jacobian and
+       * statement data. The index manager needs to provide getNumberOfLiveReferences() and renumberIndices(), see
+       * ReuseIndexManager.
+       *
+       * @param liveIdentifiers  Pointers to the identifiers of all active variables that remain in use, for example
+       *                         &x.getIdentifier().
+       */
+      void compactIdentifiers(std::vector<Identifier*> const& liveIdentifiers) {
+        CODI_STATIC_ASSERT(IsChunkedData<typename Base::JacobianData>::value && IsChunkedData<StatementData>::value,
+                           "Identifier compaction modifies the data in place, this requires ChunkedData.");
+        codiAssert(!this->isActive());
+
+        if (!canCompactIdentifiers()) {
+          CODI_EXCEPTION("Identifier compaction does not support tapes with low level functions.");
+          return;
+        }
+
+        size_t const liveReferences = countLiveReferences(liveIdentifiers);
+        size_t const expectedReferences = this->indexManager.get().getNumberOfLiveReferences();
+        if (liveReferences != expectedReferences) {
+          CODI_EXCEPTION("Identifier compaction requires all live variables, %d of %d were given.", (int)liveReferences,
+                         (int)expectedReferences);
+          return;
+        }
+
+        IdentifierRenumbering renumbering((size_t)this->indexManager.get().getLargestCreatedIndex() + 1);
+        this->llfByteData.evaluateReverse(this->getPosition(), this->getZeroPosition(),
+                                          JacobianReuseTape::internalCompactIdentifiers, &renumbering);
+
+        for (Identifier* identifier : liveIdentifiers) {
+          renumbering.renumber(*identifier);
+        }
+
+        // Move the adjoint values to the new identifiers.
+        Identifier const newSize = renumbering.largestIdentifier + 1;
+        typename Base::Adjoints newAdjoints((size_t)newSize);
+        Identifier const oldSize =
+            (Identifier)std::min(this->adjoints.size(), renumbering.newIdentifiers.size());
+        for (Identifier identifier = 1; identifier < oldSize; identifier += 1) {
+          Identifier const newIdentifier = renumbering.newIdentifiers[identifier];
+          if (IndexManager::InactiveIndex != newIdentifier) {
+            newAdjoints[newIdentifier] = this->adjoints[identifier];
+          }
+        }
+        this->adjoints.swap(newAdjoints);
+
+        this->indexManager.get().renumberIndices(renumbering.newIdentifiers, renumbering.largestIdentifier);
+      }
+
+      /// @}
 
     private:
 
+      /// Number of distinct variables with an active identifier.
+      static size_t countLiveReferences(std::vector<Identifier*> const& liveIdentifiers) {
+        std::vector<Identifier*> variables(liveIdentifiers);
+        std::sort(variables.begin(), variables.end());
+        variables.erase(std::unique(variables.begin(), variables.end()), variables.end());
+
+        size_t references = 0;
+        for (Identifier* identifier : variables) {
+          if (IndexManager::InactiveIndex != *identifier) {
+            references += 1;
+          }
+        }
+
+        return references;
+      }
+
+      /// Assigns new identifiers in the order of first occurrence.
+      struct IdentifierRenumbering {
+        public:
+
+          std::vector<Identifier> newIdentifiers;  ///< InactiveIndex if no new identifier was assigned.
+          Identifier largestIdentifier;            ///< Largest new identifier.
+
+          /// Constructor
+          explicit IdentifierRenumbering(size_t size)
+              : newIdentifiers(size, IndexManager::InactiveIndex), largestIdentifier(IndexManager::InactiveIndex) {}
+
+          /// Replace identifier by its new identifier. Assigns a new one on first occurrence.
+          CODI_INLINE void renumber(Identifier& identifier) {
+            if (IndexManager::InactiveIndex != identifier) {
+              Identifier& newIdentifier = newIdentifiers[identifier];
+              if (IndexManager::InactiveIndex == newIdentifier) {
+                largestIdentifier += 1;
+                newIdentifier = largestIdentifier;
+              }
+              identifier = newIdentifier;
+            }
+          }
+      };
+
+      static CODI_INLINE void internalCompactIdentifiers(
+          /* data from call */
+          IdentifierRenumbering* renumbering,
+          /* data from low level function byte data vector */
+          size_t& curLLFByteDataPos, size_t const& endLLFByteDataPos, char* dataPtr,
+          /* data from low level function info data vector */
+          size_t& curLLFInfoDataPos, size_t const& endLLFInfoDataPos, Config::LowLevelFunctionToken* const tokenPtr,
+          Config::LowLevelFunctionDataSize* const dataSizePtr,
+          /* data from jacobianData */
+          size_t& curJacobianPos, size_t const& endJacobianPos, JacobianPointer const& rhsJacobians,
+          RhsIdentifierPointer const& rhsIdentifiers,
+          /* data from statementData */
+          size_t& curStmtPos, size_t const& endStmtPos, Identifier const* const lhsIdentifiers,
+          Config::ArgumentSize const* const numberOfJacobians) {
+        CODI_UNUSED(curLLFByteDataPos, endLLFByteDataPos, dataPtr, curLLFInfoDataPos, endLLFInfoDataPos, tokenPtr,
+                    dataSizePtr, endJacobianPos, rhsJacobians);
+
+        // The data pointers are const because they are usually only read.
+        Identifier* mutableLhsIdentifiers = const_cast<Identifier*>(lhsIdentifiers);
+
+        while (curStmtPos > endStmtPos) {
+          curStmtPos -= 1;
+
+          Config::ArgumentSize const argsSize = numberOfJacobians[curStmtPos];
+          codiAssert(Config::StatementLowLevelFunctionTag != argsSize);
+
+          renumbering->renumber(mutableLhsIdentifiers[curStmtPos]);
+
+          size_t const jacobianStart = curJacobianPos - argsSize;
+          while (curJacobianPos > jacobianStart) {
+            curJacobianPos -= 1;
+            renumbering->renumber(rhsIdentifiers[curJacobianPos]);
+          }
+        }
+      }
+
+      template<typename Func>
+      static CODI_INLINE void internalIterateStatements(
+          /* data from call */
+          Func* func,
+          /* data from low level function byte data vector */
+          size_t& curLLFByteDataPos, size_t const& endLLFByteDataPos, char* dataPtr,
+          /* data from low level function info data vector */
+          size_t& curLLFInfoDataPos, size_t const& endLLFInfoDataPos, Config::LowLevelFunctionToken* const tokenPtr,
+          Config::LowLevelFunctionDataSize* const dataSizePtr,
+          /* data from jacobianData */
+          size_t& curJacobianPos, size_t const& endJacobianPos, JacobianPointer const& rhsJacobians,
+          RhsIdentifierPointer const& rhsIdentifiers,
+          /* data from statementData */
+          size_t& curStmtPos, size_t const& endStmtPos, Identifier const* const lhsIdentifiers,
+          Config::ArgumentSize const* const numberOfJacobians) {
+        CODI_UNUSED(endLLFByteDataPos, dataPtr, endLLFInfoDataPos, tokenPtr, endJacobianPos);
+
+        while (curStmtPos < endStmtPos) {
+          Config::ArgumentSize const argsSize = numberOfJacobians[curStmtPos];
+          (*func)(lhsIdentifiers[curStmtPos], argsSize, rhsJacobians, rhsIdentifiers, curJacobianPos);
+
+          if (Config::StatementLowLevelFunctionTag == argsSize) {
+            curLLFByteDataPos += dataSizePtr[curLLFInfoDataPos];
+            curLLFInfoDataPos += 1;
+          } else {
+            curJacobianPos += argsSize;
+          }
+
+          curStmtPos += 1;
+        }
+      }
+
       static CODI_INLINE void internalAppend(
           /* data from call */
           JacobianReuseTape* dstTape,
@@ -261,8 +465,8 @@ namespace codi {
           size_t& curLLFInfoDataPos, size_t const& endLLFInfoDataPos, Config::LowLevelFunctionToken* const tokenPtr,
           Config::LowLevelFunctionDataSize* const dataSizePtr,
           /* data from jacobianData */
-          size_t& curJacobianPos, size_t const& endJacobianPos, Real const* const rhsJacobians,
-          Identifier const* const rhsIdentifiers,
+          size_t& curJacobianPos, size_t const& endJacobianPos, JacobianPointer const& rhsJacobians,
+          RhsIdentifierPointer const& rhsIdentifiers,
           /* data from statementData */
           size_t& curStmtPos, size_t const& endStmtPos, Identifier const* const lhsIdentifiers,
           Config::ArgumentSize const* const numberOfJacobians) {
@@ -36,6 +36,7 @@
 
 #include "../../misc/macros.hpp"
 #include "../interfaces/fullTapeInterface.hpp"
+#include "tapeValues.hpp"
 
 /** \copydoc codi::Namespace */
 namespace codi {
@@ -118,6 +119,9 @@ namespace codi {
 
       /// Declare that the adjoints are no longer occupied.
       CODI_INLINE void endUse();
+
+      /// Add the settings of the adjoint implementation, e.g., the allocation policy.
+      void addToTapeValues(TapeValues& values) const;
   };
 
 }
@@ -37,35 +37,44 @@
 #include <algorithm>
 #include <vector>
 
+#include "../data/allocationPolicies.hpp"
 #include "internalAdjointsInterface.hpp"
+#include "tapeValues.hpp"
 
 /** \copydoc codi::Namespace */
 namespace codi {
 
   /**
-   * @brief Adjoint variables owned by a tape instance.
+   * @brief Adjoint variables owned by a tape instance, allocated with an allocation policy.
    *
-   * @tparam T_Gradient    The gradient type of a tape, usually chosen as ActiveType::Gradient.
-   * @tparam T_Identifier  The adjoint/tangent identification of a tape, usually chosen as ActiveType::Identifier.
-   * @tparam T_Tape        The associated tape type.
+   * Tape type definitions expect adjoints with three template parameters. LocalAdjoints uses the default policy,
+   * aliases like HugePageLocalAdjoints select other policies.
+   *
+   * @tparam T_Gradient          The gradient type of a tape, usually chosen as ActiveType::Gradient.
+   * @tparam T_Identifier        The adjoint/tangent identification of a tape, usually chosen as ActiveType::Identifier.
+   * @tparam T_Tape              The associated tape type.
+   * @tparam T_AllocationPolicy  Memory of the adjoint vector. See DefaultAllocationPolicy.
    */
-  template<typename T_Gradient, typename T_Identifier, typename T_Tape>
-  struct LocalAdjoints : public InternalAdjointsInterface<T_Gradient, T_Identifier, T_Tape> {
+  template<typename T_Gradient, typename T_Identifier, typename T_Tape,
+           typename T_AllocationPolicy = DefaultAllocationPolicy>
+  struct LocalAdjointsWithPolicy : public InternalAdjointsInterface<T_Gradient, T_Identifier, T_Tape> {
     public:
 
-      using Tape = CODI_DD(T_Tape,
-                           CODI_T(FullTapeInterface<double, double, int, EmptyPosition>));  ///< See LocalAdjoints.
-      using Gradient = CODI_DD(T_Gradient, double);                                         ///< See LocalAdjoints.
-      using Identifier = CODI_DD(T_Identifier, int);                                        ///< See LocalAdjoints.
+      /// See LocalAdjointsWithPolicy.
+      using Tape = CODI_DD(T_Tape, CODI_T(FullTapeInterface<double, double, int, EmptyPosition>));
+      using Gradient = CODI_DD(T_Gradient, double);   ///< See LocalAdjointsWithPolicy.
+      using Identifier = CODI_DD(T_Identifier, int);   ///< See LocalAdjointsWithPolicy.
+      /// See LocalAdjointsWithPolicy.
+      using AllocationPolicy = CODI_DD(T_AllocationPolicy, DefaultAllocationPolicy);
 
     private:
 
-      std::vector<Gradient> adjoints;  ///< Vector of adjoint variables.
+      std::vector<Gradient, PolicyAllocator<Gradient, AllocationPolicy>> adjoints;  ///< Vector of adjoint variables.
 
     public:
 
       /// Constructor
-      LocalAdjoints(size_t initialSize)
+      LocalAdjointsWithPolicy(size_t initialSize)
           : InternalAdjointsInterface<Gradient, Identifier, Tape>(initialSize), adjoints(initialSize) {}
 
       /// \copydoc InternalAdjointsInterface::operator[](Identifier const&)
@@ -101,7 +110,7 @@ namespace codi {
       }
 
       /// \copydoc InternalAdjointsInterface::swap
-      CODI_INLINE void swap(LocalAdjoints& other) {
+      CODI_INLINE void swap(LocalAdjointsWithPolicy& other) {
         std::swap(adjoints, other.adjoints);
       }
 
@@ -110,5 +119,38 @@ namespace codi {
 
       /// \copydoc InternalAdjointsInterface::endUse
       CODI_INLINE void endUse() {}
+
+      /// \copydoc InternalAdjointsInterface::addToTapeValues
+      void addToTapeValues(TapeValues& values) const {
+        values.addStringEntry("Allocation policy", AllocationPolicy::getName());
+      }
   };
+
+  /**
+   * @brief Adjoint variables owned by a tape instance.
+   *
+   * LocalAdjointsWithPolicy with the DefaultAllocationPolicy.
+   *
+   * @tparam T_Gradient    The gradient type of a tape, usually chosen as ActiveType::Gradient.
+   * @tparam T_Identifier  The adjoint/tangent identification of a tape, usually chosen as ActiveType::Identifier.
+   * @tparam T_Tape        The associated tape type.
+   */
+  template<typename T_Gradient, typename T_Identifier, typename T_Tape>
+  struct LocalAdjoints : public LocalAdjointsWithPolicy<T_Gradient, T_Identifier, T_Tape, DefaultAllocationPolicy> {
+    public:
+
+      /// Base class abbreviation.
+      using Base = LocalAdjointsWithPolicy<T_Gradient, T_Identifier, T_Tape, DefaultAllocationPolicy>;
+
+      /// Constructor
+      LocalAdjoints(size_t initialSize) : Base(initialSize) {}
+  };
+
+  /// LocalAdjoints with 2 MB transparent huge pages.
+  template<typename Gradient, typename Identifier, typename Tape>
+  using HugePageLocalAdjoints = LocalAdjointsWithPolicy<Gradient, Identifier, Tape, TransparentHugePagePolicy>;
+
+  /// LocalAdjoints with pages interleaved over all NUMA nodes.
+  template<typename Gradient, typename Identifier, typename Tape>
+  using InterleavedLocalAdjoints = LocalAdjointsWithPolicy<Gradient, Identifier, Tape, InterleavedNumaPolicy>;
 }
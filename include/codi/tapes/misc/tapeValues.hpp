@@ -57,6 +57,7 @@ namespace codi {
    *   - addDoubleEntry(): Add a double entry. If this a memory entry, it can be added automatically to the global
    *                       counters. Memory is computed in MB.
    *   - addLongEntry(): Add a long entry.
+   *   - addStringEntry(): Add a string entry, e.g., for settings.
    *   - addUnsignedLongEntry(): Add unsigned long entry.
    *   - addSection(): Add a new section under which all following entries are added.
    *
@@ -75,7 +76,8 @@ namespace codi {
       enum class EntryType {
         Double,
         Long,
-        UnsignedLong
+        UnsignedLong,
+        String
       };
 
       struct Entry {
@@ -104,6 +106,7 @@ namespace codi {
       std::vector<double> doubleData;
       std::vector<long> longData;
       std::vector<unsigned long> unsignedLongData;
+      std::vector<std::string> stringData;
 
       size_t usedMemoryIndex;
       size_t allocatedMemoryIndex;
@@ -112,7 +115,13 @@ namespace codi {
 
       /// Constructor
       TapeValues(std::string const& tapeName)
-          : sections(), doubleData(), longData(), unsignedLongData(), usedMemoryIndex(0), allocatedMemoryIndex(1) {
+          : sections(),
+            doubleData(),
+            longData(),
+            unsignedLongData(),
+            stringData(),
+            usedMemoryIndex(0),
+            allocatedMemoryIndex(1) {
         addSection(tapeName);
         addEntryInternal("Total memory used", EntryType::Double, doubleData, 0.0);
         addEntryInternal("Total memory allocated", EntryType::Double, doubleData, 0.0);
@@ -146,6 +155,11 @@ namespace codi {
         sections.push_back(Section(name));
       }
 
+      /// Add string entry. String entries are not combined in combineData().
+      void addStringEntry(std::string const& name, std::string const& value) {
+        addEntryInternal(name, EntryType::String, stringData, value);
+      }
+
       /// Add unsigned long entry.
       void addUnsignedLongEntry(std::string const& name, unsigned long const& value) {
         addEntryInternal(name, EntryType::UnsignedLong, unsignedLongData, value);
@@ -283,6 +297,9 @@ namespace codi {
           case EntryType::UnsignedLong:
             ss << std::right << std::setw(maximumFieldSize) << unsignedLongData[entry.pos];
             break;
+          case EntryType::String:
+            ss << std::right << std::setw(maximumFieldSize) << stringData[entry.pos];
+            break;
           default:
             CODI_EXCEPTION("Unimplemented switch case.");
             break;
@@ -324,7 +341,10 @@ namespace codi {
         size_t maxLength = 0;
         for (Section const& section : sections) {
           for (Entry const& data : section.data) {
-            maxLength = std::max(maxLength, formatEntryLength(data));
+            // Strings do not determine the column width, they are usually longer than numbers.
+            if (EntryType::String != data.type) {
+              maxLength = std::max(maxLength, formatEntryLength(data));
+            }
           }
         }
 
@@ -35,7 +35,9 @@
 #pragma once
 
 #include "../../tools/parallel/parallelToolbox.hpp"
+#include "../data/allocationPolicies.hpp"
 #include "internalAdjointsInterface.hpp"
+#include "tapeValues.hpp"
 
 /** \copydoc codi::Namespace */
 namespace codi {
@@ -43,12 +45,14 @@ namespace codi {
   /**
    * @brief Provides global adjoint variables owned by a tape type. Thread-safe for use in parallel taping.
    *
-   * @tparam T_Gradient         The gradient type of a tape, usually chosen as ActiveType::Gradient.
-   * @tparam T_Identifier       The adjoint/tangent identification of a tape, usually chosen as ActiveType::Identifier.
-   * @tparam T_Tape             The associated tape type.
-   * @tparam T_ParallelToolbox  The parallel toolbox used in the associated tape. See codi::ParallelToolbox.
+   * @tparam T_Gradient          The gradient type of a tape, usually chosen as ActiveType::Gradient.
+   * @tparam T_Identifier        The adjoint/tangent identification of a tape, usually chosen as ActiveType::Identifier.
+   * @tparam T_Tape              The associated tape type.
+   * @tparam T_ParallelToolbox   The parallel toolbox used in the associated tape. See codi::ParallelToolbox.
+   * @tparam T_AllocationPolicy  Memory of the adjoint vector. See DefaultAllocationPolicy.
    */
-  template<typename T_Gradient, typename T_Identifier, typename T_Tape, typename T_ParallelToolbox>
+  template<typename T_Gradient, typename T_Identifier, typename T_Tape, typename T_ParallelToolbox,
+           typename T_AllocationPolicy = DefaultAllocationPolicy>
   struct ThreadSafeGlobalAdjoints : public InternalAdjointsInterface<T_Gradient, T_Identifier, T_Tape> {
     public:
 
@@ -58,6 +62,8 @@ namespace codi {
       using Identifier = CODI_DD(T_Identifier, int);  ///< See ThreadSafeGlobalAdjoints.
       /// See ThreadSafeGlobalAdjoints.
       using ParallelToolbox = CODI_DD(T_ParallelToolbox, CODI_DEFAULT_PARALLEL_TOOLBOX);
+      /// See ThreadSafeGlobalAdjoints.
+      using AllocationPolicy = CODI_DD(T_AllocationPolicy, DefaultAllocationPolicy);
 
       using ReadWriteMutex = typename ParallelToolbox::ReadWriteMutex;  ///< See ParallelToolbox.
       using LockForUse = typename ParallelToolbox::LockForRead;         ///< See ParallelToolbox.
@@ -65,7 +71,9 @@ namespace codi {
 
     private:
 
-      static std::vector<Gradient> adjoints;  ///< Vector of adjoint variables.
+      using AdjointVector = std::vector<Gradient, PolicyAllocator<Gradient, AllocationPolicy>>;
+
+      static AdjointVector adjoints;  ///< Vector of adjoint variables.
 
       /// @brief Protects adjoints.
       /// Read lock locks for using the adjoint vector. Write lock locks for reallocating it.
@@ -130,13 +138,18 @@ namespace codi {
       CODI_INLINE void endUse() {
         adjointsMutex.unlockRead();
       }
+
+      /// \copydoc InternalAdjointsInterface::addToTapeValues
+      void addToTapeValues(TapeValues& values) const {
+        values.addStringEntry("Allocation policy", AllocationPolicy::getName());
+      }
   };
 
-  template<typename Gradient, typename Identifier, typename Tape, typename ParallelToolbox>
-  std::vector<CODI_DD(Gradient, double)>
-      ThreadSafeGlobalAdjoints<Gradient, Identifier, Tape, ParallelToolbox>::adjoints(1);
+  template<typename Gradient, typename Identifier, typename Tape, typename ParallelToolbox, typename AllocationPolicy>
+  typename ThreadSafeGlobalAdjoints<Gradient, Identifier, Tape, ParallelToolbox, AllocationPolicy>::AdjointVector
+      ThreadSafeGlobalAdjoints<Gradient, Identifier, Tape, ParallelToolbox, AllocationPolicy>::adjoints(1);
 
-  template<typename Gradient, typename Identifier, typename Tape, typename ParallelToolbox>
+  template<typename Gradient, typename Identifier, typename Tape, typename ParallelToolbox, typename AllocationPolicy>
   typename CODI_DD(ParallelToolbox, CODI_DEFAULT_PARALLEL_TOOLBOX)::ReadWriteMutex
-      ThreadSafeGlobalAdjoints<Gradient, Identifier, Tape, ParallelToolbox>::adjointsMutex;
+      ThreadSafeGlobalAdjoints<Gradient, Identifier, Tape, ParallelToolbox, AllocationPolicy>::adjointsMutex;
 }
@@ -58,6 +58,9 @@ namespace codi {
    *
    * This class implements the interface methods from the PrimalValueBaseTape.
    *
+   * With Config::StatementRunEvaluation, consecutive statements with the same handle are evaluated with one call of
+   * the run functions of the statement evaluator.
+   *
    * @tparam T_TapeTypes  JacobianTapeTypes definition.
    */
   template<typename T_TapeTypes>
@@ -81,6 +84,10 @@ namespace codi {
       using EvalHandle = typename TapeTypes::EvalHandle;                  ///< See PrimalValueTapeTypes.
       using Position = typename Base::Position;                           ///< See TapeTypesInterface.
 
+      /// Shorter runs of statements with the same handle are evaluated statement by statement. For very short runs, the
+      /// call of the run function is more expensive than the individual handle calls.
+      static size_t constexpr MinimumStatementRunLength = 4;
+
       /// Constructor
       PrimalValueLinearTape() : Base() {}
 
@@ -97,8 +104,8 @@ namespace codi {
         IndexPosition startIndex = this->llfByteData.template extractPosition<IndexPosition>(start);
         IndexPosition endIndex = this->llfByteData.template extractPosition<IndexPosition>(end);
 
-        startIndex = std::min(startIndex, (IndexPosition)this->adjoints.size() - 1);
-        endIndex = std::min(endIndex, (IndexPosition)this->adjoints.size() - 1);
+        startIndex = std::min<IndexPosition>(startIndex, (IndexPosition)this->adjoints.size() - 1);
+        endIndex = std::min<IndexPosition>(endIndex, (IndexPosition)this->adjoints.size() - 1);
 
         for (IndexPosition curPos = endIndex + 1; curPos <= startIndex; curPos += 1) {
           this->adjoints[curPos] = Gradient();
@@ -153,24 +160,25 @@ namespace codi {
           } else if (Config::StatementInputTag == nPassiveValues) CODI_Unlikely {
             // Do nothing.
           } else CODI_Likely {
-            Gradient lhsTangent = Gradient();
-
-            primalVector[curAdjointPos] = StatementEvaluator::template callForward<PrimalValueLinearTape>(
-                stmtEvalhandle[curStatementPos], primalVector, adjointVector, lhsTangent, nPassiveValues,
-                curConstantPos, constantValues, curPassivePos, passiveValues, curRhsIdentifiersPos, rhsIdentifiers);
-
-#if CODI_VariableAdjointInterfaceInPrimalTapes
-            adjointVector->setLhsTangent(curAdjointPos);
-            EventSystem<PrimalValueLinearTape>::notifyStatementEvaluateListeners(
-                tape, curAdjointPos, adjointVector->getVectorSize(), adjointVector->getAdjointVec(curAdjointPos));
-#else
-            adjointVector[curAdjointPos] = lhsTangent;
-
-            EventSystem<PrimalValueLinearTape>::notifyStatementEvaluateListeners(
-                tape, curAdjointPos, GradientTraits::dim<Gradient>(), GradientTraits::toArray(lhsTangent).data());
-#endif
-            EventSystem<PrimalValueLinearTape>::notifyStatementEvaluatePrimalListeners(tape, curAdjointPos,
-                                                                                       primalVector[curAdjointPos]);
+            auto forwardRun =
+                StatementEvaluator::template getForwardRun<PrimalValueLinearTape>(stmtEvalhandle[curStatementPos]);
+
+            if (Config::StatementRunEvaluation && nullptr != forwardRun &&
+                isStatementRun<true>(curStatementPos, endAdjointPos - curAdjointPos + 1, numberOfPassiveArguments,
+                                     stmtEvalhandle)) {
+              // Copy the positions, the loop variables can then stay in registers.
+              StatementRunPositions runPos = {curAdjointPos, curStatementPos, curConstantPos, curPassivePos,
+                                              curRhsIdentifiersPos};
+              forwardRun(tape, primalVector, adjointVector, runPos, endAdjointPos, numberOfPassiveArguments,
+                         stmtEvalhandle, constantValues, passiveValues, rhsIdentifiers);
+              runPos.extract(curAdjointPos, curStatementPos, curConstantPos, curPassivePos, curRhsIdentifiersPos);
+            } else {
+              evaluateForwardStatement(tape, primalVector, adjointVector, curAdjointPos, [&](Gradient& lhsTangent) {
+                return StatementEvaluator::template callForward<PrimalValueLinearTape>(
+                    stmtEvalhandle[curStatementPos], primalVector, adjointVector, lhsTangent, nPassiveValues,
+                    curConstantPos, constantValues, curPassivePos, passiveValues, curRhsIdentifiersPos, rhsIdentifiers);
+              });
+            }
           }
 
           curStatementPos += 1;
@@ -273,29 +281,26 @@ namespace codi {
           } else if (Config::StatementInputTag == nPassiveValues) CODI_Unlikely {
             // Do nothing.
           } else CODI_Likely {
-#if CODI_VariableAdjointInterfaceInPrimalTapes
-
-            EventSystem<PrimalValueLinearTape>::notifyStatementEvaluateListeners(
-                tape, curAdjointPos, adjointVector->getVectorSize(), adjointVector->getAdjointVec(curAdjointPos));
-
-            Gradient const lhsAdjoint{};
-            adjointVector->setLhsAdjoint(curAdjointPos);
-#else
-            Gradient const lhsAdjoint = adjointVector[curAdjointPos];
-
-            EventSystem<PrimalValueLinearTape>::notifyStatementEvaluateListeners(
-                tape, curAdjointPos, GradientTraits::dim<Gradient>(), GradientTraits::toArray(lhsAdjoint).data());
-
-            if (Config::ReversalZeroesAdjoints) {
-              adjointVector[curAdjointPos] = Gradient();
+            auto reverseRun =
+                StatementEvaluator::template getReverseRun<PrimalValueLinearTape>(stmtEvalhandle[curStatementPos]);
+
+            if (Config::StatementRunEvaluation && nullptr != reverseRun &&
+                isStatementRun<false>(curStatementPos, curAdjointPos - endAdjointPos, numberOfPassiveArguments,
+                                      stmtEvalhandle)) {
+              // Copy the positions, the loop variables can then stay in registers.
+              StatementRunPositions runPos = {curAdjointPos, curStatementPos, curConstantPos, curPassivePos,
+                                              curRhsIdentifiersPos};
+              reverseRun(tape, primalVector, adjointVector, runPos, endAdjointPos, numberOfPassiveArguments,
+                         stmtEvalhandle, constantValues, passiveValues, rhsIdentifiers);
+              runPos.extract(curAdjointPos, curStatementPos, curConstantPos, curPassivePos, curRhsIdentifiersPos);
+            } else {
+              auto evalStatement = [&](Gradient const& lhsAdjoint) {
+                StatementEvaluator::template callReverse<PrimalValueLinearTape>(
+                    stmtEvalhandle[curStatementPos], primalVector, adjointVector, lhsAdjoint, nPassiveValues,
+                    curConstantPos, constantValues, curPassivePos, passiveValues, curRhsIdentifiersPos, rhsIdentifiers);
+              };
+              evaluateReverseStatement(tape, primalVector, adjointVector, curAdjointPos, evalStatement);
             }
-#endif
-            EventSystem<PrimalValueLinearTape>::notifyStatementEvaluatePrimalListeners(tape, curAdjointPos,
-                                                                                       primalVector[curAdjointPos]);
-
-            StatementEvaluator::template callReverse<PrimalValueLinearTape>(
-                stmtEvalhandle[curStatementPos], primalVector, adjointVector, lhsAdjoint, nPassiveValues,
-                curConstantPos, constantValues, curPassivePos, passiveValues, curRhsIdentifiersPos, rhsIdentifiers);
           }
 
           curAdjointPos -= 1;
@@ -319,7 +324,208 @@ namespace codi {
         Base::statementData.pushData(numberOfPassiveArguments, evalHandle);
       }
 
+    private:
+
+      /// Evaluate a statement in a forward mode and notify the listeners. `evalStatement(lhsTangent)` performs the
+      /// evaluation and returns the primal value.
+      template<typename Func>
+      CODI_INLINE static void evaluateForwardStatement(PrimalValueLinearTape& tape, Real* primalVector,
+                                                       ADJOINT_VECTOR_TYPE* adjointVector,
+                                                       size_t const& curAdjointPos, Func&& evalStatement) {
+        Gradient lhsTangent = Gradient();
+
+        primalVector[curAdjointPos] = evalStatement(lhsTangent);
+
+#if CODI_VariableAdjointInterfaceInPrimalTapes
+        adjointVector->setLhsTangent(curAdjointPos);
+        EventSystem<PrimalValueLinearTape>::notifyStatementEvaluateListeners(
+            tape, curAdjointPos, adjointVector->getVectorSize(), adjointVector->getAdjointVec(curAdjointPos));
+#else
+        adjointVector[curAdjointPos] = lhsTangent;
+
+        EventSystem<PrimalValueLinearTape>::notifyStatementEvaluateListeners(
+            tape, curAdjointPos, GradientTraits::dim<Gradient>(), GradientTraits::toArray(lhsTangent).data());
+#endif
+        EventSystem<PrimalValueLinearTape>::notifyStatementEvaluatePrimalListeners(tape, curAdjointPos,
+                                                                                   primalVector[curAdjointPos]);
+      }
+
+      /// Evaluate a statement in a reverse mode and notify the listeners. `evalStatement(lhsAdjoint)` performs the
+      /// evaluation.
+      template<typename Func>
+      CODI_INLINE static void evaluateReverseStatement(PrimalValueLinearTape& tape, Real* primalVector,
+                                                       ADJOINT_VECTOR_TYPE* adjointVector,
+                                                       size_t const& curAdjointPos, Func&& evalStatement) {
+#if CODI_VariableAdjointInterfaceInPrimalTapes
+
+        EventSystem<PrimalValueLinearTape>::notifyStatementEvaluateListeners(
+            tape, curAdjointPos, adjointVector->getVectorSize(), adjointVector->getAdjointVec(curAdjointPos));
+
+        Gradient const lhsAdjoint{};
+        adjointVector->setLhsAdjoint(curAdjointPos);
+#else
+        Gradient const lhsAdjoint = adjointVector[curAdjointPos];
+
+        EventSystem<PrimalValueLinearTape>::notifyStatementEvaluateListeners(
+            tape, curAdjointPos, GradientTraits::dim<Gradient>(), GradientTraits::toArray(lhsAdjoint).data());
+
+        if (Config::ReversalZeroesAdjoints) {
+          adjointVector[curAdjointPos] = Gradient();
+        }
+#endif
+        EventSystem<PrimalValueLinearTape>::notifyStatementEvaluatePrimalListeners(tape, curAdjointPos,
+                                                                                   primalVector[curAdjointPos]);
+
+        evalStatement(lhsAdjoint);
+      }
+
+      /// True if the statement with the given handle and number of passive arguments continues a statement run with
+      /// the handle runHandle. Low level functions and inputs are never part of a run.
+      CODI_INLINE static bool continuesStatementRun(EvalHandle const& runHandle, EvalHandle const& handle,
+                                                    Config::ArgumentSize nPassiveValues) {
+        return runHandle == handle && nPassiveValues <= Config::MaxArgumentSize;
+      }
+
+      /// True if the statement at statementPos starts a run of at least MinimumStatementRunLength statements. Runs are
+      /// searched in forward or reverse direction, remainingStatements is the number of statements that can be
+      /// evaluated in this direction including the one at statementPos.
+      template<bool forward>
+      CODI_INLINE static bool isStatementRun(size_t const& statementPos, size_t const& remainingStatements,
+                                             Config::ArgumentSize const* const numberOfPassiveArguments,
+                                             EvalHandle const* const stmtEvalhandle) {
+        if (remainingStatements < MinimumStatementRunLength) {
+          return false;
+        }
+
+        for (size_t offset = 1; offset < MinimumStatementRunLength; offset += 1) {
+          size_t const nextPos = forward ? statementPos + offset : statementPos - offset;
+          if (!continuesStatementRun(stmtEvalhandle[statementPos], stmtEvalhandle[nextPos],
+                                     numberOfPassiveArguments[nextPos])) {
+            return false;
+          }
+        }
+
+        return true;
+      }
+
     public:
+
+      /*******************************************************************************/
+      /// @name Statement run evaluation
+      /// Statements that are recorded after each other and have the same handle form a run, e.g. the statements of
+      /// an unrolled loop body. The functions are called by statement evaluators that support runs (see
+      /// InnerStatementEvaluator). They are instantiated with the expression type of the run, the data loading and
+      /// the expression evaluation is therefore inlined for the whole run and only one indirect call is required.
+      /// @{
+
+      /// Positions in the tape data streams for the evaluation of a statement run.
+      struct StatementRunPositions {
+        public:
+
+          size_t adjoint;         ///< Adjoint position of the current statement.
+          size_t statement;       ///< Position of the current statement.
+          size_t constant;        ///< Position in the constant values.
+          size_t passive;         ///< Position in the passive values.
+          size_t rhsIdentifiers;  ///< Position in the rhs identifiers.
+
+          /// Write the positions back to the interpreter variables.
+          CODI_INLINE void extract(size_t& adjointPos, size_t& statementPos, size_t& constantPos, size_t& passivePos,
+                                   size_t& rhsIdentifiersPos) const {
+            adjointPos = adjoint;
+            statementPos = statement;
+            constantPos = constant;
+            passivePos = passive;
+            rhsIdentifiersPos = rhsIdentifiers;
+          }
+      };
+
+      /// Evaluate a run of statements in a forward mode. Starts at pos.statement and advances pos to the last
+      /// statement of the run.
+      template<typename Rhs>
+      static void statementEvaluateForwardRun(PrimalValueLinearTape& tape, Real* primalVector,
+                                              ADJOINT_VECTOR_TYPE* adjointVector, StatementRunPositions& pos,
+                                              size_t const& endAdjointPos,
+                                              Config::ArgumentSize const* const numberOfPassiveArguments,
+                                              EvalHandle const* const stmtEvalhandle,
+                                              PassiveReal const* const constantValues, Real const* const passiveValues,
+                                              Identifier const* const rhsIdentifiers) {
+        size_t constexpr MaxActiveArgs = ExpressionTraits::NumberOfActiveTypeArguments<Rhs>::value;
+        size_t constexpr MaxConstantArgs = ExpressionTraits::NumberOfConstantTypeArguments<Rhs>::value;
+
+        EvalHandle const runHandle = stmtEvalhandle[pos.statement];
+
+        size_t adjointPos = pos.adjoint;
+        size_t statementPos = pos.statement;
+        size_t constantPos = pos.constant;
+        size_t passivePos = pos.passive;
+        size_t rhsIdentifiersPos = pos.rhsIdentifiers;
+
+        while (true) {
+          evaluateForwardStatement(tape, primalVector, adjointVector, adjointPos, [&](Gradient& lhsTangent) {
+            return Base::statementEvaluateForwardFull(Base::template statementEvaluateForwardInner<Rhs>, MaxActiveArgs,
+                                                      MaxConstantArgs, primalVector, adjointVector, lhsTangent,
+                                                      numberOfPassiveArguments[statementPos], constantPos,
+                                                      constantValues, passivePos, passiveValues, rhsIdentifiersPos,
+                                                      rhsIdentifiers);
+          });
+
+          if (adjointPos >= endAdjointPos ||
+              !continuesStatementRun(runHandle, stmtEvalhandle[statementPos + 1],
+                                     numberOfPassiveArguments[statementPos + 1])) {
+            break;
+          }
+
+          adjointPos += 1;
+          statementPos += 1;
+        }
+
+        pos = {adjointPos, statementPos, constantPos, passivePos, rhsIdentifiersPos};
+      }
+
+      /// Evaluate a run of statements in a reverse mode. Starts at pos.statement and decreases pos to the last
+      /// statement of the run.
+      template<typename Rhs>
+      static void statementEvaluateReverseRun(PrimalValueLinearTape& tape, Real* primalVector,
+                                              ADJOINT_VECTOR_TYPE* adjointVector, StatementRunPositions& pos,
+                                              size_t const& endAdjointPos,
+                                              Config::ArgumentSize const* const numberOfPassiveArguments,
+                                              EvalHandle const* const stmtEvalhandle,
+                                              PassiveReal const* const constantValues, Real const* const passiveValues,
+                                              Identifier const* const rhsIdentifiers) {
+        size_t constexpr MaxActiveArgs = ExpressionTraits::NumberOfActiveTypeArguments<Rhs>::value;
+        size_t constexpr MaxConstantArgs = ExpressionTraits::NumberOfConstantTypeArguments<Rhs>::value;
+
+        EvalHandle const runHandle = stmtEvalhandle[pos.statement];
+
+        size_t adjointPos = pos.adjoint;
+        size_t statementPos = pos.statement;
+        size_t constantPos = pos.constant;
+        size_t passivePos = pos.passive;
+        size_t rhsIdentifiersPos = pos.rhsIdentifiers;
+
+        while (true) {
+          evaluateReverseStatement(tape, primalVector, adjointVector, adjointPos, [&](Gradient const& lhsAdjoint) {
+            Base::statementEvaluateReverseFull(Base::template statementEvaluateReverseInner<Rhs>, MaxActiveArgs,
+                                               MaxConstantArgs, primalVector, adjointVector, lhsAdjoint,
+                                               numberOfPassiveArguments[statementPos], constantPos, constantValues,
+                                               passivePos, passiveValues, rhsIdentifiersPos, rhsIdentifiers);
+          });
+
+          if (adjointPos - 1 <= endAdjointPos ||
+              !continuesStatementRun(runHandle, stmtEvalhandle[statementPos - 1],
+                                     numberOfPassiveArguments[statementPos - 1])) {
+            break;
+          }
+
+          adjointPos -= 1;
+          statementPos -= 1;
+        }
+
+        pos = {adjointPos, statementPos, constantPos, passivePos, rhsIdentifiersPos};
+      }
+
+      /// @}
+
       /// \copydoc codi::PrimalValueBaseTape::revertPrimals
       /// Empty implementation; primal values are not overwritten with linear index management.
       void revertPrimals(Position const& pos) {
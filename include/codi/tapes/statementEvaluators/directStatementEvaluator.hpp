@@ -125,6 +125,32 @@ namespace codi {
         return &DirectStatementEvaluatorStaticStore<Generator, Expr>::staticStore;
       }
 
+      /// Forward statement run function type.
+      template<typename Tape>
+      using FunctionForwardRun = decltype(&Tape::template statementEvaluateForwardRun<ActiveType<Tape>>);
+
+      /// Reverse statement run function type.
+      template<typename Tape>
+      using FunctionReverseRun = decltype(&Tape::template statementEvaluateReverseRun<ActiveType<Tape>>);
+
+      /// \copydoc StatementEvaluatorInterface::getForwardRun
+      /// <br> Implementation: Runs are not supported, always returns a nullptr.
+      template<typename Tape>
+      static FunctionForwardRun<Tape> getForwardRun(Handle const& h) {
+        CODI_UNUSED(h);
+
+        return nullptr;
+      }
+
+      /// \copydoc StatementEvaluatorInterface::getReverseRun
+      /// <br> Implementation: Runs are not supported, always returns a nullptr.
+      template<typename Tape>
+      static FunctionReverseRun<Tape> getReverseRun(Handle const& h) {
+        CODI_UNUSED(h);
+
+        return nullptr;
+      }
+
       /// @}
 
     protected:
@@ -58,15 +58,59 @@ namespace codi {
       size_t maxActiveArguments;    ///< Maximum number of active arguments.
       size_t maxConstantArguments;  ///< Maximum number of constant arguments.
 
+      typename Base::Handle forwardRun;  ///< Forward function handle for statement runs. Can be a nullptr.
+      typename Base::Handle reverseRun;  ///< Reverse function handle for statement runs. Can be a nullptr.
+
       /// Constructor
       InnerPrimalTapeStatementData(size_t maxActiveArguments, size_t maxConstantArguments,
                                    typename Base::Handle forward, typename Base::Handle primal,
-                                   typename Base::Handle reverse)
+                                   typename Base::Handle reverse, typename Base::Handle forwardRun,
+                                   typename Base::Handle reverseRun)
           : Base(forward, primal, reverse),
             maxActiveArguments(maxActiveArguments),
-            maxConstantArguments(maxConstantArguments) {}
+            maxConstantArguments(maxConstantArguments),
+            forwardRun(forwardRun),
+            reverseRun(reverseRun) {}
   };
 
+  /// Extracts the `statementEvaluate*Run` functions of a generator. The functions are optional, if the generator does
+  /// not provide them, nullptr handles are returned.
+  template<typename Generator, typename Expr, typename = void>
+  struct InnerStatementRunHandles {
+    public:
+
+      using Handle = typename PrimalTapeStatementFunctions::Handle;  ///< See PrimalTapeStatementFunctions.
+
+      /// Forward run handle.
+      static Handle forward() {
+        return nullptr;
+      }
+
+      /// Reverse run handle.
+      static Handle reverse() {
+        return nullptr;
+      }
+  };
+
+#ifndef DOXYGEN_DISABLE
+  template<typename Generator, typename Expr>
+  struct InnerStatementRunHandles<Generator, Expr,
+                                  decltype((void)&Generator::template statementEvaluateReverseRun<Expr>,
+                                           (void)&Generator::template statementEvaluateForwardRun<Expr>)> {
+    public:
+
+      using Handle = typename PrimalTapeStatementFunctions::Handle;
+
+      static Handle forward() {
+        return (Handle)Generator::template statementEvaluateForwardRun<Expr>;
+      }
+
+      static Handle reverse() {
+        return (Handle)Generator::template statementEvaluateReverseRun<Expr>;
+      }
+  };
+#endif
+
   /// Store InnerPrimalTapeStatementData as static variables for each combination of generator (tape) and expression
   /// used in the program.
   template<typename Tape, typename Expr>
@@ -84,7 +128,8 @@ namespace codi {
       ExpressionTraits::NumberOfConstantTypeArguments<Expr>::value,
       (typename PrimalTapeStatementFunctions::Handle)Generator::template statementEvaluateForwardInner<Expr>,
       (typename PrimalTapeStatementFunctions::Handle)Generator::template statementEvaluatePrimalInner<Expr>,
-      (typename PrimalTapeStatementFunctions::Handle)Generator::template statementEvaluateReverseInner<Expr>);
+      (typename PrimalTapeStatementFunctions::Handle)Generator::template statementEvaluateReverseInner<Expr>,
+      InnerStatementRunHandles<Generator, Expr>::forward(), InnerStatementRunHandles<Generator, Expr>::reverse());
 
   /**
    * @brief Expression evaluation in the inner function. Data loading in the compilation context of the tape.
@@ -94,6 +139,10 @@ namespace codi {
    * evaluation of the expression after the data is loaded. This evaluator stores expression specific data and the
    * inner function handles.
    *
+   * If the generator provides `statementEvaluateForwardRun<Expr>` and `statementEvaluateReverseRun<Expr>`, these are
+   * stored as well. A tape can then evaluate a run of consecutive statements with the same handle with one function
+   * call, the expression specific data is then known at compile time for the whole run.
+   *
    * See StatementEvaluatorInterface for details.
    *
    * @tparam T_Real  The computation type of a tape, usually chosen as ActiveType::Real.
@@ -137,6 +186,26 @@ namespace codi {
         return &InnerStatementEvaluatorStaticStore<Generator, Expr>::staticStore;
       }
 
+      /// Forward statement run function type.
+      template<typename Tape>
+      using FunctionForwardRun = decltype(&Tape::template statementEvaluateForwardRun<ActiveType<Tape>>);
+
+      /// Reverse statement run function type.
+      template<typename Tape>
+      using FunctionReverseRun = decltype(&Tape::template statementEvaluateReverseRun<ActiveType<Tape>>);
+
+      /// \copydoc StatementEvaluatorInterface::getForwardRun
+      template<typename Tape>
+      static FunctionForwardRun<Tape> getForwardRun(Handle const& h) {
+        return (FunctionForwardRun<Tape>)h->forwardRun;
+      }
+
+      /// \copydoc StatementEvaluatorInterface::getReverseRun
+      template<typename Tape>
+      static FunctionReverseRun<Tape> getReverseRun(Handle const& h) {
+        return (FunctionReverseRun<Tape>)h->reverseRun;
+      }
+
       /// @}
 
     protected:
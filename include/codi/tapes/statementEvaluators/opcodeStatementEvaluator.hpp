@@ -0,0 +1,194 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+#include "../../misc/exceptions.hpp"
+#include "../../misc/macros.hpp"
+#include "innerStatementEvaluator.hpp"
+#include "statementEvaluatorInterface.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+  /**
+   * @brief Opcode table of an OpcodeStatementEvaluator.
+   *
+   * Maps the opcodes of a tape type to the InnerPrimalTapeStatementData of the expressions. Opcodes are assigned in
+   * the order in which the expressions are recorded for the first time. Opcode zero is reserved for the default
+   * constructed handle, e.g. for low level functions.
+   *
+   * The table has a fixed size, entries are never moved. Lookups do therefore not need to be synchronized with
+   * registrations from other threads.
+   *
+   * @tparam T_Tape  The tape that uses the opcodes.
+   */
+  template<typename T_Tape>
+  struct OpcodeStatementEvaluatorTable {
+    public:
+
+      using Tape = CODI_DD(T_Tape, CODI_ANY);  ///< See OpcodeStatementEvaluatorTable.
+
+      using Opcode = uint16_t;                             ///< Opcode type.
+      using Data = InnerPrimalTapeStatementData const*;  ///< Statement data of an expression.
+
+      static size_t constexpr MaxOpcodes = (size_t)1 << (8 * sizeof(Opcode));  ///< Maximum number of opcodes.
+
+    private:
+
+      // Zero initialized, only the pages that contain registered opcodes are touched.
+      Data entries[MaxOpcodes];
+      size_t size;
+      std::mutex mutex;
+
+      OpcodeStatementEvaluatorTable() : size(1) {}
+
+    public:
+
+      /// Table for the tape type.
+      static OpcodeStatementEvaluatorTable& getInstance() {
+        static OpcodeStatementEvaluatorTable instance;
+
+        return instance;
+      }
+
+      /// Register the statement data of an expression and return its opcode.
+      Opcode add(Data data) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (MaxOpcodes == size) {
+          CODI_EXCEPTION("Too many different expressions for the OpcodeStatementEvaluator, the maximum is %d.",
+                         (int)(MaxOpcodes - 1));
+        }
+
+        entries[size] = data;
+        size += 1;
+
+        return (Opcode)(size - 1);
+      }
+
+      /// Statement data for an opcode.
+      CODI_INLINE Data get(Opcode const& opcode) const {
+        return entries[opcode];
+      }
+
+      /// Number of registered opcodes, including the reserved opcode zero.
+      size_t getSize() const {
+        return size;
+      }
+  };
+
+  /**
+   * @brief Stores a compact opcode per statement and dispatches through a per tape table.
+   *
+   * Every expression type that is recorded by a tape is assigned a 16 bit opcode. The tape stores only the opcode
+   * instead of a pointer, which reduces the size of the statement handle from eight to two bytes. During the
+   * evaluation, the opcode is used as an index into the OpcodeStatementEvaluatorTable of the tape. The table entries
+   * are the same static data that the InnerStatementEvaluator uses, the data loading is therefore also performed in
+   * the compilation context of the tape. Statement runs are supported in the same way as by the
+   * InnerStatementEvaluator.
+   *
+   * At most 65535 different expressions can be recorded with one tape type.
+   *
+   * See StatementEvaluatorInterface for details.
+   *
+   * @tparam T_Real  The computation type of a tape, usually chosen as ActiveType::Real.
+   */
+  template<typename T_Real>
+  struct OpcodeStatementEvaluator : public StatementEvaluatorInterface<T_Real> {
+    public:
+
+      using Real = CODI_DD(T_Real, double);  ///< See OpcodeStatementEvaluator.
+
+      using Inner = InnerStatementEvaluator<Real>;  ///< Evaluator for the table entries.
+
+      /*******************************************************************************/
+      /// @name StatementEvaluatorInterface implementation
+      /// @{
+
+      using Handle = uint16_t;  ///< Opcode of the expression.
+
+      /// \copydoc StatementEvaluatorInterface::callForward
+      template<typename Tape, typename... Args>
+      static Real callForward(Handle const& h, Args&&... args) {
+        return Inner::template callForward<Tape>(lookup<Tape>(h), std::forward<Args>(args)...);
+      }
+
+      /// \copydoc StatementEvaluatorInterface::callPrimal
+      template<typename Tape, typename... Args>
+      static Real callPrimal(Handle const& h, Args&&... args) {
+        return Inner::template callPrimal<Tape>(lookup<Tape>(h), std::forward<Args>(args)...);
+      }
+
+      /// \copydoc StatementEvaluatorInterface::callReverse
+      template<typename Tape, typename... Args>
+      static void callReverse(Handle const& h, Args&&... args) {
+        Inner::template callReverse<Tape>(lookup<Tape>(h), std::forward<Args>(args)...);
+      }
+
+      /// \copydoc StatementEvaluatorInterface::createHandle
+      template<typename Tape, typename Generator, typename Expr>
+      static Handle createHandle() {
+        static Handle const opcode = OpcodeStatementEvaluatorTable<Tape>::getInstance().add(
+            Inner::template createHandle<Tape, Generator, Expr>());
+
+        return opcode;
+      }
+
+      /// \copydoc StatementEvaluatorInterface::getForwardRun
+      template<typename Tape>
+      static typename Inner::template FunctionForwardRun<Tape> getForwardRun(Handle const& h) {
+        return Inner::template getForwardRun<Tape>(lookup<Tape>(h));
+      }
+
+      /// \copydoc StatementEvaluatorInterface::getReverseRun
+      template<typename Tape>
+      static typename Inner::template FunctionReverseRun<Tape> getReverseRun(Handle const& h) {
+        return Inner::template getReverseRun<Tape>(lookup<Tape>(h));
+      }
+
+      /// @}
+
+    private:
+
+      template<typename Tape>
+      CODI_INLINE static typename Inner::Handle lookup(Handle const& h) {
+        return OpcodeStatementEvaluatorTable<Tape>::getInstance().get(h);
+      }
+  };
+}
@@ -131,5 +131,19 @@ namespace codi {
       /// @tparam Expr       Instance of ExpressionInterface.
       template<typename Tape, typename Generator, typename Expr>
       static Handle createHandle();
+
+      /// Function for the forward evaluation of a run of consecutive statements that share the handle h. Tapes call it
+      /// instead of callForward if it is not a nullptr. Evaluators that do not support runs return a nullptr.
+      ///
+      /// @tparam Tape  Has to implement `statementEvaluateForwardRun<Expr>`.
+      template<typename Tape>
+      static CODI_ANY getForwardRun(Handle const& h);
+
+      /// Function for the reverse evaluation of a run of consecutive statements that share the handle h. Tapes call it
+      /// instead of callReverse if it is not a nullptr. Evaluators that do not support runs return a nullptr.
+      ///
+      /// @tparam Tape  Has to implement `statementEvaluateReverseRun<Expr>`.
+      template<typename Tape>
+      static CODI_ANY getReverseRun(Handle const& h);
   };
 }
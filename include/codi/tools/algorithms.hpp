@@ -34,13 +34,21 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <vector>
+
 #include "../config.h"
 #include "../expressions/lhsExpressionInterface.hpp"
 #include "../misc/exceptions.hpp"
 #include "../tapes/misc/tapeParameters.hpp"
 #include "../traits/gradientTraits.hpp"
+#include "../traits/realTraits.hpp"
+#include "data/dependencyBits.hpp"
 #include "data/dummy.hpp"
 #include "data/jacobian.hpp"
+#include "data/sparseHessian.hpp"
+#include "data/sparseJacobian.hpp"
+#include "data/sparsityPattern.hpp"
 #include "data/staticDummy.hpp"
 
 /** \copydoc codi::Namespace */
@@ -51,7 +59,11 @@ namespace codi {
    *
    * This class provides algorithms for:
    *  - Jacobian assembly
+   *  - Sparse Jacobian assembly
    *  - Hessian assembly
+   *  - Sparse Hessian assembly
+   *  - Jacobian-transpose-vector and Hessian-vector products
+   *  - Sparsity pattern detection
    *
    * All algorithms try to make the best choice for the evaluation mode depending on the number of inputs and outputs,
    * either forward or reverse. Which mode is selected can be queried in advance with the method
@@ -222,6 +234,339 @@ namespace codi {
         computeJacobian(Type::getTape(), start, end, input, inputSize, output, outputSize, jac, adjointsManagement);
       }
 
+      /**
+       * @brief Compute the sparsity pattern of the Jacobian with a propagation of dependency bits.
+       *
+       * Row i of the pattern contains the inputs on which output i depends. One forward evaluation of the tape with a
+       * custom adjoint vector of DependencyBits covers 64 inputs, so ceil(inputSize / 64) evaluations are performed.
+       * It is the pattern of the recorded Jacobian values, it contains every nonzero entry of the Jacobian computed by
+       * computeJacobian.
+       *
+       * The tape has to implement CustomAdjointVectorEvaluationTapeInterface. The tape section [start, end] must not
+       * contain low level functions, since these cannot propagate the dependencies. The same prerequisites as for
+       * computeJacobian hold for the inputs. The gradients of the tape are not used.
+       *
+       * #### Parameters
+       * [out] __pattern__  The sparsity pattern with outputSize rows and inputSize columns. \n
+       * [in,out] __dependencies__  Workspace for the evaluations, resized to the largest identifier of the tape.
+       */
+      static void computeSparsityPattern(Tape& tape, Position const& start, Position const& end,
+                                         Identifier const* input, size_t const inputSize, Identifier const* output,
+                                         size_t const outputSize, SparsityPattern& pattern,
+                                         std::vector<DependencyBits<Real>>& dependencies) {
+        using Bits = DependencyBits<Real>;
+        using Word = typename Bits::Word;
+
+        size_t const blocks = (inputSize + Bits::Size - 1) / Bits::Size;
+        size_t const dependenciesSize = tape.getParameter(TapeParameters::LargestIdentifier) + 1;
+        if (dependencies.size() < dependenciesSize) {
+          dependencies.resize(dependenciesSize);
+        }
+
+        std::vector<Word> outputWords(outputSize * blocks);
+        for (size_t block = 0; block < blocks; block += 1) {
+          size_t const blockStart = block * Bits::Size;
+          size_t const blockEnd = std::min(inputSize, blockStart + Bits::Size);
+
+          // The entries of inputs and outputs that are not written in the section have to be zero.
+          for (size_t j = 0; j < inputSize; j += 1) {
+            dependencies[input[j]] = Bits();
+          }
+          for (size_t i = 0; i < outputSize; i += 1) {
+            dependencies[output[i]] = Bits();
+          }
+          for (size_t j = blockStart; j < blockEnd; j += 1) {
+            dependencies[input[j]].set(j - blockStart);
+          }
+
+          tape.evaluateForward(start, end, dependencies.data());
+
+          for (size_t i = 0; i < outputSize; i += 1) {
+            outputWords[i * blocks + block] = dependencies[output[i]].bits;
+          }
+        }
+
+        pattern.reset(inputSize);
+        for (size_t i = 0; i < outputSize; i += 1) {
+          for (size_t block = 0; block < blocks; block += 1) {
+            Bits::forEach(outputWords[i * blocks + block],
+                          [&](size_t const k) { pattern.addEntry(block * Bits::Size + k); });
+          }
+          pattern.finishRow();
+        }
+      }
+
+      /**
+       * @brief Compute the sparsity pattern of the Jacobian with a propagation of index sets along the statements.
+       *
+       * Row i of the pattern contains the inputs on which output i depends. The statements of the tape section are
+       * read once, the index set of each left hand side is the union of the index sets of its arguments with a nonzero
+       * Jacobian. The set of an identifier is released as soon as the identifier is overwritten, so the memory is
+       * proportional to the sum of the index set sizes of the live identifiers in the section.
+       *
+       * The tape has to be a Jacobian tape that provides iterateStatements(). If the section contains low level
+       * functions, their dependencies are unknown and the pattern is dense. The same prerequisites as for
+       * computeJacobian hold for the inputs. The gradients of the tape are not used.
+       *
+       * #### Parameters
+       * [out] __pattern__  The sparsity pattern with outputSize rows and inputSize columns. \n
+       * [in,out] __indexSets__  Workspace for the propagation, resized to the largest identifier of the tape. All sets
+       *                         have to be empty on entry and are empty on exit.
+       */
+      static void computeSparsityPattern(Tape& tape, Position const& start, Position const& end,
+                                         Identifier const* input, size_t const inputSize, Identifier const* output,
+                                         size_t const outputSize, SparsityPattern& pattern,
+                                         std::vector<std::vector<size_t>>& indexSets) {
+        size_t const indexSetsSize = tape.getParameter(TapeParameters::LargestIdentifier) + 1;
+        if (indexSets.size() < indexSetsSize) {
+          indexSets.resize(indexSetsSize);
+        }
+
+        std::vector<Identifier> touched;
+        for (size_t j = 0; j < inputSize; j += 1) {
+          if (CODI_ENABLE_CHECK(ActiveChecks, 0 != input[j])) {
+            indexSets[(size_t)input[j]].push_back(j);
+            touched.push_back(input[j]);
+          }
+        }
+
+        bool hasLowLevelFunctions = false;
+        IndexSetPropagation propagation = {indexSets, touched, hasLowLevelFunctions, {}};
+        tape.iterateStatements(start, end, propagation);
+
+        pattern.reset(inputSize);
+        for (size_t i = 0; i < outputSize; i += 1) {
+          if (hasLowLevelFunctions) {
+            for (size_t j = 0; j < inputSize; j += 1) {
+              pattern.addEntry(j);
+            }
+          } else if ((size_t)output[i] < indexSets.size()) {
+            for (size_t const j : indexSets[(size_t)output[i]]) {
+              pattern.addEntry(j);
+            }
+          }
+          pattern.finishRow();
+        }
+
+        // Only the touched sets are nonempty, release them for the next call.
+        for (Identifier const& identifier : touched) {
+          std::vector<size_t>().swap(indexSets[(size_t)identifier]);
+        }
+      }
+
+      /// Returns the preferred evaluation mode for computeSparseJacobian. The forward mode is chosen if the columns
+      /// need at most as many colors as the rows.
+      template<typename T>
+      static CODI_INLINE EvaluationType getSparseEvaluationChoice(SparseJacobian<T> const& jac) {
+        if (jac.getNumberOfColumnColors() <= jac.getNumberOfRowColors()) {
+          return EvaluationType::Forward;
+        } else {
+          return EvaluationType::Reverse;
+        }
+      }
+
+      /**
+       * @brief Compute the entries of a sparse Jacobian with compressed tape sweeps.
+       *
+       * Only the entries in the pattern of jac are computed, all other entries of the Jacobian have to be zero. The
+       * pattern can be computed with computeSparsityPattern and reused for multiple evaluations.
+       *
+       * In the forward mode, all inputs of one column color are seeded together. Since these columns have no common
+       * row, each output tangent contains the entry of exactly one of the columns. The reverse mode seeds the outputs
+       * of one row color together. GT::dim colors are evaluated in one sweep, so ceil(colors / GT::dim) sweeps are
+       * performed, see getSparseEvaluationChoice for the mode selection.
+       *
+       * The prerequisites and the handling of the adjoints are the same as for computeJacobian. There should be no
+       * duplicate identifiers among the inputs and outputs.
+       *
+       * #### Parameters
+       * [in,out] __jac__  The pattern has to be set, it needs outputSize rows and inputSize columns.
+       */
+      template<typename T, bool keepState = true>
+      static void computeSparseJacobian(Tape& tape, Position const& start, Position const& end,
+                                        Identifier const* input, size_t const inputSize, Identifier const* output,
+                                        size_t const outputSize, SparseJacobian<T>& jac,
+                                        AdjointsManagement adjointsManagement = AdjointsManagement::Automatic) {
+        size_t constexpr gradDim = GT::dim;
+        SparsityPattern const& pattern = jac.getPattern();
+
+        codiAssert(pattern.getM() == outputSize && pattern.getN() == inputSize);
+
+        // internally, automatic management is implemented in an optimized way that uses manual management
+        if (AdjointsManagement::Automatic == adjointsManagement) {
+          tape.resizeAdjointVector();
+          tape.beginUseAdjointVector();
+        }
+
+        EvaluationType evalType = getSparseEvaluationChoice(jac);
+        if (EvaluationType::Forward == evalType) {
+          std::vector<size_t> const& colors = jac.getColumnColors();
+
+          for (size_t firstColor = 0; firstColor < jac.getNumberOfColumnColors(); firstColor += gradDim) {
+            size_t const endColor = firstColor + gradDim;
+
+            for (size_t j = 0; j < inputSize; j += 1) {
+              if (firstColor <= colors[j] && colors[j] < endColor &&
+                  CODI_ENABLE_CHECK(ActiveChecks, 0 != input[j])) {
+                GT::at(tape.gradient(input[j], AdjointsManagement::Manual), colors[j] - firstColor) =
+                    typename GT::Real(1.0);
+              }
+            }
+
+            if (keepState) {
+              tape.evaluateForwardKeepState(start, end, AdjointsManagement::Manual);
+            } else {
+              tape.evaluateForward(start, end, AdjointsManagement::Manual);
+            }
+
+            for (size_t i = 0; i < outputSize; i += 1) {
+              Gradient const& tangent = tape.getGradient(output[i], AdjointsManagement::Manual);
+              for (size_t pos = pattern.rowBegin(i); pos < pattern.rowEnd(i); pos += 1) {
+                size_t const color = colors[pattern.getColumn(pos)];
+                if (firstColor <= color && color < endColor) {
+                  setSparseEntry(jac.value(pos), GT::at(tangent, color - firstColor));
+                }
+              }
+            }
+
+            for (size_t i = 0; i < outputSize; i += 1) {
+              if (CODI_ENABLE_CHECK(ActiveChecks, 0 != output[i])) {
+                tape.gradient(output[i], AdjointsManagement::Manual) = Gradient();
+              }
+            }
+            for (size_t j = 0; j < inputSize; j += 1) {
+              if (CODI_ENABLE_CHECK(ActiveChecks, 0 != input[j])) {
+                tape.gradient(input[j], AdjointsManagement::Manual) = Gradient();
+              }
+            }
+          }
+
+          tape.clearAdjoints(end, start, AdjointsManagement::Manual);
+
+        } else if (EvaluationType::Reverse == evalType) {
+          std::vector<size_t> const& colors = jac.getRowColors();
+
+          for (size_t firstColor = 0; firstColor < jac.getNumberOfRowColors(); firstColor += gradDim) {
+            size_t const endColor = firstColor + gradDim;
+
+            for (size_t i = 0; i < outputSize; i += 1) {
+              if (firstColor <= colors[i] && colors[i] < endColor &&
+                  CODI_ENABLE_CHECK(ActiveChecks, 0 != output[i])) {
+                GT::at(tape.gradient(output[i], AdjointsManagement::Manual), colors[i] - firstColor) =
+                    typename GT::Real(1.0);
+              }
+            }
+
+            if (keepState) {
+              tape.evaluateKeepState(end, start, AdjointsManagement::Manual);
+            } else {
+              tape.evaluate(end, start, AdjointsManagement::Manual);
+            }
+
+            for (size_t i = 0; i < outputSize; i += 1) {
+              if (firstColor <= colors[i] && colors[i] < endColor) {
+                for (size_t pos = pattern.rowBegin(i); pos < pattern.rowEnd(i); pos += 1) {
+                  Gradient const& adjoint = tape.getGradient(input[pattern.getColumn(pos)], AdjointsManagement::Manual);
+                  setSparseEntry(jac.value(pos), GT::at(adjoint, colors[i] - firstColor));
+                }
+              }
+            }
+
+            for (size_t j = 0; j < inputSize; j += 1) {
+              if (CODI_ENABLE_CHECK(ActiveChecks, 0 != input[j])) {
+                tape.gradient(input[j], AdjointsManagement::Manual) = Gradient();
+              }
+            }
+            for (size_t i = 0; i < outputSize; i += 1) {
+              if (CODI_ENABLE_CHECK(ActiveChecks, 0 != output[i])) {
+                tape.gradient(output[i], AdjointsManagement::Manual) = Gradient();
+              }
+            }
+
+            if (!Config::ReversalZeroesAdjoints) {
+              tape.clearAdjoints(end, start, AdjointsManagement::Manual);
+            }
+          }
+        } else {
+          CODI_EXCEPTION("Evaluation mode not implemented. Mode is: %d.", (int)evalType);
+        }
+
+        if (AdjointsManagement::Automatic == adjointsManagement) {
+          tape.endUseAdjointVector();
+        }
+      }
+
+      /**
+       * @brief Compute the products of the transposed Jacobian with multiple vectors.
+       *
+       * Computes \f$ \bar x_b = J^T \bar y_b \f$ for count vectors without the assembly of the Jacobian. The vectors
+       * are seeded on the outputs and GT::dim products are computed with one reverse evaluation.
+       *
+       * The prerequisites and the handling of the adjoints are the same as for computeJacobian in the reverse mode.
+       * If an output identifier is specified multiple times, the sum of its weights is seeded.
+       *
+       * #### Parameters
+       * [in]      __w__  The weights of the outputs, w[b * outputSize + i] is the weight of output i in vector b.\n
+       * [in]  __count__  Number of vectors.\n
+       * [out]   __jtw__  The products, jtw[b * inputSize + j] is the entry of input j in product b.
+       */
+      template<typename T, bool keepState = true>
+      static void computeJacobianTransposeProducts(
+          Tape& tape, Position const& start, Position const& end, Identifier const* input, size_t const inputSize,
+          Identifier const* output, size_t const outputSize, T const* w, size_t const count, T* jtw,
+          AdjointsManagement adjointsManagement = AdjointsManagement::Automatic) {
+        size_t constexpr gradDim = GT::dim;
+
+        // internally, automatic management is implemented in an optimized way that uses manual management
+        if (AdjointsManagement::Automatic == adjointsManagement) {
+          tape.resizeAdjointVector();
+          tape.beginUseAdjointVector();
+        }
+
+        for (size_t b = 0; b < count; b += gradDim) {
+          for (size_t i = 0; i < outputSize; i += 1) {
+            if (CODI_ENABLE_CHECK(ActiveChecks, 0 != output[i])) {
+              for (size_t curDim = 0; curDim < gradDim && b + curDim < count; curDim += 1) {
+                GT::at(tape.gradient(output[i], AdjointsManagement::Manual), curDim) +=
+                    w[(b + curDim) * outputSize + i];
+              }
+            }
+          }
+
+          if (keepState) {
+            tape.evaluateKeepState(end, start, AdjointsManagement::Manual);
+          } else {
+            tape.evaluate(end, start, AdjointsManagement::Manual);
+          }
+
+          for (size_t j = 0; j < inputSize; j += 1) {
+            for (size_t curDim = 0; curDim < gradDim && b + curDim < count; curDim += 1) {
+              jtw[(b + curDim) * inputSize + j] = RealTraits::getPassiveValue(
+                  GT::at(tape.getGradient(input[j], AdjointsManagement::Manual), curDim));
+            }
+          }
+
+          for (size_t j = 0; j < inputSize; j += 1) {
+            if (CODI_ENABLE_CHECK(ActiveChecks, 0 != input[j])) {
+              tape.gradient(input[j], AdjointsManagement::Manual) = Gradient();
+            }
+          }
+          for (size_t i = 0; i < outputSize; i += 1) {
+            if (CODI_ENABLE_CHECK(ActiveChecks, 0 != output[i])) {
+              tape.gradient(output[i], AdjointsManagement::Manual) = Gradient();
+            }
+          }
+
+          if (!Config::ReversalZeroesAdjoints) {
+            tape.clearAdjoints(end, start, AdjointsManagement::Manual);
+          }
+        }
+
+        if (AdjointsManagement::Automatic == adjointsManagement) {
+          tape.endUseAdjointVector();
+        }
+      }
+
       /**
        * @brief Compute the Hessian with multiple tape sweeps.
        *
@@ -381,6 +726,153 @@ namespace codi {
         }
       }
 
+      /**
+       * @brief Compute the common sparsity pattern of the Hessians with multiple tape sweeps.
+       *
+       * The sweeps are the same as in computeHessianPrimalValueTapeReverse, but only the positions of the nonzero
+       * entries are kept. The pattern is the union of the patterns of the Hessians of all outputs, it has inputSize
+       * rows and columns and is symmetric. The memory is proportional to the number of nonzero entries.
+       *
+       * The pattern is value based, entries that are zero at the current point are not contained. It should be
+       * computed at a generic point, it can then be reused for the evaluation at other points with
+       * computeSparseHessianPrimalValueTape. The sweeps have the cost of computeHessianPrimalValueTape, the pattern
+       * has to be computed once and not for every point.
+       *
+       * The prerequisites are the same as for computeHessianPrimalValueTape.
+       *
+       * #### Parameters
+       * [out] __pattern__  The symmetric sparsity pattern of the Hessians.
+       */
+      static void computeHessianSparsityPatternPrimalValueTape(Tape& tape, Position const& start, Position const& end,
+                                                               Identifier const* input, size_t const inputSize,
+                                                               Identifier const* output, size_t const outputSize,
+                                                               SparsityPattern& pattern) {
+        using GT2nd = GradientTraits::TraitsImplementation<CODI_DD(typename Real::Gradient, double)>;
+        size_t constexpr gradDim2nd = GT2nd::dim;
+
+        std::vector<std::vector<size_t>> rows(inputSize);
+
+        // Assume that the tape was just recorded.
+        tape.revertPrimals(start);
+
+        for (size_t j = 0; j < inputSize; j += gradDim2nd) {
+          setGradient2ndOnIdentifier(tape, j, input, inputSize, typename GT2nd::Real(1.0));
+
+          // Propagate the new derivative information.
+          tape.evaluatePrimal(start, end);
+
+          addHessianPatternEntries(tape, start, end, input, inputSize, output, outputSize, j, rows);
+
+          setGradient2ndOnIdentifier(tape, j, input, inputSize, typename GT2nd::Real());
+
+          if (j + gradDim2nd < inputSize) {
+            tape.revertPrimals(start);
+          }
+        }
+
+        createSymmetricPattern(rows, pattern);
+      }
+
+      /**
+       * @brief Compute the entries of sparse Hessians with compressed tape sweeps.
+       *
+       * All inputs of one color of the star coloring of hes are seeded together with second order tangents and a
+       * primal evaluation propagates them. Afterwards, the outputs are seeded and reverse evaluations are performed.
+       * The adjoints of the inputs are then compressed columns of the Hessians from which the entries are recovered
+       * directly, see SparseHessian.
+       *
+       * The algorithm performs ceil(colors / GT2nd::dim) primal evaluations and ceil(colors / GT2nd::dim) *
+       * ceil(m / GT1st::dim) reverse evaluations, instead of the n / GT2nd::dim primal evaluations of
+       * computeHessianPrimalValueTapeReverse. Only the entries in the pattern of hes are computed, all other entries of
+       * the Hessians have to be zero. The pattern can be computed with computeHessianSparsityPatternPrimalValueTape.
+       * Its computation has the cost of a dense Hessian evaluation, so it has to be computed once and reused for the
+       * evaluations at all points. Otherwise, the dense cost is paid on every evaluation.
+       *
+       * \copydetails computeHessianPrimalValueTape
+       */
+      template<typename T, typename Jac = DummyJacobian>
+      static void computeSparseHessianPrimalValueTape(Tape& tape, Position const& start, Position const& end,
+                                                      Identifier const* input, size_t const inputSize,
+                                                      Identifier const* output, size_t const outputSize,
+                                                      SparseHessian<T>& hes,
+                                                      Jac& jac = StaticDummy<DummyJacobian>::dummy) {
+        using GT2nd = GradientTraits::TraitsImplementation<CODI_DD(typename Real::Gradient, double)>;
+        size_t constexpr gradDim2nd = GT2nd::dim;
+
+        codiAssert(hes.getM() == outputSize && hes.getN() == inputSize);
+
+        // At least one evaluation for the Jacobian.
+        size_t const numberOfColors = std::max(hes.getNumberOfColors(), (size_t)1);
+
+        // Assume that the tape was just recorded.
+        tape.revertPrimals(start);
+
+        for (size_t firstColor = 0; firstColor < numberOfColors; firstColor += gradDim2nd) {
+          setColorGradient2ndOnIdentifier(tape, firstColor, hes.getColors(), input, inputSize,
+                                          typename GT2nd::Real(1.0));
+
+          // Propagate the new derivative information.
+          tape.evaluatePrimal(start, end);
+
+          recoverSparseHessian(tape, start, end, input, inputSize, output, outputSize, firstColor, hes, jac);
+
+          setColorGradient2ndOnIdentifier(tape, firstColor, hes.getColors(), input, inputSize, typename GT2nd::Real());
+
+          if (firstColor + gradDim2nd < numberOfColors) {
+            tape.revertPrimals(start);
+          }
+        }
+      }
+
+      /**
+       * @brief Compute the products of the Hessians with multiple vectors.
+       *
+       * Computes \f$ H_i v_b \f$ for all outputs i and count vectors without the assembly of the Hessians. The vectors
+       * are seeded as second order tangents of the inputs and a primal evaluation propagates them. Afterwards, the
+       * outputs are seeded and reverse evaluations are performed (forward-over-reverse). GT2nd::dim vectors are handled
+       * with one primal evaluation and ceil(m / GT1st::dim) reverse evaluations.
+       *
+       * The prerequisites are the same as for computeHessianPrimalValueTape.
+       *
+       * #### Parameters
+       * [in]      __v__  The vectors, v[b * inputSize + j] is the entry of input j in vector b.\n
+       * [in]  __count__  Number of vectors.\n
+       * [out]    __hv__  The products, hv[(b * outputSize + i) * inputSize + k] is the entry k of \f$ H_i v_b \f$.
+       */
+      template<typename T>
+      static void computeHessianVectorProductsPrimalValueTape(Tape& tape, Position const& start, Position const& end,
+                                                              Identifier const* input, size_t const inputSize,
+                                                              Identifier const* output, size_t const outputSize,
+                                                              T const* v, size_t const count, T* hv) {
+        using GT2nd = GradientTraits::TraitsImplementation<CODI_DD(typename Real::Gradient, double)>;
+        size_t constexpr gradDim2nd = GT2nd::dim;
+
+        // Assume that the tape was just recorded.
+        tape.revertPrimals(start);
+
+        for (size_t b = 0; b < count; b += gradDim2nd) {
+          for (size_t j = 0; j < inputSize; j += 1) {
+            for (size_t vecPos2nd = 0; vecPos2nd < gradDim2nd && b + vecPos2nd < count; vecPos2nd += 1) {
+              // No activity check on the identifier required since forward types are used.
+              GT2nd::at(tape.primal(input[j]).gradient(), vecPos2nd) = v[(b + vecPos2nd) * inputSize + j];
+            }
+          }
+
+          // Propagate the new derivative information.
+          tape.evaluatePrimal(start, end);
+
+          extractHessianVectorProducts(tape, start, end, input, inputSize, output, outputSize, b, count, hv);
+
+          for (size_t j = 0; j < inputSize; j += 1) {
+            tape.primal(input[j]).gradient() = typename Real::Gradient();
+          }
+
+          if (b + gradDim2nd < count) {
+            tape.revertPrimals(start);
+          }
+        }
+      }
+
       /**
        * @brief Compute the Hessian with multiple tape recordings and sweeps.
        *
@@ -537,8 +1029,353 @@ namespace codi {
         }
       }
 
+      /**
+       * @brief Compute the common sparsity pattern of the Hessians with multiple tape recordings and sweeps.
+       *
+       * The recordings and sweeps are the same as in computeHessianReverse, but only the positions of the nonzero
+       * entries are kept. See computeHessianSparsityPatternPrimalValueTape for the properties of the pattern.
+       *
+       * The prerequisites are the same as for computeHessian.
+       *
+       * #### Parameters
+       * [in]     __func__  The function for the recording of the tape. It needs to be a function object that
+       *                         will accept the call: func(input, output) \n
+       * [out] __pattern__  The symmetric sparsity pattern of the Hessians.
+       */
+      template<typename Func, typename VecIn, typename VecOut>
+      static void computeHessianSparsityPattern(Func func, VecIn& input, VecOut& output, SparsityPattern& pattern) {
+        using GT2nd = GradientTraits::TraitsImplementation<CODI_DD(typename Real::Gradient, double)>;
+        size_t constexpr gradDim2nd = GT2nd::dim;
+
+        Tape& tape = Type::getTape();
+
+        std::vector<std::vector<size_t>> rows(input.size());
+        std::vector<Identifier> inputIdentifiers;
+        std::vector<Identifier> outputIdentifiers;
+
+        for (size_t j = 0; j < input.size(); j += gradDim2nd) {
+          setGradient2ndOnCoDiValue(j, input.data(), input.size(), typename GT2nd::Real(1.0));
+
+          // Propagate the new derivative information.
+          recordTape(func, input, output, inputIdentifiers, outputIdentifiers);
+
+          addHessianPatternEntries(tape, tape.getZeroPosition(), tape.getPosition(), inputIdentifiers.data(),
+                                   inputIdentifiers.size(), outputIdentifiers.data(), outputIdentifiers.size(), j,
+                                   rows);
+
+          setGradient2ndOnCoDiValue(j, input.data(), input.size(), typename GT2nd::Real());
+
+          tape.reset();
+        }
+
+        createSymmetricPattern(rows, pattern);
+      }
+
+      /**
+       * @brief Compute the entries of sparse Hessians with multiple tape recordings and compressed sweeps.
+       *
+       * All inputs of one color of the star coloring of hes are seeded together with second order tangents and a tape
+       * is recorded. Afterwards, the outputs are seeded and reverse evaluations are performed, see
+       * computeSparseHessianPrimalValueTape.
+       *
+       * The algorithm will record ceil(colors / GT2nd::dim) tapes and perform ceil(colors / GT2nd::dim) *
+       * ceil(m / GT1st::dim) reverse tape evaluations. The pattern can be computed with computeHessianSparsityPattern.
+       * Its computation has the cost of a dense Hessian evaluation, so it has to be computed once and reused for the
+       * evaluations at all points. Otherwise, the dense cost is paid on every evaluation.
+       *
+       * \copydetails computeHessian
+       */
+      template<typename Func, typename VecIn, typename VecOut, typename T, typename Jac = DummyJacobian>
+      static void computeSparseHessian(Func func, VecIn& input, VecOut& output, SparseHessian<T>& hes,
+                                       Jac& jac = StaticDummy<DummyJacobian>::dummy) {
+        using GT2nd = GradientTraits::TraitsImplementation<CODI_DD(typename Real::Gradient, double)>;
+        size_t constexpr gradDim2nd = GT2nd::dim;
+
+        codiAssert(hes.getM() == output.size() && hes.getN() == input.size());
+
+        Tape& tape = Type::getTape();
+
+        std::vector<Identifier> inputIdentifiers;
+        std::vector<Identifier> outputIdentifiers;
+
+        // At least one evaluation for the Jacobian.
+        size_t const numberOfColors = std::max(hes.getNumberOfColors(), (size_t)1);
+
+        for (size_t firstColor = 0; firstColor < numberOfColors; firstColor += gradDim2nd) {
+          setColorGradient2ndOnCoDiValue(firstColor, hes.getColors(), input.data(), input.size(),
+                                         typename GT2nd::Real(1.0));
+
+          // Propagate the new derivative information.
+          recordTape(func, input, output, inputIdentifiers, outputIdentifiers);
+
+          recoverSparseHessian(tape, tape.getZeroPosition(), tape.getPosition(), inputIdentifiers.data(),
+                               inputIdentifiers.size(), outputIdentifiers.data(), outputIdentifiers.size(), firstColor,
+                               hes, jac);
+
+          setColorGradient2ndOnCoDiValue(firstColor, hes.getColors(), input.data(), input.size(),
+                                         typename GT2nd::Real());
+
+          tape.reset();
+        }
+      }
+
+      /**
+       * @brief Compute the products of the Hessians with multiple vectors with multiple tape recordings.
+       *
+       * The vectors are seeded as second order tangents of the inputs and a tape is recorded. Afterwards, the outputs
+       * are seeded and reverse evaluations are performed, see computeHessianVectorProductsPrimalValueTape. The
+       * algorithm will record ceil(count / GT2nd::dim) tapes.
+       *
+       * The prerequisites are the same as for computeHessian.
+       *
+       * #### Parameters
+       * [in]   __func__  The function for the recording of the tape. It needs to be a function object that
+       *                  will accept the call: func(input, output) \n
+       * [in]      __v__  The vectors, v[b * n + j] is the entry of input j in vector b.\n
+       * [in]  __count__  Number of vectors.\n
+       * [out]    __hv__  The products, hv[(b * m + i) * n + k] is the entry k of \f$ H_i v_b \f$.
+       */
+      template<typename Func, typename VecIn, typename VecOut, typename T>
+      static void computeHessianVectorProducts(Func func, VecIn& input, VecOut& output, T const* v, size_t const count,
+                                               T* hv) {
+        using GT2nd = GradientTraits::TraitsImplementation<CODI_DD(typename Real::Gradient, double)>;
+        size_t constexpr gradDim2nd = GT2nd::dim;
+
+        Tape& tape = Type::getTape();
+
+        std::vector<Identifier> inputIdentifiers;
+        std::vector<Identifier> outputIdentifiers;
+
+        for (size_t b = 0; b < count; b += gradDim2nd) {
+          for (size_t j = 0; j < input.size(); j += 1) {
+            for (size_t vecPos2nd = 0; vecPos2nd < gradDim2nd && b + vecPos2nd < count; vecPos2nd += 1) {
+              GT2nd::at(input[j].value().gradient(), vecPos2nd) = v[(b + vecPos2nd) * input.size() + j];
+            }
+          }
+
+          // Propagate the new derivative information.
+          recordTape(func, input, output, inputIdentifiers, outputIdentifiers);
+
+          extractHessianVectorProducts(tape, tape.getZeroPosition(), tape.getPosition(), inputIdentifiers.data(),
+                                       inputIdentifiers.size(), outputIdentifiers.data(), outputIdentifiers.size(), b,
+                                       count, hv);
+
+          for (size_t j = 0; j < input.size(); j += 1) {
+            input[j].value().gradient() = typename Real::Gradient();
+          }
+
+          tape.reset();
+        }
+      }
+
     private:
 
+      /// Computes the index sets of the left hand sides, see computeSparsityPattern.
+      struct IndexSetPropagation {
+        public:
+          std::vector<std::vector<size_t>>& indexSets;  ///< Index set for each identifier.
+          std::vector<Identifier>& touched;             ///< Identifiers whose set became nonempty.
+          bool& hasLowLevelFunctions;                   ///< Set if a low level function is found.
+          std::vector<size_t> lhsSet;                   ///< Workspace for the union.
+
+          /// See JacobianLinearTape::iterateStatements.
+          template<typename JacobianPointer, typename RhsIdentifierPointer>
+          void operator()(Identifier const& lhsIdentifier, Config::ArgumentSize const& numberOfArguments,
+                          JacobianPointer const& jacobians, RhsIdentifierPointer const& rhsIdentifiers,
+                          size_t const& argumentPos) {
+            if (Config::StatementLowLevelFunctionTag == numberOfArguments) {
+              hasLowLevelFunctions = true;
+            } else if (Config::StatementInputTag != numberOfArguments) {
+              lhsSet.clear();
+              for (size_t k = 0; k < numberOfArguments; k += 1) {
+                Identifier const rhsIdentifier = rhsIdentifiers[argumentPos + k];
+                if (Real() != (Real)jacobians[argumentPos + k] && (size_t)rhsIdentifier < indexSets.size()) {
+                  std::vector<size_t> const& rhsSet = indexSets[(size_t)rhsIdentifier];
+                  lhsSet.insert(lhsSet.end(), rhsSet.begin(), rhsSet.end());
+                }
+              }
+              std::sort(lhsSet.begin(), lhsSet.end());
+              lhsSet.erase(std::unique(lhsSet.begin(), lhsSet.end()), lhsSet.end());
+
+              if ((size_t)lhsIdentifier >= indexSets.size()) {
+                indexSets.resize((size_t)lhsIdentifier + 1);
+              }
+              // The old set of the overwritten identifier is released.
+              std::vector<size_t>& set = indexSets[(size_t)lhsIdentifier];
+              if (lhsSet.empty()) {
+                std::vector<size_t>().swap(set);
+              } else {
+                if (set.empty()) {
+                  touched.push_back(lhsIdentifier);
+                }
+                set.assign(lhsSet.begin(), lhsSet.end());
+              }
+            }
+          }
+      };
+
+      /**
+       * @brief Reverse sweeps for all outputs with seeded second order tangents of the inputs j to j + GT2nd::dim.
+       *
+       * Adds the inputs k with a nonzero Hessian entry (j, k) for any output to rows[j].
+       */
+      static void addHessianPatternEntries(Tape& tape, Position const& start, Position const& end,
+                                           Identifier const* input, size_t const inputSize, Identifier const* output,
+                                           size_t const outputSize, size_t const j,
+                                           std::vector<std::vector<size_t>>& rows) {
+        using GT1st = GT;
+        size_t constexpr gradDim1st = GT1st::dim;
+        using GT2nd = GradientTraits::TraitsImplementation<CODI_DD(typename Real::Gradient, double)>;
+        size_t constexpr gradDim2nd = GT2nd::dim;
+
+        for (size_t i = 0; i < outputSize; i += gradDim1st) {
+          setGradientOnIdentifier(tape, i, output, outputSize, typename GT1st::Real(1.0));
+
+          // Propagate the derivatives backward for second order derivatives.
+          tape.evaluateKeepState(end, start);
+
+          for (size_t k = 0; k < inputSize; k += 1) {
+            for (size_t vecPos1st = 0; vecPos1st < gradDim1st && i + vecPos1st < outputSize; vecPos1st += 1) {
+              for (size_t vecPos2nd = 0; vecPos2nd < gradDim2nd && j + vecPos2nd < inputSize; vecPos2nd += 1) {
+                if (typename GT2nd::Real() !=
+                    GT2nd::at(GT1st::at(tape.gradient(input[k]), vecPos1st).gradient(), vecPos2nd)) {
+                  rows[j + vecPos2nd].push_back(k);
+                }
+              }
+            }
+
+            tape.gradient(input[k]) = Gradient();
+          }
+
+          setGradientOnIdentifier(tape, i, output, outputSize, typename GT1st::Real());
+
+          if (!Config::ReversalZeroesAdjoints) {
+            tape.clearAdjoints(end, start);
+          }
+        }
+      }
+
+      /// Create a symmetric pattern from the entries in rows. The entries may be unsorted and contain duplicates.
+      static void createSymmetricPattern(std::vector<std::vector<size_t>>& rows, SparsityPattern& pattern) {
+        size_t const n = rows.size();
+        for (size_t j = 0; j < n; j += 1) {
+          for (size_t const k : rows[j]) {
+            if (k != j) {
+              rows[k].push_back(j);
+            }
+          }
+        }
+
+        pattern.reset(n);
+        for (size_t j = 0; j < n; j += 1) {
+          std::sort(rows[j].begin(), rows[j].end());
+          rows[j].erase(std::unique(rows[j].begin(), rows[j].end()), rows[j].end());
+          for (size_t const k : rows[j]) {
+            pattern.addEntry(k);
+          }
+          pattern.finishRow();
+        }
+      }
+
+      /**
+       * @brief Reverse sweeps for all outputs with seeded second order tangents of the colors firstColor to
+       * firstColor + GT2nd::dim.
+       *
+       * Recovers the entries of hes from these colors. The Jacobian is extracted for the first colors.
+       */
+      template<typename T, typename Jac>
+      static void recoverSparseHessian(Tape& tape, Position const& start, Position const& end, Identifier const* input,
+                                       size_t const inputSize, Identifier const* output, size_t const outputSize,
+                                       size_t const firstColor, SparseHessian<T>& hes, Jac& jac) {
+        using GT1st = GT;
+        size_t constexpr gradDim1st = GT1st::dim;
+        using GT2nd = GradientTraits::TraitsImplementation<CODI_DD(typename Real::Gradient, double)>;
+        size_t constexpr gradDim2nd = GT2nd::dim;
+
+        size_t const nonZeros = hes.getPattern().getNonZeros();
+
+        for (size_t i = 0; i < outputSize; i += gradDim1st) {
+          setGradientOnIdentifier(tape, i, output, outputSize, typename GT1st::Real(1.0));
+
+          // Propagate the derivatives backward for second order derivatives.
+          tape.evaluateKeepState(end, start);
+
+          for (size_t pos = 0; pos < nonZeros; pos += 1) {
+            size_t const color = hes.getRecoveryColor(pos);
+            if (firstColor <= color && color < firstColor + gradDim2nd) {
+              Gradient const& adjoint = tape.getGradient(input[hes.getRecoveryRow(pos)]);
+              for (size_t vecPos1st = 0; vecPos1st < gradDim1st && i + vecPos1st < outputSize; vecPos1st += 1) {
+                hes.value(i + vecPos1st, pos) = GT2nd::at(GT1st::at(adjoint, vecPos1st).gradient(), color - firstColor);
+              }
+            }
+          }
+
+          for (size_t k = 0; k < inputSize; k += 1) {
+            if (firstColor == 0) {
+              for (size_t vecPos1st = 0; vecPos1st < gradDim1st && i + vecPos1st < outputSize; vecPos1st += 1) {
+                jac(i + vecPos1st, k) = GT1st::at(tape.getGradient(input[k]), vecPos1st).value();
+              }
+            }
+
+            tape.gradient(input[k]) = Gradient();
+          }
+
+          setGradientOnIdentifier(tape, i, output, outputSize, typename GT1st::Real());
+
+          if (!Config::ReversalZeroesAdjoints) {
+            tape.clearAdjoints(end, start);
+          }
+        }
+      }
+
+      /// Reverse sweeps for all outputs with seeded second order tangents of the vectors b to b + GT2nd::dim.
+      template<typename T>
+      static void extractHessianVectorProducts(Tape& tape, Position const& start, Position const& end,
+                                               Identifier const* input, size_t const inputSize,
+                                               Identifier const* output, size_t const outputSize, size_t const b,
+                                               size_t const count, T* hv) {
+        using GT1st = GT;
+        size_t constexpr gradDim1st = GT1st::dim;
+        using GT2nd = GradientTraits::TraitsImplementation<CODI_DD(typename Real::Gradient, double)>;
+        size_t constexpr gradDim2nd = GT2nd::dim;
+
+        for (size_t i = 0; i < outputSize; i += gradDim1st) {
+          setGradientOnIdentifier(tape, i, output, outputSize, typename GT1st::Real(1.0));
+
+          // Propagate the derivatives backward for second order derivatives.
+          tape.evaluateKeepState(end, start);
+
+          for (size_t k = 0; k < inputSize; k += 1) {
+            for (size_t vecPos1st = 0; vecPos1st < gradDim1st && i + vecPos1st < outputSize; vecPos1st += 1) {
+              for (size_t vecPos2nd = 0; vecPos2nd < gradDim2nd && b + vecPos2nd < count; vecPos2nd += 1) {
+                hv[((b + vecPos2nd) * outputSize + i + vecPos1st) * inputSize + k] =
+                    GT2nd::at(GT1st::at(tape.gradient(input[k]), vecPos1st).gradient(), vecPos2nd);
+              }
+            }
+
+            tape.gradient(input[k]) = Gradient();
+          }
+
+          setGradientOnIdentifier(tape, i, output, outputSize, typename GT1st::Real());
+
+          if (!Config::ReversalZeroesAdjoints) {
+            tape.clearAdjoints(end, start);
+          }
+        }
+      }
+
+      /// Store a gradient entry in a sparse Jacobian of the same type.
+      template<typename T>
+      static CODI_INLINE void setSparseEntry(T& entry, T const& value) {
+        entry = value;
+      }
+
+      /// Store a gradient entry in a sparse Jacobian of a passive type.
+      template<typename T, typename V>
+      static CODI_INLINE void setSparseEntry(T& entry, V const& value) {
+        entry = RealTraits::getPassiveValue(value);
+      }
+
       /**
        * @brief Sets the gradient for vector modes. Seeds the next GT::dim dimensions.
        *
@@ -571,6 +1408,23 @@ namespace codi {
         }
       }
 
+      /// Sets the gradient for 2nd order vector modes. Seeds the identifiers of the next GT2nd:dim colors.
+      template<typename T>
+      static CODI_INLINE void setColorGradient2ndOnIdentifier(Tape& tape, size_t const firstColor,
+                                                              std::vector<size_t> const& colors,
+                                                              Identifier const* identifiers, size_t const size,
+                                                              T value) {
+        using GT2nd = GradientTraits::TraitsImplementation<CODI_DD(typename Real::Gradient, double)>;
+        size_t constexpr gradDim2nd = GT2nd::dim;
+
+        for (size_t pos = 0; pos < size; pos += 1) {
+          if (firstColor <= colors[pos] && colors[pos] < firstColor + gradDim2nd) {
+            // No activity check on the identifier required since forward types are used.
+            GT2nd::at(tape.primal(identifiers[pos]).gradient(), colors[pos] - firstColor) = value;
+          }
+        }
+      }
+
       /**
        * @brief Sets the gradient for 1st order vector modes. Seeds the next GT:dim dimensions.
        *
@@ -602,6 +1456,21 @@ namespace codi {
         }
       }
 
+      /// Sets the gradient for 2nd order vector modes. Seeds the values of the next GT2nd:dim colors.
+      template<typename T>
+      static CODI_INLINE void setColorGradient2ndOnCoDiValue(size_t const firstColor, std::vector<size_t> const& colors,
+                                                             Type* identifiers, size_t const size, T value) {
+        using GT2nd = GradientTraits::TraitsImplementation<CODI_DD(typename Real::Gradient, double)>;
+        size_t constexpr gradDim2nd = GT2nd::dim;
+
+        for (size_t pos = 0; pos < size; pos += 1) {
+          if (firstColor <= colors[pos] && colors[pos] < firstColor + gradDim2nd) {
+            // No activity check on the identifier required since forward types are used.
+            GT2nd::at(identifiers[pos].value().gradient(), colors[pos] - firstColor) = value;
+          }
+        }
+      }
+
       /// Record an evalaution of the function.
       template<typename Func, typename VecIn, typename VecOut>
       static CODI_INLINE void recordTape(Func func, VecIn& input, VecOut& output) {
@@ -618,6 +1487,23 @@ namespace codi {
         }
         tape.setPassive();
       }
+
+      /// Record an evaluation of the function and store the identifiers of the inputs and outputs.
+      template<typename Func, typename VecIn, typename VecOut>
+      static CODI_INLINE void recordTape(Func func, VecIn& input, VecOut& output,
+                                         std::vector<Identifier>& inputIdentifiers,
+                                         std::vector<Identifier>& outputIdentifiers) {
+        recordTape(func, input, output);
+
+        inputIdentifiers.resize(input.size());
+        for (size_t curIn = 0; curIn < input.size(); curIn += 1) {
+          inputIdentifiers[curIn] = input[curIn].getIdentifier();
+        }
+        outputIdentifiers.resize(output.size());
+        for (size_t curOut = 0; curOut < output.size(); curOut += 1) {
+          outputIdentifiers[curOut] = output[curOut].getIdentifier();
+        }
+      }
   };
 
 }
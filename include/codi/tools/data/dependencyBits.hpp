@@ -0,0 +1,157 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "../../config.h"
+#include "../../misc/macros.hpp"
+#include "../../traits/atomicTraits.hpp"
+#include "../../traits/gradientTraits.hpp"
+#include "staticDummy.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+  /**
+   * @brief Adjoint type for the propagation of dependencies with custom adjoint vector evaluations.
+   *
+   * Bit k is set if the value depends on the k-th seeded input. A forward evaluation of the tape with a vector of
+   * DependencyBits computes the dependencies of the outputs on up to 64 inputs at once. A product with a nonzero
+   * Jacobian keeps the bits, an addition combines them.
+   *
+   * The type has no numeric entries, the dimension in GradientTraits is zero.
+   *
+   * @tparam T_Real  The computation type of the tape, usually chosen as ActiveType::Real.
+   */
+  template<typename T_Real>
+  struct DependencyBits {
+    public:
+
+      using Real = CODI_DD(T_Real, double);  ///< See DependencyBits.
+
+      using Word = uint64_t;              ///< Storage type of the bits.
+      static size_t constexpr Size = 64;  ///< Number of inputs that are covered by one word.
+
+      Word bits;  ///< Bit k is set if the value depends on input k.
+
+      /// Constructor
+      CODI_INLINE DependencyBits() : bits(0) {}
+
+      /// Set the dependency on input k.
+      CODI_INLINE void set(size_t const k) {
+        bits |= Word(1) << k;
+      }
+
+      /// Combine the dependencies.
+      CODI_INLINE DependencyBits& operator+=(DependencyBits const& other) {
+        bits |= other.bits;
+        return *this;
+      }
+
+      /// Dependencies are kept if the Jacobian is not zero.
+      CODI_INLINE friend DependencyBits operator*(Real const& jacobian, DependencyBits const& v) {
+        DependencyBits result;
+        if (Real() != jacobian) {
+          result.bits = v.bits;
+        }
+        return result;
+      }
+
+      /// Equal if the same dependencies are set.
+      CODI_INLINE bool operator==(DependencyBits const& other) const {
+        return bits == other.bits;
+      }
+
+      /// Not equal if different dependencies are set.
+      CODI_INLINE bool operator!=(DependencyBits const& other) const {
+        return bits != other.bits;
+      }
+
+      /// Call func(k) for each set bit k in ascending order.
+      template<typename Func>
+      CODI_INLINE static void forEach(Word word, Func&& func) {
+        while (0 != word) {
+          func(countTrailingZeros(word));
+          word &= word - 1;
+        }
+      }
+
+    private:
+
+      static CODI_INLINE size_t countTrailingZeros(Word const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return (size_t)__builtin_ctzll(value);
+#else
+        size_t result = 0;
+        while (0 == (value & (Word(1) << result))) {
+          result += 1;
+        }
+        return result;
+#endif
+      }
+  };
+
+#ifndef DOXYGEN_DISABLE
+  namespace GradientTraits {
+
+    template<typename T_Real>
+    struct TraitsImplementation<DependencyBits<T_Real>> {
+      public:
+
+        using Gradient = DependencyBits<T_Real>;
+        using Real = T_Real;
+
+        static size_t constexpr dim = 0;
+
+        CODI_INLINE static Real& at(Gradient& gradient, size_t dim) {
+          CODI_UNUSED(gradient, dim);
+          return StaticDummy<Real>::dummy;
+        }
+
+        CODI_INLINE static Real const& at(Gradient const& gradient, size_t dim) {
+          CODI_UNUSED(gradient, dim);
+          return StaticDummy<Real>::dummy;
+        }
+
+        CODI_INLINE static std::array<AtomicTraits::RemoveAtomic<Real>, dim> toArray(Gradient const& gradient) {
+          CODI_UNUSED(gradient);
+          return std::array<AtomicTraits::RemoveAtomic<Real>, dim>{};
+        }
+    };
+  }
+#endif
+}
@@ -34,6 +34,7 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <initializer_list>
 
 #include "../../config.h"
@@ -41,6 +42,7 @@
 #include "../../traits/atomicTraits.hpp"
 #include "../../traits/gradientTraits.hpp"
 #include "../../traits/realTraits.hpp"
+#include "directionOperations.hpp"
 
 /** \copydoc codi::Namespace */
 namespace codi {
@@ -50,19 +52,33 @@ namespace codi {
    *
    * Can be used as the gradient template argument in active CoDiPack types.
    *
-   * @tparam T_Real  Type of the vector entries.
-   * @tparam T_dim  Dimension of the vector mode.
+   * If the alignment allows to process all entries with vector registers, the component wise operations use the
+   * vector instructions explicitly, see DirectionOperations. AlignedDirection selects such an alignment for the
+   * instruction set enabled by the compiler flags.
+   *
+   * @tparam T_Real       Type of the vector entries.
+   * @tparam T_dim        Dimension of the vector mode.
+   * @tparam T_alignment  Alignment of the vector entries.
    */
-  template<typename T_Real, size_t T_dim>
+  template<typename T_Real, size_t T_dim, size_t T_alignment>
   struct Direction {
     public:
 
       using Real = CODI_DD(T_Real, double);  ///< See Direction.
 
-      static size_t constexpr dim = T_dim;  ///< See Direction.
+      static size_t constexpr dim = T_dim;              ///< See Direction.
+      static size_t constexpr alignment = T_alignment;  ///< See Direction.
+
+      using Operations = DirectionOperations<Real, dim, alignment>;  ///< Implementation of the operations.
+
+      /// Alignment of the storage. Before C++17, new and std::allocator do not respect extended alignments, so these
+      /// are not requested. Since C++17, the chunk memory resources and the PolicyAllocator pass the alignment to the
+      /// aligned operator new or the mapping, see ChunkMemoryResource. The operations do not require the alignment.
+      static size_t constexpr StorageAlignment =
+          CODI_IS_CPP17 || alignment <= alignof(std::max_align_t) ? alignment : alignof(Real);
 
     private:
-      Real vector[dim];
+      alignas(StorageAlignment) Real vector[dim];
 
     public:
 
@@ -70,17 +86,13 @@ namespace codi {
       CODI_INLINE Direction() : vector() {}
 
       /// Constructor
-      CODI_INLINE Direction(Real const& s) : vector() {
-        for (size_t i = 0; i < dim; ++i) {
-          vector[i] = s;
-        }
+      CODI_INLINE Direction(Real const& s) {
+        Operations::set(vector, s);
       }
 
       /// Constructor
-      CODI_INLINE Direction(Direction const& v) : vector() {
-        for (size_t i = 0; i < dim; ++i) {
-          vector[i] = v.vector[i];
-        }
+      CODI_INLINE Direction(Direction const& v) {
+        Operations::copy(vector, v.vector);
       }
 
       /// Constructor
@@ -102,52 +114,66 @@ namespace codi {
         return vector[i];
       }
 
+      /// Pointer to the entries.
+      CODI_INLINE Real* data() {
+        return vector;
+      }
+
+      /// Pointer to the entries.
+      CODI_INLINE Real const* data() const {
+        return vector;
+      }
+
       /// Assignment operator.
       CODI_INLINE Direction& operator=(Direction const& v) {
-        for (size_t i = 0; i < dim; ++i) {
-          this->vector[i] = v.vector[i];
-        }
+        Operations::copy(this->vector, v.vector);
 
         return *this;
       }
 
       /// Update operator.
       CODI_INLINE Direction& operator+=(Direction const& v) {
-        for (size_t i = 0; i < dim; ++i) {
-          this->vector[i] += v.vector[i];
-        }
+        Operations::addAssign(this->vector, v.vector);
 
         return *this;
       }
 
       /// Update operator.
       CODI_INLINE Direction& operator-=(Direction const& v) {
-        for (size_t i = 0; i < dim; ++i) {
-          this->vector[i] -= v.vector[i];
-        }
+        Operations::subAssign(this->vector, v.vector);
 
         return *this;
       }
   };
 
+  template<typename Real, size_t dim, size_t alignment>
+  size_t constexpr Direction<Real, dim, alignment>::dim;
+
+  template<typename Real, size_t dim, size_t alignment>
+  size_t constexpr Direction<Real, dim, alignment>::alignment;
+
+  template<typename Real, size_t dim, size_t alignment>
+  size_t constexpr Direction<Real, dim, alignment>::StorageAlignment;
+
+  /// Direction with an alignment that allows the explicit vectorization of all operations, see
+  /// GradientTraits::SimdAlignment.
   template<typename Real, size_t dim>
-  size_t constexpr Direction<Real, dim>::dim;
+  using AlignedDirection = Direction<Real, dim, GradientTraits::SimdAlignment<Real, dim>::value>;
 
   /// Multiplication with a scalar.
-  template<typename Real, size_t dim>
-  CODI_INLINE Direction<Real, dim> operator*(Real const& s, Direction<Real, dim> const& v) {
-    Direction<Real, dim> r;
-    for (size_t i = 0; i < dim; ++i) {
-      r[i] = s * v[i];
-    }
+  template<typename Real, size_t dim, size_t alignment>
+  CODI_INLINE Direction<Real, dim, alignment> operator*(Real const& s, Direction<Real, dim, alignment> const& v) {
+    Direction<Real, dim, alignment> r;
+    Direction<Real, dim, alignment>::Operations::scale(r.data(), s, v.data());
 
     return r;
   }
 
   /// Multiplication with a passive scalar.
-  template<typename Real, size_t dim, typename = RealTraits::EnableIfNotPassiveReal<Real>>
-  CODI_INLINE Direction<Real, dim> operator*(RealTraits::PassiveReal<Real> const& s, Direction<Real, dim> const& v) {
-    Direction<Real, dim> r;
+  template<typename Real, size_t dim, size_t alignment, typename = RealTraits::EnableIfNotPassiveReal<Real>>
+  CODI_INLINE Direction<Real, dim, alignment> operator*(RealTraits::PassiveReal<Real> const& s,
+                                                        Direction<Real, dim, alignment> const& v) {
+    Direction<Real, dim, alignment> r;
     for (size_t i = 0; i < dim; ++i) {
       r[i] = s * v[i];
     }
@@ -156,9 +182,10 @@ namespace codi {
   }
 
   /// Multiplication of a non-atomic scalar with a direction that has atomic reals.
-  template<typename Real, size_t dim, typename = AtomicTraits::EnableIfAtomic<Real>>
-  CODI_INLINE Direction<Real, dim> operator*(AtomicTraits::RemoveAtomic<Real> const& s, Direction<Real, dim> const& v) {
-    Direction<Real, dim> r;
+  template<typename Real, size_t dim, size_t alignment, typename = AtomicTraits::EnableIfAtomic<Real>>
+  CODI_INLINE Direction<Real, dim, alignment> operator*(AtomicTraits::RemoveAtomic<Real> const& s,
+                                                        Direction<Real, dim, alignment> const& v) {
+    Direction<Real, dim, alignment> r;
     for (size_t i = 0; i < dim; ++i) {
       r[i] = s * v[i];
     }
@@ -167,38 +194,39 @@ namespace codi {
   }
 
   /// Multiplication with a scalar.
-  template<typename Real, size_t dim>
-  CODI_INLINE Direction<Real, dim> operator*(Direction<Real, dim> const& v, Real const& s) {
+  template<typename Real, size_t dim, size_t alignment>
+  CODI_INLINE Direction<Real, dim, alignment> operator*(Direction<Real, dim, alignment> const& v, Real const& s) {
     return s * v;
   }
 
   /// Multiplication with passive a scalar.
-  template<typename Real, size_t dim, typename = RealTraits::EnableIfNotPassiveReal<Real>>
-  CODI_INLINE Direction<Real, dim> operator*(Direction<Real, dim> const& v, RealTraits::PassiveReal<Real> const& s) {
+  template<typename Real, size_t dim, size_t alignment, typename = RealTraits::EnableIfNotPassiveReal<Real>>
+  CODI_INLINE Direction<Real, dim, alignment> operator*(Direction<Real, dim, alignment> const& v,
+                                                        RealTraits::PassiveReal<Real> const& s) {
     return s * v;
   }
 
   /// Multiplication of a non-atomic scalar with a direction that has atomic reals.
-  template<typename Real, size_t dim, typename = AtomicTraits::EnableIfAtomic<Real>>
-  CODI_INLINE Direction<Real, dim> operator*(Direction<Real, dim> const& v, AtomicTraits::RemoveAtomic<Real> const& s) {
+  template<typename Real, size_t dim, size_t alignment, typename = AtomicTraits::EnableIfAtomic<Real>>
+  CODI_INLINE Direction<Real, dim, alignment> operator*(Direction<Real, dim, alignment> const& v,
+                                                        AtomicTraits::RemoveAtomic<Real> const& s) {
     return s * v;
   }
 
   /// Division by a scalar.
-  template<typename Real, size_t dim>
-  CODI_INLINE Direction<Real, dim> operator/(Direction<Real, dim> const& v, Real const& s) {
-    Direction<Real, dim> r;
-    for (size_t i = 0; i < dim; ++i) {
-      r[i] = v[i] / s;
-    }
+  template<typename Real, size_t dim, size_t alignment>
+  CODI_INLINE Direction<Real, dim, alignment> operator/(Direction<Real, dim, alignment> const& v, Real const& s) {
+    Direction<Real, dim, alignment> r;
+    Direction<Real, dim, alignment>::Operations::divide(r.data(), v.data(), s);
 
     return r;
   }
 
   /// Division by a passive scalar.
-  template<typename Real, size_t dim, typename = RealTraits::EnableIfNotPassiveReal<Real>>
-  CODI_INLINE Direction<Real, dim> operator/(Direction<Real, dim> const& v, RealTraits::PassiveReal<Real> const& s) {
-    Direction<Real, dim> r;
+  template<typename Real, size_t dim, size_t alignment, typename = RealTraits::EnableIfNotPassiveReal<Real>>
+  CODI_INLINE Direction<Real, dim, alignment> operator/(Direction<Real, dim, alignment> const& v,
+                                                        RealTraits::PassiveReal<Real> const& s) {
+    Direction<Real, dim, alignment> r;
     for (size_t i = 0; i < dim; ++i) {
       r[i] = v[i] / s;
     }
@@ -207,9 +235,10 @@ namespace codi {
   }
 
   /// Division of a direction with atomic reals by a non-atomic scalar.
-  template<typename Real, size_t dim, typename = AtomicTraits::EnableIfAtomic<Real>>
-  CODI_INLINE Direction<Real, dim> operator/(Direction<Real, dim> const& v, AtomicTraits::RemoveAtomic<Real> const& s) {
-    Direction<Real, dim> r;
+  template<typename Real, size_t dim, size_t alignment, typename = AtomicTraits::EnableIfAtomic<Real>>
+  CODI_INLINE Direction<Real, dim, alignment> operator/(Direction<Real, dim, alignment> const& v,
+                                                        AtomicTraits::RemoveAtomic<Real> const& s) {
+    Direction<Real, dim, alignment> r;
     for (size_t i = 0; i < dim; ++i) {
       r[i] = v[i] / s;
     }
@@ -218,59 +247,55 @@ namespace codi {
   }
 
   /// Summation of two vectors.
-  template<typename Real, size_t dim>
-  CODI_INLINE Direction<Real, dim> operator+(Direction<Real, dim> const& v1, Direction<Real, dim> const& v2) {
-    Direction<Real, dim> r;
-    for (size_t i = 0; i < dim; ++i) {
-      r[i] = v1[i] + v2[i];
-    }
+  template<typename Real, size_t dim, size_t alignment>
+  CODI_INLINE Direction<Real, dim, alignment> operator+(Direction<Real, dim, alignment> const& v1,
+                                                        Direction<Real, dim, alignment> const& v2) {
+    Direction<Real, dim, alignment> r;
+    Direction<Real, dim, alignment>::Operations::add(r.data(), v1.data(), v2.data());
 
     return r;
   }
 
   /// Subtraction of two vectors.
-  template<typename Real, size_t dim>
-  CODI_INLINE Direction<Real, dim> operator-(Direction<Real, dim> const& v1, Direction<Real, dim> const& v2) {
-    Direction<Real, dim> r;
-    for (size_t i = 0; i < dim; ++i) {
-      r[i] = v1[i] - v2[i];
-    }
+  template<typename Real, size_t dim, size_t alignment>
+  CODI_INLINE Direction<Real, dim, alignment> operator-(Direction<Real, dim, alignment> const& v1,
+                                                        Direction<Real, dim, alignment> const& v2) {
+    Direction<Real, dim, alignment> r;
+    Direction<Real, dim, alignment>::Operations::sub(r.data(), v1.data(), v2.data());
 
     return r;
   }
 
   /// Negation.
-  template<typename Real, size_t dim>
-  CODI_INLINE Direction<Real, dim> operator-(Direction<Real, dim> const& v) {
-    Direction<Real, dim> r;
-    for (size_t i = 0; i < dim; ++i) {
-      r[i] = -v[i];
-    }
+  template<typename Real, size_t dim, size_t alignment>
+  CODI_INLINE Direction<Real, dim, alignment> operator-(Direction<Real, dim, alignment> const& v) {
+    Direction<Real, dim, alignment> r;
+    Direction<Real, dim, alignment>::Operations::neg(r.data(), v.data());
 
     return r;
   }
 
   /// Component-wise test for inequality. True if at least one component differs.
-  template<typename Real, size_t dim>
-  CODI_INLINE bool operator!=(Direction<Real, dim> const& v1, Direction<Real, dim> const& v2) {
+  template<typename Real, size_t dim, size_t alignment>
+  CODI_INLINE bool operator!=(Direction<Real, dim, alignment> const& v1, Direction<Real, dim, alignment> const& v2) {
     return !(v1 == v2);
   }
 
   /// Component-wise test for inequality with scalar. True if at least one component differs.
-  template<typename A, typename Real, size_t dim>
-  CODI_INLINE bool operator!=(A const& s, Direction<Real, dim> const& v) {
+  template<typename A, typename Real, size_t dim, size_t alignment>
+  CODI_INLINE bool operator!=(A const& s, Direction<Real, dim, alignment> const& v) {
     return !(s == v);
   }
 
   /// Component-wise test for inequality with scalar. True if at least one component differs.
-  template<typename A, typename Real, size_t dim>
-  CODI_INLINE bool operator!=(Direction<Real, dim> const& v, A const& s) {
+  template<typename A, typename Real, size_t dim, size_t alignment>
+  CODI_INLINE bool operator!=(Direction<Real, dim, alignment> const& v, A const& s) {
     return s != v;
   }
 
   /// Component-wise test for equality. True if all components match.
-  template<typename Real, size_t dim>
-  CODI_INLINE bool operator==(Direction<Real, dim> const& v1, Direction<Real, dim> const& v2) {
+  template<typename Real, size_t dim, size_t alignment>
+  CODI_INLINE bool operator==(Direction<Real, dim, alignment> const& v1, Direction<Real, dim, alignment> const& v2) {
     for (size_t i = 0; i < dim; ++i) {
       if (v1[i] != v2[i]) {
         return false;
@@ -281,8 +306,8 @@ namespace codi {
   }
 
   /// Component-wise test for equality with scalar. True if all components match.
-  template<typename A, typename Real, size_t dim>
-  CODI_INLINE bool operator==(A const& s, Direction<Real, dim> const& v) {
+  template<typename A, typename Real, size_t dim, size_t alignment>
+  CODI_INLINE bool operator==(A const& s, Direction<Real, dim, alignment> const& v) {
     for (size_t i = 0; i < dim; ++i) {
       if (s != v[i]) {
         return false;
@@ -293,14 +318,14 @@ namespace codi {
   }
 
   /// Component-wise test for equality with scalar. True if all components match.
-  template<typename A, typename Real, size_t dim>
-  CODI_INLINE bool operator==(Direction<Real, dim> const& v, A const& s) {
+  template<typename A, typename Real, size_t dim, size_t alignment>
+  CODI_INLINE bool operator==(Direction<Real, dim, alignment> const& v, A const& s) {
     return s == v;
   }
 
   /// Output stream operator.
-  template<typename Real, size_t dim>
-  std::ostream& operator<<(std::ostream& os, Direction<Real, dim> const& v) {
+  template<typename Real, size_t dim, size_t alignment>
+  std::ostream& operator<<(std::ostream& os, Direction<Real, dim, alignment> const& v) {
     os << "{";
     for (size_t i = 0; i < dim; ++i) {
       if (i != 0) {
@@ -0,0 +1,265 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(__AVX2__) || defined(__AVX512F__)
+  #include <immintrin.h>
+#endif
+
+#include "../../config.h"
+#include "../../misc/macros.hpp"
+#include "../../traits/gradientTraits.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+  /**
+   * @brief Access to the vector registers for entries of type Real with a width of registerSize bytes.
+   *
+   * Specializations exist for float and double if the instruction set is enabled, see
+   * GradientTraits::NativeSimdInstructionSet. Loads and stores are unaligned, since containers respect extended
+   * alignments only with C++17. On current hardware there is no penalty for unaligned instructions on aligned data.
+   *
+   * @tparam T_Real        Type of the entries.
+   * @tparam registerSize  Size of the register in bytes.
+   */
+  template<typename T_Real, size_t registerSize, typename = void>
+  struct SimdRegister {
+    public:
+
+      using Real = CODI_DD(T_Real, double);  ///< See SimdRegister.
+
+      static bool constexpr IsSupported = false;  ///< True if there is a specialization for the type and size.
+  };
+
+#ifndef DOXYGEN_DISABLE
+  #define CODI_SIMD_REGISTER(REAL, SIZE, TYPE, SUFFIX, PREFIX)                               \
+    template<>                                                                              \
+    struct SimdRegister<REAL, SIZE> {                                                       \
+      public:                                                                               \
+        using Real = REAL;                                                                  \
+        using Type = TYPE;                                                                  \
+                                                                                            \
+        static bool constexpr IsSupported = true;                                           \
+                                                                                            \
+        static CODI_INLINE Type load(Real const* p) {                                      \
+          return PREFIX##_loadu_##SUFFIX(p);                                                \
+        }                                                                                   \
+        static CODI_INLINE void store(Real* p, Type const& v) {                            \
+          PREFIX##_storeu_##SUFFIX(p, v);                                                   \
+        }                                                                                   \
+        static CODI_INLINE Type set(Real const& s) {                                       \
+          return PREFIX##_set1_##SUFFIX(s);                                                 \
+        }                                                                                   \
+        static CODI_INLINE Type add(Type const& a, Type const& b) {                         \
+          return PREFIX##_add_##SUFFIX(a, b);                                               \
+        }                                                                                   \
+        static CODI_INLINE Type sub(Type const& a, Type const& b) {                         \
+          return PREFIX##_sub_##SUFFIX(a, b);                                               \
+        }                                                                                   \
+        static CODI_INLINE Type mul(Type const& a, Type const& b) {                         \
+          return PREFIX##_mul_##SUFFIX(a, b);                                               \
+        }                                                                                   \
+        static CODI_INLINE Type div(Type const& a, Type const& b) {                         \
+          return PREFIX##_div_##SUFFIX(a, b);                                               \
+        }                                                                                   \
+    }
+
+  #if defined(__SSE2__) || defined(__AVX2__) || defined(__AVX512F__)
+  CODI_SIMD_REGISTER(double, 16, __m128d, pd, _mm);
+  CODI_SIMD_REGISTER(float, 16, __m128, ps, _mm);
+  #endif
+  #if defined(__AVX2__) || defined(__AVX512F__)
+  CODI_SIMD_REGISTER(double, 32, __m256d, pd, _mm256);
+  CODI_SIMD_REGISTER(float, 32, __m256, ps, _mm256);
+  #endif
+  #if defined(__AVX512F__)
+  CODI_SIMD_REGISTER(double, 64, __m512d, pd, _mm512);
+  CODI_SIMD_REGISTER(float, 64, __m512, ps, _mm512);
+  #endif
+
+  #undef CODI_SIMD_REGISTER
+#endif
+
+  /**
+   * @brief Implementation of the component wise operations of Direction.
+   *
+   * The default implementation uses loops. If the alignment of the direction allows to process all entries with a
+   * SimdRegister, the specialization uses the vector instructions explicitly.
+   *
+   * @tparam T_Real     Type of the entries.
+   * @tparam dim        Number of entries.
+   * @tparam alignment  Alignment of the entries.
+   */
+  template<typename T_Real, size_t dim, size_t alignment, typename = void>
+  struct DirectionOperations {
+    public:
+
+      using Real = CODI_DD(T_Real, double);  ///< See DirectionOperations.
+
+      /// r[i] = s
+      static CODI_INLINE void set(Real* r, Real const& s) {
+        for (size_t i = 0; i < dim; ++i) {
+          r[i] = s;
+        }
+      }
+
+      /// r[i] = a[i]
+      static CODI_INLINE void copy(Real* r, Real const* a) {
+        for (size_t i = 0; i < dim; ++i) {
+          r[i] = a[i];
+        }
+      }
+
+      /// r[i] += a[i]
+      static CODI_INLINE void addAssign(Real* r, Real const* a) {
+        for (size_t i = 0; i < dim; ++i) {
+          r[i] += a[i];
+        }
+      }
+
+      /// r[i] -= a[i]
+      static CODI_INLINE void subAssign(Real* r, Real const* a) {
+        for (size_t i = 0; i < dim; ++i) {
+          r[i] -= a[i];
+        }
+      }
+
+      /// r[i] = a[i] + b[i]
+      static CODI_INLINE void add(Real* r, Real const* a, Real const* b) {
+        for (size_t i = 0; i < dim; ++i) {
+          r[i] = a[i] + b[i];
+        }
+      }
+
+      /// r[i] = a[i] - b[i]
+      static CODI_INLINE void sub(Real* r, Real const* a, Real const* b) {
+        for (size_t i = 0; i < dim; ++i) {
+          r[i] = a[i] - b[i];
+        }
+      }
+
+      /// r[i] = -a[i]
+      static CODI_INLINE void neg(Real* r, Real const* a) {
+        for (size_t i = 0; i < dim; ++i) {
+          r[i] = -a[i];
+        }
+      }
+
+      /// r[i] = s * a[i]
+      static CODI_INLINE void scale(Real* r, Real const& s, Real const* a) {
+        for (size_t i = 0; i < dim; ++i) {
+          r[i] = s * a[i];
+        }
+      }
+
+      /// r[i] = a[i] / s
+      static CODI_INLINE void divide(Real* r, Real const* a, Real const& s) {
+        for (size_t i = 0; i < dim; ++i) {
+          r[i] = a[i] / s;
+        }
+      }
+  };
+
+#ifndef DOXYGEN_DISABLE
+  template<typename T_Real, size_t dim, size_t alignment>
+  struct DirectionOperations<T_Real, dim, alignment,
+                             typename std::enable_if<SimdRegister<T_Real, alignment>::IsSupported &&
+                                                     0 == (dim * sizeof(T_Real)) % alignment>::type> {
+    public:
+
+      using Real = CODI_DD(T_Real, double);
+      using Register = SimdRegister<Real, alignment>;
+
+      static size_t constexpr Width = alignment / sizeof(Real);
+
+      static CODI_INLINE void set(Real* r, Real const& s) {
+        typename Register::Type const v = Register::set(s);
+        for (size_t i = 0; i < dim; i += Width) {
+          Register::store(&r[i], v);
+        }
+      }
+
+      static CODI_INLINE void copy(Real* r, Real const* a) {
+        for (size_t i = 0; i < dim; i += Width) {
+          Register::store(&r[i], Register::load(&a[i]));
+        }
+      }
+
+      static CODI_INLINE void addAssign(Real* r, Real const* a) {
+        add(r, r, a);
+      }
+
+      static CODI_INLINE void subAssign(Real* r, Real const* a) {
+        sub(r, r, a);
+      }
+
+      static CODI_INLINE void add(Real* r, Real const* a, Real const* b) {
+        for (size_t i = 0; i < dim; i += Width) {
+          Register::store(&r[i], Register::add(Register::load(&a[i]), Register::load(&b[i])));
+        }
+      }
+
+      static CODI_INLINE void sub(Real* r, Real const* a, Real const* b) {
+        for (size_t i = 0; i < dim; i += Width) {
+          Register::store(&r[i], Register::sub(Register::load(&a[i]), Register::load(&b[i])));
+        }
+      }
+
+      static CODI_INLINE void neg(Real* r, Real const* a) {
+        typename Register::Type const minusOne = Register::set(Real(-1.0));  // Keeps the sign of zero.
+        for (size_t i = 0; i < dim; i += Width) {
+          Register::store(&r[i], Register::mul(minusOne, Register::load(&a[i])));
+        }
+      }
+
+      static CODI_INLINE void scale(Real* r, Real const& s, Real const* a) {
+        typename Register::Type const v = Register::set(s);
+        for (size_t i = 0; i < dim; i += Width) {
+          Register::store(&r[i], Register::mul(v, Register::load(&a[i])));
+        }
+      }
+
+      static CODI_INLINE void divide(Real* r, Real const* a, Real const& s) {
+        typename Register::Type const v = Register::set(s);
+        for (size_t i = 0; i < dim; i += Width) {
+          Register::store(&r[i], Register::div(Register::load(&a[i]), v));
+        }
+      }
+  };
+#endif
+}
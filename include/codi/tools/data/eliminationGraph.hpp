@@ -0,0 +1,323 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "../../config.h"
+#include "../../misc/macros.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+  /**
+   * @brief Linearized computational graph of a tape section for the preaccumulation by vertex elimination.
+   *
+   * The graph is built from the inputs, the statements of the section in the order of the recording and the outputs.
+   * An edge from u to v carries the partial derivative of v with respect to u. Each statement creates a new vertex,
+   * so an identifier that is overwritten or reused in the section refers to the vertex of its last assignment.
+   * Arguments that are neither inputs nor computed in the section are ignored. Each output gets its own vertex with
+   * an edge of weight one from the vertex of its identifier.
+   *
+   * eliminate() removes all intermediate vertices. A vertex v is eliminated by adding the edges p -> s with the weight
+   * d(s)/d(v) * d(v)/d(p) for all predecessors p and successors s of v. The vertex with the smallest Markowitz degree
+   * (number of predecessors times number of successors) is eliminated first. Afterwards, the output vertices are only
+   * connected to the input vertices and their edges are the rows of the Jacobian.
+   *
+   * @tparam T_Real        The computation type of the tape, usually chosen as ActiveType::Real.
+   * @tparam T_Identifier  The identifier type of the tape, usually chosen as ActiveType::Identifier.
+   */
+  template<typename T_Real, typename T_Identifier>
+  struct EliminationGraph {
+    public:
+
+      using Real = CODI_DD(T_Real, double);           ///< See EliminationGraph.
+      using Identifier = CODI_DD(T_Identifier, int);  ///< See EliminationGraph.
+
+    protected:
+
+      static size_t constexpr NoColumn = (size_t)-1;  ///< Column of vertices that are not inputs.
+
+      /// Incoming edge of a vertex.
+      struct Edge {
+        public:
+          size_t vertex;  ///< Source vertex.
+          Real jacobian;  ///< Partial derivative with respect to the source.
+      };
+
+      /// Vertex of the graph.
+      struct Vertex {
+        public:
+          std::vector<Edge> predecessors;  ///< Incoming edges.
+          std::vector<size_t> successors;  ///< Targets of the outgoing edges.
+          size_t column;                   ///< Input column or NoColumn.
+          bool isOutput;                   ///< Output vertices are not eliminated.
+          bool isEliminated;               ///< True after the elimination of the vertex.
+
+          /// Constructor
+          Vertex(size_t column, bool isOutput)
+              : predecessors(), successors(), column(column), isOutput(isOutput), isEliminated(false) {}
+      };
+
+      std::vector<Vertex> vertices;             ///< All vertices.
+      std::vector<size_t> outputVertices;       ///< Vertex of each output.
+      std::vector<size_t> identifierVertices;   ///< Vertex + 1 of each identifier, zero if there is none.
+      std::vector<Identifier> usedIdentifiers;  ///< Identifiers with an entry in identifierVertices.
+      size_t multiplications;                   ///< Number of multiplications in the last elimination.
+
+    public:
+
+      /// Constructor
+      EliminationGraph()
+          : vertices(), outputVertices(), identifierVertices(), usedIdentifiers(), multiplications(0) {}
+
+      /// Remove all vertices. identifierCount is a hint for the largest identifier in the section plus one.
+      void reset(size_t const identifierCount) {
+        for (Identifier const& identifier : usedIdentifiers) {
+          identifierVertices[(size_t)identifier] = 0;
+        }
+        usedIdentifiers.clear();
+        if (identifierVertices.size() < identifierCount) {
+          identifierVertices.resize(identifierCount, 0);
+        }
+
+        vertices.clear();
+        outputVertices.clear();
+        multiplications = 0;
+      }
+
+      /// Add the input for column j of the Jacobian. Has to be called before addStatement(). Only the first occurrence
+      /// of an identifier is used.
+      void addInput(Identifier const& identifier, size_t const j) {
+        if (0 == getVertex(identifier)) {
+          setVertex(identifier, createVertex(j, false));
+        }
+      }
+
+      /// Add a statement that is recorded in the section. The partial derivatives are jacobians[argumentPos + i] with
+      /// respect to rhsIdentifiers[argumentPos + i] for i < numberOfArguments.
+      template<typename JacobianPointer, typename RhsIdentifierPointer>
+      void addStatement(Identifier const& lhsIdentifier, size_t const numberOfArguments,
+                        JacobianPointer const& jacobians, RhsIdentifierPointer const& rhsIdentifiers,
+                        size_t const argumentPos) {
+        size_t const lhsVertex = createVertex(NoColumn, false);
+
+        for (size_t i = 0; i < numberOfArguments; i += 1) {
+          size_t const rhsVertex = getVertex(rhsIdentifiers[argumentPos + i]);
+          Real const jacobian = jacobians[argumentPos + i];
+          if (0 != rhsVertex && Real() != jacobian) {
+            addEdge(rhsVertex - 1, lhsVertex, jacobian);
+          }
+        }
+
+        // Update the mapping after the arguments, the left hand side can also be an argument.
+        setVertex(lhsIdentifier, lhsVertex);
+      }
+
+      /// Add an output, it is row i of the Jacobian if it is the i-th call. Has to be called after all statements are
+      /// added.
+      void addOutput(Identifier const& identifier) {
+        size_t const outputVertex = createVertex(NoColumn, true);
+        size_t const vertex = getVertex(identifier);
+        if (0 != vertex) {
+          addEdge(vertex - 1, outputVertex, Real(1.0));
+        }
+
+        outputVertices.push_back(outputVertex);
+      }
+
+      /// Eliminate all vertices that are neither inputs nor outputs in the order of their Markowitz degree.
+      void eliminate() {
+        using Entry = std::pair<size_t, size_t>;  // Markowitz degree and vertex.
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+        for (size_t v = 0; v < vertices.size(); v += 1) {
+          if (isIntermediate(v)) {
+            queue.push(Entry(markowitzDegree(v), v));
+          }
+        }
+
+        while (!queue.empty()) {
+          Entry const entry = queue.top();
+          queue.pop();
+
+          size_t const v = entry.second;
+          // Entries are not removed when the degree changes, skip outdated ones.
+          if (vertices[v].isEliminated || entry.first != markowitzDegree(v)) {
+            continue;
+          }
+
+          eliminateVertex(v);
+
+          for (Edge const& edge : vertices[v].predecessors) {
+            if (isIntermediate(edge.vertex)) {
+              queue.push(Entry(markowitzDegree(edge.vertex), edge.vertex));
+            }
+          }
+          for (size_t const s : vertices[v].successors) {
+            if (isIntermediate(s)) {
+              queue.push(Entry(markowitzDegree(s), s));
+            }
+          }
+
+          vertices[v].predecessors.clear();
+          vertices[v].successors.clear();
+        }
+
+        // Convert the rows to input columns in ascending order.
+        for (size_t const outputVertex : outputVertices) {
+          std::vector<Edge>& row = vertices[outputVertex].predecessors;
+          for (Edge& edge : row) {
+            codiAssert(NoColumn != vertices[edge.vertex].column);
+            edge.vertex = vertices[edge.vertex].column;
+          }
+          std::sort(row.begin(), row.end(), [](Edge const& a, Edge const& b) { return a.vertex < b.vertex; });
+        }
+      }
+
+      /// Number of outputs.
+      CODI_INLINE size_t getM() const {
+        return outputVertices.size();
+      }
+
+      /// Number of entries in row i, available after eliminate().
+      CODI_INLINE size_t getRowSize(size_t const i) const {
+        return vertices[outputVertices[i]].predecessors.size();
+      }
+
+      /// Column of the k-th entry in row i, available after eliminate().
+      CODI_INLINE size_t getColumn(size_t const i, size_t const k) const {
+        return vertices[outputVertices[i]].predecessors[k].vertex;
+      }
+
+      /// Value of the k-th entry in row i, available after eliminate().
+      CODI_INLINE Real const& getJacobian(size_t const i, size_t const k) const {
+        return vertices[outputVertices[i]].predecessors[k].jacobian;
+      }
+
+      /// Number of multiplications performed by the last call to eliminate().
+      CODI_INLINE size_t getMultiplications() const {
+        return multiplications;
+      }
+
+    private:
+
+      CODI_INLINE size_t getVertex(Identifier const& identifier) const {
+        if ((size_t)identifier < identifierVertices.size()) {
+          return identifierVertices[(size_t)identifier];
+        } else {
+          return 0;
+        }
+      }
+
+      CODI_INLINE void setVertex(Identifier const& identifier, size_t const vertex) {
+        if ((size_t)identifier >= identifierVertices.size()) {
+          identifierVertices.resize((size_t)identifier + 1, 0);
+        }
+
+        size_t& entry = identifierVertices[(size_t)identifier];
+        if (0 == entry) {
+          usedIdentifiers.push_back(identifier);
+        }
+        entry = vertex + 1;
+      }
+
+      CODI_INLINE size_t createVertex(size_t const column, bool const isOutput) {
+        vertices.push_back(Vertex(column, isOutput));
+        return vertices.size() - 1;
+      }
+
+      CODI_INLINE bool isIntermediate(size_t const v) const {
+        return NoColumn == vertices[v].column && !vertices[v].isOutput;
+      }
+
+      CODI_INLINE size_t markowitzDegree(size_t const v) const {
+        return vertices[v].predecessors.size() * vertices[v].successors.size();
+      }
+
+      /// Add jacobian to the edge from -> to, creates the edge if required.
+      void addEdge(size_t const from, size_t const to, Real const& jacobian) {
+        for (Edge& edge : vertices[to].predecessors) {
+          if (from == edge.vertex) {
+            edge.jacobian += jacobian;
+            return;
+          }
+        }
+
+        vertices[to].predecessors.push_back(Edge{from, jacobian});
+        vertices[from].successors.push_back(to);
+      }
+
+      void eliminateVertex(size_t const v) {
+        Vertex& vertex = vertices[v];
+        vertex.isEliminated = true;
+
+        for (Edge const& edge : vertex.predecessors) {
+          removeSuccessor(edge.vertex, v);
+        }
+
+        for (size_t const s : vertex.successors) {
+          Real const jacobian = removePredecessor(s, v);
+          for (Edge const& edge : vertex.predecessors) {
+            addEdge(edge.vertex, s, jacobian * edge.jacobian);
+            multiplications += 1;
+          }
+        }
+      }
+
+      void removeSuccessor(size_t const v, size_t const s) {
+        std::vector<size_t>& successors = vertices[v].successors;
+        successors.erase(std::find(successors.begin(), successors.end(), s));
+      }
+
+      Real removePredecessor(size_t const v, size_t const p) {
+        std::vector<Edge>& predecessors = vertices[v].predecessors;
+        for (size_t k = 0; k < predecessors.size(); k += 1) {
+          if (p == predecessors[k].vertex) {
+            Real const jacobian = predecessors[k].jacobian;
+            predecessors.erase(predecessors.begin() + k);
+            return jacobian;
+          }
+        }
+
+        codiAssert(false);
+        return Real();
+      }
+  };
+}
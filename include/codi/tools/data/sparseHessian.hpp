@@ -0,0 +1,227 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+#include <utility>
+#include <vector>
+
+#include "../../config.h"
+#include "../../misc/constructVector.hpp"
+#include "../../misc/macros.hpp"
+#include "hessianInterface.hpp"
+#include "sparsityPattern.hpp"
+#include "staticDummy.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+  /**
+   * @brief Hessians of all outputs with a common symmetric sparsity pattern.
+   *
+   * The pattern is an n x n pattern that contains the nonzero entries of the Hessians of all m outputs, it has to be
+   * symmetric. For each output, only the entries of the pattern are stored, the value at position pos of the pattern
+   * is value(i, pos). Reading an entry outside of the pattern yields zero, writes to such entries are ignored.
+   *
+   * A star coloring of the pattern is computed once in setPattern(). With a seeding of all inputs of one color, a
+   * Hessian-vector product yields a compressed column of the Hessian. Every entry of the pattern is recovered directly
+   * from the compressed column getRecoveryColor(pos) at row getRecoveryRow(pos), see
+   * SparsityPattern::computeStarColoring.
+   *
+   * @tparam T_T  The data type in the Hessian.
+   * @tparam T_Store  Storage allocator. Should implement the standard vector interface.
+   */
+  template<typename T_T, typename T_Store = std::vector<T_T>>
+  struct SparseHessian : public HessianInterface<T_T> {
+    public:
+
+      using T = CODI_DD(T_T, double);                       ///< See SparseHessian.
+      using Store = CODI_DD(T_Store, std::vector<double>);  ///< See SparseHessian.
+
+    protected:
+
+      size_t m;                 ///< Number of function outputs.
+      SparsityPattern pattern;  ///< Positions of the entries.
+      Store values;             ///< Value for each output and entry of the pattern.
+
+      std::vector<size_t> colors;          ///< Star coloring of the pattern.
+      size_t numberOfColors;               ///< Number of colors in colors.
+      std::vector<size_t> recoveryRows;    ///< Row of the compressed Hessian for each entry.
+      std::vector<size_t> recoveryColors;  ///< Column of the compressed Hessian for each entry.
+
+    public:
+
+      /// Constructor for an empty pattern of size n x n.
+      explicit SparseHessian(size_t const m = 0, size_t const n = 0)
+          : m(0), pattern(), values(), colors(), numberOfColors(0), recoveryRows(), recoveryColors() {
+        resize(m, n);
+      }
+
+      /// Constructor
+      explicit SparseHessian(size_t const m, SparsityPattern pattern) : SparseHessian() {
+        setPattern(m, std::move(pattern));
+      }
+
+      /// Set the pattern for m outputs and compute the coloring. All values are set to zero.
+      void setPattern(size_t const m, SparsityPattern pattern) {
+        codiAssert(pattern.getM() == pattern.getN());
+
+        this->m = m;
+        this->pattern = std::move(pattern);
+        values = constructVector<Store>(m * this->pattern.getNonZeros());
+
+        numberOfColors = this->pattern.computeStarColoring(colors);
+        computeRecovery();
+      }
+
+      /// The sparsity pattern.
+      CODI_INLINE SparsityPattern const& getPattern() const {
+        return pattern;
+      }
+
+      /// Value of output i for the entry at position pos of the pattern.
+      CODI_INLINE T& value(size_t const i, size_t const pos) {
+        return values[i * pattern.getNonZeros() + pos];
+      }
+
+      /// Value of output i for the entry at position pos of the pattern.
+      CODI_INLINE T const& value(size_t const i, size_t const pos) const {
+        return values[i * pattern.getNonZeros() + pos];
+      }
+
+      /// Star coloring of the inputs.
+      CODI_INLINE std::vector<size_t> const& getColors() const {
+        return colors;
+      }
+
+      /// Number of Hessian-vector products for a scalar gradient.
+      CODI_INLINE size_t getNumberOfColors() const {
+        return numberOfColors;
+      }
+
+      /// Row in the compressed Hessian that contains the entry at position pos.
+      CODI_INLINE size_t getRecoveryRow(size_t const pos) const {
+        return recoveryRows[pos];
+      }
+
+      /// Color of the compressed column that contains the entry at position pos.
+      CODI_INLINE size_t getRecoveryColor(size_t const pos) const {
+        return recoveryColors[pos];
+      }
+
+      /// \copydoc codi::HessianInterface::getM()
+      CODI_INLINE size_t getM() const {
+        return m;
+      }
+
+      /// \copydoc codi::HessianInterface::getN()
+      CODI_INLINE size_t getN() const {
+        return pattern.getN();
+      }
+
+      /// \copydoc codi::HessianInterface::operator()(size_t const i, size_t const j, size_t const k) const
+      CODI_INLINE T operator()(size_t const i, size_t const j, size_t const k) const {
+        size_t const pos = pattern.findPosition(j, k);
+        if (pos < pattern.getNonZeros()) {
+          return value(i, pos);
+        } else {
+          return T();
+        }
+      }
+
+      /// \copydoc codi::HessianInterface::operator()(size_t const i, size_t const j, size_t const k)
+      ///
+      /// Implementation: Entries outside of the pattern return a dummy reference.
+      CODI_INLINE T& operator()(size_t const i, size_t const j, size_t const k) {
+        size_t const pos = pattern.findPosition(j, k);
+        if (pos < pattern.getNonZeros()) {
+          return value(i, pos);
+        } else {
+          StaticDummy<T>::dummy = T();
+          return StaticDummy<T>::dummy;
+        }
+      }
+
+      /// \copydoc codi::HessianInterface::resize()
+      ///
+      /// Implementation: Sets an empty pattern of the new size.
+      void resize(size_t const m, size_t const n) {
+        SparsityPattern emptyPattern;
+        emptyPattern.reset(n);
+        for (size_t j = 0; j < n; ++j) {
+          emptyPattern.finishRow();
+        }
+
+        setPattern(m, std::move(emptyPattern));
+      }
+
+      /// \copydoc codi::HessianInterface::size()
+      ///
+      /// Implementation: Number of stored entries for all outputs.
+      CODI_INLINE size_t size() const {
+        return m * pattern.getNonZeros();
+      }
+
+    private:
+
+      void computeRecovery() {
+        size_t const n = pattern.getN();
+        recoveryRows.resize(pattern.getNonZeros());
+        recoveryColors.resize(pattern.getNonZeros());
+
+        // Number of variables of each color in the current row.
+        std::vector<size_t> colorCount(numberOfColors, 0);
+        for (size_t j = 0; j < n; ++j) {
+          for (size_t pos = pattern.rowBegin(j); pos < pattern.rowEnd(j); ++pos) {
+            colorCount[colors[pattern.getColumn(pos)]] += 1;
+          }
+
+          for (size_t pos = pattern.rowBegin(j); pos < pattern.rowEnd(j); ++pos) {
+            size_t const k = pattern.getColumn(pos);
+            if (1 == colorCount[colors[k]]) {
+              recoveryRows[pos] = j;
+              recoveryColors[pos] = colors[k];
+            } else {
+              // The star coloring ensures that j is the only variable of its color in row k.
+              recoveryRows[pos] = k;
+              recoveryColors[pos] = colors[j];
+            }
+          }
+
+          for (size_t pos = pattern.rowBegin(j); pos < pattern.rowEnd(j); ++pos) {
+            colorCount[colors[pattern.getColumn(pos)]] = 0;
+          }
+        }
+      }
+  };
+}
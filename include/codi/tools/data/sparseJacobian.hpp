@@ -0,0 +1,202 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "../../config.h"
+#include "../../misc/constructVector.hpp"
+#include "../../misc/macros.hpp"
+#include "jacobianInterface.hpp"
+#include "sparsityPattern.hpp"
+#include "staticDummy.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+  /**
+   * @brief Jacobian in compressed row storage (CSR) for a fixed sparsity pattern.
+   *
+   * Only the entries of the pattern are stored, the value at position pos of the pattern is value(pos). Reading an
+   * entry outside of the pattern yields zero, writes to such entries are ignored.
+   *
+   * The colorings of the columns and rows for the compressed evaluation in Algorithms::computeSparseJacobian are
+   * computed once in setPattern() and reused for all evaluations.
+   *
+   * @tparam T_T  The data type in the Jacobian.
+   * @tparam T_Store  Storage allocator. Should implement the standard vector interface.
+   */
+  template<typename T_T, typename T_Store = std::vector<T_T>>
+  struct SparseJacobian : public JacobianInterface<T_T> {
+    public:
+
+      using T = CODI_DD(T_T, double);                       ///< See SparseJacobian.
+      using Store = CODI_DD(T_Store, std::vector<double>);  ///< See SparseJacobian.
+
+    protected:
+
+      SparsityPattern pattern;  ///< Positions of the entries.
+      Store values;             ///< Value for each entry of the pattern.
+
+      std::vector<size_t> columnColors;  ///< Column coloring of the pattern.
+      std::vector<size_t> rowColors;     ///< Row coloring of the pattern.
+      size_t numberOfColumnColors;       ///< Number of colors in columnColors.
+      size_t numberOfRowColors;          ///< Number of colors in rowColors.
+
+    public:
+
+      /// Constructor for an empty pattern of size m x n.
+      explicit SparseJacobian(size_t const m = 0, size_t const n = 0)
+          : pattern(),
+            values(),
+            columnColors(),
+            rowColors(),
+            numberOfColumnColors(0),
+            numberOfRowColors(0) {
+        resize(m, n);
+      }
+
+      /// Constructor
+      explicit SparseJacobian(SparsityPattern pattern) : SparseJacobian() {
+        setPattern(std::move(pattern));
+      }
+
+      /// Set the pattern and compute the colorings. All values are set to zero.
+      void setPattern(SparsityPattern pattern) {
+        this->pattern = std::move(pattern);
+        values = constructVector<Store>(this->pattern.getNonZeros());
+
+        numberOfColumnColors = this->pattern.computeColumnColoring(columnColors);
+
+        SparsityPattern transposed;
+        this->pattern.transpose(transposed);
+        numberOfRowColors = transposed.computeColumnColoring(rowColors);
+      }
+
+      /// The sparsity pattern.
+      CODI_INLINE SparsityPattern const& getPattern() const {
+        return pattern;
+      }
+
+      /// Value of the entry at position pos of the pattern.
+      CODI_INLINE T& value(size_t const pos) {
+        return values[pos];
+      }
+
+      /// Value of the entry at position pos of the pattern.
+      CODI_INLINE T const& value(size_t const pos) const {
+        return values[pos];
+      }
+
+      /// Columns with the same color have no common row.
+      CODI_INLINE std::vector<size_t> const& getColumnColors() const {
+        return columnColors;
+      }
+
+      /// Rows with the same color have no common column.
+      CODI_INLINE std::vector<size_t> const& getRowColors() const {
+        return rowColors;
+      }
+
+      /// Number of forward evaluations for a scalar gradient.
+      CODI_INLINE size_t getNumberOfColumnColors() const {
+        return numberOfColumnColors;
+      }
+
+      /// Number of reverse evaluations for a scalar gradient.
+      CODI_INLINE size_t getNumberOfRowColors() const {
+        return numberOfRowColors;
+      }
+
+      /// \copydoc codi::JacobianInterface::getM()
+      CODI_INLINE size_t getM() const {
+        return pattern.getM();
+      }
+
+      /// \copydoc codi::JacobianInterface::getN()
+      CODI_INLINE size_t getN() const {
+        return pattern.getN();
+      }
+
+      /// \copydoc codi::JacobianInterface::operator()(size_t const, size_t const) const
+      CODI_INLINE T operator()(size_t const i, size_t const j) const {
+        size_t const pos = pattern.findPosition(i, j);
+        if (pos < pattern.getNonZeros()) {
+          return values[pos];
+        } else {
+          return T();
+        }
+      }
+
+      /// \copydoc codi::JacobianInterface::operator()(size_t const, size_t const)
+      ///
+      /// Implementation: Entries outside of the pattern return a dummy reference.
+      CODI_INLINE T& operator()(size_t const i, size_t const j) {
+        size_t const pos = pattern.findPosition(i, j);
+        if (pos < pattern.getNonZeros()) {
+          return values[pos];
+        } else {
+          StaticDummy<T>::dummy = T();
+          return StaticDummy<T>::dummy;
+        }
+      }
+
+      /// \copydoc codi::JacobianInterface::resize()
+      ///
+      /// Implementation: Sets an empty pattern of the new size.
+      void resize(size_t const m, size_t const n) {
+        SparsityPattern emptyPattern;
+        emptyPattern.reset(n);
+        for (size_t i = 0; i < m; ++i) {
+          emptyPattern.finishRow();
+        }
+
+        setPattern(std::move(emptyPattern));
+      }
+
+      /// \copydoc codi::JacobianInterface::size()
+      ///
+      /// Implementation: Number of entries in the pattern.
+      CODI_INLINE size_t size() const {
+        return pattern.getNonZeros();
+      }
+
+      /// \copydoc codi::JacobianInterface::setLogic()
+      CODI_INLINE void setLogic(size_t const i, size_t const j, T const& v) {
+        (*this)(i, j) = v;
+      }
+  };
+}
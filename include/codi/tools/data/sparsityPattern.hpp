@@ -0,0 +1,267 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "../../config.h"
+#include "../../misc/macros.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+  /**
+   * @brief Sparsity pattern of a Jacobian in compressed row storage.
+   *
+   * The column indices of row i are stored in ascending order at the positions [rowBegin(i), rowEnd(i)) and can be
+   * queried with getColumn(). The pattern is built row by row with addEntry() and finishRow().
+   *
+   * The pattern provides a greedy coloring of the columns. Columns with the same color do not have a nonzero entry
+   * in the same row, therefore they can be seeded together in one forward evaluation and the Jacobian entries can be
+   * recovered from the compressed result.
+   *
+   * For the symmetric pattern of a Hessian, a star coloring can be computed with computeStarColoring().
+   */
+  struct SparsityPattern {
+    protected:
+
+      std::vector<size_t> rowStarts;      ///< Position of the first entry of each row, m + 1 entries.
+      std::vector<size_t> columnIndices;  ///< Column index of each entry.
+      size_t n;                           ///< Number of columns (input variables).
+
+    public:
+
+      /// Constructor
+      SparsityPattern() : rowStarts(1, 0), columnIndices(), n(0) {}
+
+      /// Remove all rows and set the number of columns.
+      void reset(size_t const n) {
+        rowStarts.resize(1);
+        columnIndices.clear();
+        this->n = n;
+      }
+
+      /// Add an entry in column j to the current row.
+      CODI_INLINE void addEntry(size_t const j) {
+        codiAssert(j < n);
+        columnIndices.push_back(j);
+      }
+
+      /// Finish the current row, the next entries are added to a new row. Sorts the entries of the row.
+      CODI_INLINE void finishRow() {
+        std::sort(columnIndices.begin() + rowStarts.back(), columnIndices.end());
+        rowStarts.push_back(columnIndices.size());
+      }
+
+      /// Number of rows (output variables).
+      CODI_INLINE size_t getM() const {
+        return rowStarts.size() - 1;
+      }
+
+      /// Number of columns (input variables).
+      CODI_INLINE size_t getN() const {
+        return n;
+      }
+
+      /// Number of entries in the pattern.
+      CODI_INLINE size_t getNonZeros() const {
+        return columnIndices.size();
+      }
+
+      /// Position of the first entry of row i.
+      CODI_INLINE size_t rowBegin(size_t const i) const {
+        return rowStarts[i];
+      }
+
+      /// Position after the last entry of row i.
+      CODI_INLINE size_t rowEnd(size_t const i) const {
+        return rowStarts[i + 1];
+      }
+
+      /// Column index of the entry at pos.
+      CODI_INLINE size_t getColumn(size_t const pos) const {
+        return columnIndices[pos];
+      }
+
+      /// Position of the entry (i, j), getNonZeros() if the entry is not in the pattern.
+      CODI_INLINE size_t findPosition(size_t const i, size_t const j) const {
+        auto const begin = columnIndices.begin() + rowBegin(i);
+        auto const end = columnIndices.begin() + rowEnd(i);
+        auto const pos = std::lower_bound(begin, end, j);
+        if (pos != end && *pos == j) {
+          return (size_t)(pos - columnIndices.begin());
+        } else {
+          return getNonZeros();
+        }
+      }
+
+      /// Store the transposed pattern in result, its rows are the columns of this pattern.
+      void transpose(SparsityPattern& result) const {
+        size_t const m = getM();
+
+        result.n = m;
+        result.rowStarts.assign(n + 1, 0);
+        for (size_t pos = 0; pos < columnIndices.size(); ++pos) {
+          result.rowStarts[columnIndices[pos] + 1] += 1;
+        }
+        for (size_t j = 0; j < n; ++j) {
+          result.rowStarts[j + 1] += result.rowStarts[j];
+        }
+
+        // Rows are added in ascending order, the entries of the transposed rows are sorted.
+        result.columnIndices.resize(columnIndices.size());
+        std::vector<size_t> fillPos(result.rowStarts.begin(), result.rowStarts.end() - 1);
+        for (size_t i = 0; i < m; ++i) {
+          for (size_t pos = rowBegin(i); pos < rowEnd(i); ++pos) {
+            result.columnIndices[fillPos[columnIndices[pos]]++] = i;
+          }
+        }
+      }
+
+      /**
+       * @brief Greedy coloring of the columns such that columns with the same color have no common row.
+       *
+       * The columns are colored in their natural order, each one gets the smallest color that is not used by a column
+       * that shares a row with it.
+       *
+       * @param[out] colors  Resized to getN(), contains the color of each column.
+       * @return The number of colors.
+       */
+      size_t computeColumnColoring(std::vector<size_t>& colors) const {
+        // The rows of each column.
+        SparsityPattern transposed;
+        transpose(transposed);
+
+        colors.assign(n, 0);
+        // Color c is used by a column that shares a row with column j if forbiddenFor[c] == j.
+        std::vector<size_t> forbiddenFor(n + 1, n);
+        size_t numberOfColors = 0;
+        for (size_t j = 0; j < n; ++j) {
+          for (size_t colPos = transposed.rowBegin(j); colPos < transposed.rowEnd(j); ++colPos) {
+            size_t const i = transposed.getColumn(colPos);
+            for (size_t pos = rowBegin(i); pos < rowEnd(i); ++pos) {
+              size_t const neighbor = columnIndices[pos];
+              if (neighbor < j) {
+                forbiddenFor[colors[neighbor]] = j;
+              }
+            }
+          }
+
+          size_t color = 0;
+          while (forbiddenFor[color] == j) {
+            color += 1;
+          }
+          colors[j] = color;
+          if (color >= numberOfColors) {
+            numberOfColors = color + 1;
+          }
+        }
+
+        return numberOfColors;
+      }
+
+      /**
+       * @brief Greedy star coloring of a symmetric pattern.
+       *
+       * The pattern is interpreted as the adjacency graph of the variables, the diagonal entries are ignored. Adjacent
+       * variables get different colors and every path on four variables uses at least three colors. Therefore, each
+       * entry (j, k) of a symmetric matrix can be recovered directly from its compressed product with the color
+       * seeding: either k is the only variable of its color in row j or j is the only variable of its color in row k.
+       *
+       * The variables are colored in their natural order, see Gebremedhin, Manne and Pothen, "What color is your
+       * Jacobian? Graph coloring for computing derivatives", SIAM Review 47(4), 2005, Algorithm 4.1.
+       *
+       * @param[out] colors  Resized to getN(), contains the color of each variable.
+       * @return The number of colors.
+       */
+      size_t computeStarColoring(std::vector<size_t>& colors) const {
+        codiAssert(getM() == n);
+
+        size_t const uncolored = n;
+        colors.assign(n, uncolored);
+        // Color c can not be used for variable v if forbiddenFor[c] == v.
+        std::vector<size_t> forbiddenFor(n + 1, n);
+        size_t numberOfColors = 0;
+        for (size_t v = 0; v < n; ++v) {
+          for (size_t posW = rowBegin(v); posW < rowEnd(v); ++posW) {
+            size_t const w = columnIndices[posW];
+            if (w != v && colors[w] != uncolored) {
+              forbiddenFor[colors[w]] = v;
+            }
+          }
+
+          for (size_t posW = rowBegin(v); posW < rowEnd(v); ++posW) {
+            size_t const w = columnIndices[posW];
+            if (w == v) {
+              continue;
+            }
+
+            for (size_t posX = rowBegin(w); posX < rowEnd(w); ++posX) {
+              size_t const x = columnIndices[posX];
+              if (x == v || x == w || colors[x] == uncolored) {
+                continue;
+              }
+
+              if (colors[w] == uncolored) {
+                // Distance-2 condition for paths over uncolored variables.
+                forbiddenFor[colors[x]] = v;
+              } else {
+                // The path v - w - x - y would be two-colored if v gets the color of x.
+                for (size_t posY = rowBegin(x); posY < rowEnd(x); ++posY) {
+                  size_t const y = columnIndices[posY];
+                  if (y != x && y != w && colors[y] == colors[w]) {
+                    forbiddenFor[colors[x]] = v;
+                    break;
+                  }
+                }
+              }
+            }
+          }
+
+          size_t color = 0;
+          while (forbiddenFor[color] == v) {
+            color += 1;
+          }
+          colors[v] = color;
+          if (color >= numberOfColors) {
+            numberOfColors = color + 1;
+          }
+        }
+
+        return numberOfColors;
+      }
+  };
+}
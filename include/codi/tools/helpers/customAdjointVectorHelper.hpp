@@ -116,7 +116,7 @@ namespace codi {
 
       /// \copydoc codi::ForwardEvaluationTapeInterface::evaluateForward()
       void evaluateForward() {
-        evaluate(tape.getPosition(), tape.getZeroPosition());
+        evaluateForward(tape.getZeroPosition(), tape.getPosition());
       }
 
       /// Set the tape for the evaluations.
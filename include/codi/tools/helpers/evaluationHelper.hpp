@@ -109,6 +109,18 @@ namespace codi {
       template<typename VecX, typename Hes, typename VecY, typename Jac>
       void computeHessian(VecX const& locX, Hes& hes, VecY& locY, Jac& jac);
 
+      /// Compute the products of the transposed Jacobian with the vectors in w at the inputs provided in locX. Store
+      /// the products in jtw and the result in locY. w[b * m + i] is the weight of output i in vector b and
+      /// jtw[b * n + j] is the entry of input j in product b.
+      template<typename VecX, typename VecW, typename VecR, typename VecY>
+      void computeJacobianTransposeProducts(VecX const& locX, VecW const& w, VecR& jtw, VecY& locY);
+
+      /// Compute the products of the Hessians with the vectors in v at the inputs provided in locX. Store the products
+      /// in hv and the result in locY. v[b * n + j] is the entry of input j in vector b and hv[(b * m + i) * n + k] is
+      /// the entry k of the product of the Hessian of output i with vector b.
+      template<typename VecX, typename VecV, typename VecR, typename VecY>
+      void computeHessianVectorProducts(VecX const& locX, VecV const& v, VecR& hv, VecY& locY);
+
     protected:
 
       /// Set the primal values from the user provided vector into the CoDiPack ones.
@@ -123,6 +135,11 @@ namespace codi {
       void eval() {
         func(x, y);
       }
+
+      /// Number of vectors of the given size in vectors with the total size.
+      static size_t numberOfVectors(size_t const totalSize, size_t const size) {
+        return 0 == size ? 0 : totalSize / size;
+      }
   };
 
   /// Implementation of EvaluationHandleBase for forward mode CoDiPack types.
@@ -273,6 +290,109 @@ namespace codi {
           }
         }
       }
+
+      /// \copydoc codi::EvaluationHandleBase::computeJacobianTransposeProducts
+      ///
+      /// The vectorization is performed over the input vector. The function object is evaluated n/vecSize times for
+      /// all vectors.
+      template<typename VecX, typename VecW, typename VecR, typename VecY>
+      void computeJacobianTransposeProducts(VecX const& locX, VecW const& w, VecR& jtw, VecY& locY) {
+        setPrimalInputs(locX);
+
+        using GradientTraits1st = GradientTraits::TraitsImplementation<typename Type::Gradient>;
+        size_t constexpr VectorSizeFirstOrder = GradientTraits1st::dim;
+
+        size_t const count = Base::numberOfVectors(w.size(), this->y.size());
+
+        for (size_t j = 0; j < locX.size(); j += VectorSizeFirstOrder) {
+          for (size_t vecPos = 0; vecPos < VectorSizeFirstOrder && j + vecPos < locX.size(); vecPos += 1) {
+            GradientTraits1st::at(this->x[j + vecPos].gradient(), vecPos) = 1.0;
+          }
+
+          this->eval();
+
+          if (0 == j) {
+            getPrimalOutputs(locY);
+          }
+
+          for (size_t b = 0; b < count; b += 1) {
+            for (size_t vecPos = 0; vecPos < VectorSizeFirstOrder && j + vecPos < locX.size(); vecPos += 1) {
+              jtw[b * locX.size() + j + vecPos] = 0.0;
+              for (size_t i = 0; i < this->y.size(); i += 1) {
+                jtw[b * locX.size() + j + vecPos] +=
+                    w[b * this->y.size() + i] *
+                    RealTraits::getPassiveValue(GradientTraits1st::at(this->y[i].gradient(), vecPos));
+              }
+            }
+          }
+
+          for (size_t vecPos = 0; vecPos < VectorSizeFirstOrder && j + vecPos < locX.size(); vecPos += 1) {
+            GradientTraits1st::at(this->x[j + vecPos].gradient(), vecPos) = 0.0;
+          }
+        }
+      }
+
+      /// \copydoc codi::EvaluationHandleBase::computeHessianVectorProducts
+      ///
+      /// The vectors are seeded in the second order derivative direction. The function object is evaluated
+      /// n/vecSize1 times for each vecSize2 vectors.
+      template<typename VecX, typename VecV, typename VecR, typename VecY>
+      void computeHessianVectorProducts(VecX const& locX, VecV const& v, VecR& hv, VecY& locY) {
+        setPrimalInputs(locX);
+
+        using GradientTraits1st = GradientTraits::TraitsImplementation<typename Type::Gradient>;
+        size_t constexpr VectorSizeFirstOrder = GradientTraits1st::dim;
+
+        using GradientTraits2nd = GradientTraits::TraitsImplementation<CODI_DD(typename Type::Real::Gradient, double)>;
+        size_t constexpr VectorSizeSecondOrder = GradientTraits2nd::dim;
+
+        size_t const n = locX.size();
+        size_t const count = Base::numberOfVectors(v.size(), n);
+
+        for (size_t b = 0; b < count; b += VectorSizeSecondOrder) {
+          // Set the vectors from b to b + vecSize_b.
+          for (size_t j = 0; j < n; j += 1) {
+            for (size_t vecPos = 0; vecPos < VectorSizeSecondOrder && b + vecPos < count; vecPos += 1) {
+              GradientTraits2nd::at(this->x[j].value().gradient(), vecPos) = v[(b + vecPos) * n + j];
+            }
+          }
+
+          for (size_t k = 0; k < n; k += VectorSizeFirstOrder) {
+            // Set derivatives from k to k + vecSize_k.
+            for (size_t vecPos = 0; vecPos < VectorSizeFirstOrder && k + vecPos < n; vecPos += 1) {
+              GradientTraits1st::at(this->x[k + vecPos].gradient(), vecPos).value() = 1.0;
+            }
+
+            this->eval();
+
+            if (0 == b && 0 == k) {
+              getPrimalOutputs(locY);
+            }
+
+            for (size_t i = 0; i < this->y.size(); i += 1) {
+              for (size_t vecPos1st = 0; vecPos1st < VectorSizeFirstOrder && k + vecPos1st < n; vecPos1st += 1) {
+                for (size_t vecPos2nd = 0; vecPos2nd < VectorSizeSecondOrder && b + vecPos2nd < count;
+                     vecPos2nd += 1) {
+                  auto& firstGrad = GradientTraits1st::at(this->y[i].gradient(), vecPos1st);
+
+                  hv[((b + vecPos2nd) * this->y.size() + i) * n + k + vecPos1st] =
+                      GradientTraits2nd::at(firstGrad.gradient(), vecPos2nd);
+                }
+              }
+            }
+
+            // Reset the derivative seeding.
+            for (size_t vecPos = 0; vecPos < VectorSizeFirstOrder && k + vecPos < n; vecPos += 1) {
+              GradientTraits1st::at(this->x[k + vecPos].gradient(), vecPos).value() = 0.0;
+            }
+          }
+
+          // Reset the vector seeding.
+          for (size_t j = 0; j < n; j += 1) {
+            this->x[j].value().gradient() = typename Type::Real::Gradient();
+          }
+        }
+      }
   };
 
   /// @brief Implementation for reverse mode CoDiPack types of EvaluationHandleBase.
@@ -353,6 +473,20 @@ namespace codi {
       template<typename VecX, typename Hes, typename VecY, typename Jac>
       void computeHessian(VecX const& locX, Hes& hes, VecY& locY, Jac& jac);
 
+      /// \copydoc codi::EvaluationHandleBase::computeJacobianTransposeProducts
+      ///
+      /// The vectors are seeded on the outputs, one reverse evaluation is performed for each vecSize vectors.
+      template<typename VecX, typename VecW, typename VecR, typename VecY>
+      void computeJacobianTransposeProducts(VecX const& locX, VecW const& w, VecR& jtw, VecY& locY) {
+        recordTape(locX, locY);
+
+        th.evalJacobianTransposeProducts(w.data(), jtw.data(), Base::numberOfVectors(w.size(), this->y.size()));
+      }
+
+      /// \copydoc codi::EvaluationHandleBase::computeHessianVectorProducts
+      template<typename VecX, typename VecV, typename VecR, typename VecY>
+      void computeHessianVectorProducts(VecX const& locX, VecV const& v, VecR& hv, VecY& locY);
+
     protected:
 
       /// Helper function that records a new tape.
@@ -405,6 +539,17 @@ namespace codi {
 
         this->th.evalHessian(hes, jac);
       }
+
+      /// \copydoc codi::EvaluationHandleBase::computeHessianVectorProducts
+      ///
+      /// For the primal value tape implementation, the tape is recorded once. One primal evaluation and the reverse
+      /// evaluations for all outputs are performed for each vecSize2 vectors.
+      template<typename VecX, typename VecV, typename VecR, typename VecY>
+      void computeHessianVectorProducts(VecX const& locX, VecV const& v, VecR& hv, VecY& locY) {
+        this->recordTape(locX, locY);
+
+        this->th.evalHessianVectorProducts(v.data(), hv.data(), Base::numberOfVectors(v.size(), this->x.size()));
+      }
   };
 
   /**
@@ -443,6 +588,19 @@ namespace codi {
 
         this->getPrimalOutputs(locY, false);
       }
+
+      /// \copydoc codi::EvaluationHandleBase::computeHessianVectorProducts
+      ///
+      /// For the Jacobian tape implementation, a new tape is recorded for each vecSize2 vectors.
+      template<typename VecX, typename VecV, typename VecR, typename VecY>
+      void computeHessianVectorProducts(VecX const& locX, VecV const& v, VecR& hv, VecY& locY) {
+        this->setPrimalInputs(locX, false);
+
+        Algorithms<Type>::computeHessianVectorProducts(this->func, this->x, this->y, v.data(),
+                                                       Base::numberOfVectors(v.size(), this->x.size()), hv.data());
+
+        this->getPrimalOutputs(locY, false);
+      }
   };
 
   /// See EvaluationHandleBase.
@@ -923,6 +1081,53 @@ namespace codi {
         evalHandleJacobianAndHessian(h, x, jac, hes);
       }
 
+      /**
+       * @brief Compute the products of the transposed Jacobian of the function object with multiple vectors.
+       *
+       * The Jacobian is not stored. One reverse evaluation is performed for each vecSize vectors.
+       *
+       * @param[in]  func  The function object for the evaluation (see FunctorInterface).
+       * @param[in]     x  The vector with the primal values where the function object is evaluated.
+       * @param[in] ySize  The size of the output vector.
+       * @param[in]     w  The output weights. w[b * ySize + i] is the weight of output i in vector b.
+       * @param[out]  jtw  The products. jtw[b * x.size() + j] is the entry of input j in product b.
+       *
+       * @tparam  Func  See FunctorInterface.
+       * @tparam  VecX  The vector type for the input values. Element type is e.g. double.
+       * @tparam  VecW  The vector type for the weights. Element type is e.g. double.
+       * @tparam  VecR  The vector type for the products. Element type is e.g. double.
+       */
+      template<typename Func, typename VecX, typename VecW, typename VecR>
+      static CODI_INLINE void evalJacobianTransposeProducts(Func& func, VecX const& x, size_t const ySize,
+                                                            VecW const& w, VecR& jtw) {
+        auto h = createHandleDefault(func, ySize, x.size());
+        evalHandleJacobianTransposeProducts(h, x, w, jtw);
+      }
+
+      /**
+       * @brief Compute the products of the Hessians of the function object with multiple vectors.
+       *
+       * The Hessian is not stored. The products are computed in a forward-over-reverse fashion.
+       *
+       * @param[in]  func  The function object for the evaluation (see FunctorInterface).
+       * @param[in]     x  The vector with the primal values where the function object is evaluated.
+       * @param[in] ySize  The size of the output vector.
+       * @param[in]     v  The vectors. v[b * x.size() + j] is the entry of input j in vector b.
+       * @param[out]   hv  The products. hv[(b * ySize + i) * x.size() + k] is the entry k of the product of the Hessian
+       *                   of output i with vector b.
+       *
+       * @tparam  Func  See FunctorInterface.
+       * @tparam  VecX  The vector type for the input values. Element type is e.g. double.
+       * @tparam  VecV  The vector type for the vectors. Element type is e.g. double.
+       * @tparam  VecR  The vector type for the products. Element type is e.g. double.
+       */
+      template<typename Func, typename VecX, typename VecV, typename VecR>
+      static CODI_INLINE void evalHessianVectorProducts(Func& func, VecX const& x, size_t const ySize, VecV const& v,
+                                                        VecR& hv) {
+        auto h = createHandleDefault2nd(func, ySize, x.size());
+        evalHandleHessianVectorProducts(h, x, v, hv);
+      }
+
       /**
        * @brief Perform a primal evaluation of the function object stored in the handle.
        *
@@ -1056,6 +1261,49 @@ namespace codi {
         DummyVector dv;
         handle.computeHessian(x, hes, dv, jac);
       }
+
+      /**
+       * @brief Compute the products of the transposed Jacobian of the function object stored in the handle with
+       * multiple vectors.
+       *
+       * @param[in] handle  The handle with all data for the evaluation.
+       * @param[in]      x  The vector with the primal values where the function object is evaluated.
+       * @param[in]      w  The output weights. w[b * m + i] is the weight of output i in vector b.
+       * @param[out]   jtw  The products. jtw[b * n + j] is the entry of input j in product b.
+       *
+       * @tparam  Handle  The handle type for the data storage and the evaluation.
+       * @tparam    VecX  The vector type for the input values. Element type is e.g. double.
+       * @tparam    VecW  The vector type for the weights. Element type is e.g. double.
+       * @tparam    VecR  The vector type for the products. Element type is e.g. double.
+       */
+      template<typename Handle, typename VecX, typename VecW, typename VecR>
+      static CODI_INLINE void evalHandleJacobianTransposeProducts(Handle& handle, VecX const& x, VecW const& w,
+                                                                  VecR& jtw) {
+        DummyVector dv;
+        handle.computeJacobianTransposeProducts(x, w, jtw, dv);
+      }
+
+      /**
+       * @brief Compute the products of the Hessians of the function object stored in the handle with multiple
+       * vectors.
+       *
+       * @param[in] handle  The handle with all data for the evaluation.
+       * @param[in]      x  The vector with the primal values where the function object is evaluated.
+       * @param[in]      v  The vectors. v[b * n + j] is the entry of input j in vector b.
+       * @param[out]    hv  The products. hv[(b * m + i) * n + k] is the entry k of the product of the Hessian of
+       *                    output i with vector b.
+       *
+       * @tparam  Handle  The handle type for the data storage and the evaluation.
+       * @tparam    VecX  The vector type for the input values. Element type is e.g. double.
+       * @tparam    VecV  The vector type for the vectors. Element type is e.g. double.
+       * @tparam    VecR  The vector type for the products. Element type is e.g. double.
+       */
+      template<typename Handle, typename VecX, typename VecV, typename VecR>
+      static CODI_INLINE void evalHandleHessianVectorProducts(Handle& handle, VecX const& x, VecV const& v,
+                                                              VecR& hv) {
+        DummyVector dv;
+        handle.computeHessianVectorProducts(x, v, hv, dv);
+      }
   };
 
 }
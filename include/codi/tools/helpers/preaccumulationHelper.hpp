@@ -45,11 +45,20 @@
 #include "../../traits/gradientTraits.hpp"
 #include "../../traits/tapeTraits.hpp"
 #include "../algorithms.hpp"
+#include "../data/dependencyBits.hpp"
+#include "../data/eliminationGraph.hpp"
 #include "../data/jacobian.hpp"
+#include "../data/sparsityPattern.hpp"
 
 /** \copydoc codi::Namespace */
 namespace codi {
 
+  /// Computation of the Jacobian in PreaccumulationHelper::finish().
+  enum class PreaccumulationStrategy {
+    Sweeps,            ///< Forward or reverse tape sweeps, see Algorithms::getEvaluationChoice.
+    VertexElimination  ///< Elimination of the intermediate vertices of the linearized computational graph.
+  };
+
   /**
    * @brief Stores the Jacobian matrix for a code section.
    *
@@ -70,6 +79,15 @@ namespace codi {
    * evaluations are possible. This improves the performance of the helper since stack allocations are only performed
    * once.
    *
+   * If the region has many inputs and each output depends only on a few of them, finishSparse() can be used instead
+   * of finish(). It computes only the structurally nonzero entries of the Jacobian with one forward evaluation per
+   * color of a column coloring instead of one evaluation per input.
+   *
+   * For regions with a narrow middle, e.g. many inputs and outputs that depend on a few intermediate values, the
+   * strategy PreaccumulationStrategy::VertexElimination can be selected with setStrategy(). The Jacobian is then
+   * computed by eliminating the intermediate vertices of the recorded computational graph, see EliminationGraph,
+   * instead of one tape sweep per input or output.
+   *
    * @tparam T_Type  The CoDiPack type on which the evaluations take place.
    */
   template<typename T_Type, typename = void>
@@ -87,6 +105,8 @@ namespace codi {
       using Tape = CODI_DD(typename Type::Tape, CODI_DEFAULT_TAPE);
       using Position = typename Tape::Position;  ///< See PositionalEvaluationTapeInterface.
 
+      using GT = GradientTraits::TraitsImplementation<Gradient>;  ///< Shortcut for traits of gradient.
+
       std::vector<Identifier> inputData;   ///< List of input identifiers. Can be added manually after start() was
                                            ///< called.
       std::vector<Identifier> outputData;  ///< List of output identifiers. Can be added manually before finish() is
@@ -100,11 +120,40 @@ namespace codi {
       std::vector<Gradient> storedAdjoints;     ///< If adjoints of inputs should be stored, before the preaccumulation.
       JacobianCountNonZerosRow<Real> jacobian;  ///< Jacobian for the preaccumulation.
 
+      SparsityPattern pattern;                          ///< Sparsity pattern for the sparse preaccumulation.
+      std::vector<DependencyBits<Real>> dependencies;  ///< Workspace for the sparsity pattern detection.
+      std::vector<size_t> colors;                       ///< Column coloring of the sparsity pattern.
+      std::vector<Real> sparseValues;                   ///< Jacobian entries for the sparsity pattern.
+
+      PreaccumulationStrategy strategy;          ///< Computation of the Jacobian in finish().
+      EliminationGraph<Real, Identifier> graph;  ///< Graph for the vertex elimination strategy.
+
     public:
 
       /// Constructor
       PreaccumulationHelper()
-          : inputData(), outputData(), outputValues(), startPos(), storedAdjoints(), jacobian(0, 0) {}
+          : inputData(),
+            outputData(),
+            outputValues(),
+            startPos(),
+            storedAdjoints(),
+            jacobian(0, 0),
+            pattern(),
+            dependencies(),
+            colors(),
+            sparseValues(),
+            strategy(PreaccumulationStrategy::Sweeps),
+            graph() {}
+
+      /// Set the computation of the Jacobian in finish(). The default is PreaccumulationStrategy::Sweeps.
+      void setStrategy(PreaccumulationStrategy const strategy) {
+        this->strategy = strategy;
+      }
+
+      /// Get the computation of the Jacobian in finish().
+      PreaccumulationStrategy getStrategy() const {
+        return strategy;
+      }
 
       /// Add multiple additional inputs. Inputs need to be of type `Type`. Called after start().
       template<typename... Inputs>
@@ -144,9 +193,32 @@ namespace codi {
         }
       }
 
-      /// Finish the preaccumulation region and perform the preaccumulation. See `addOutput()` for outputs.
+      /// Finish the preaccumulation region and perform the preaccumulation. See `addOutput()` for outputs. The
+      /// Jacobian is computed with the strategy from setStrategy().
       template<typename... Outputs>
       void finish(bool const storeAdjoints, Outputs&... outputs) {
+        finishInternal(false, storeAdjoints, outputs...);
+      }
+
+      /**
+       * @brief Finish the preaccumulation region and perform a sparse preaccumulation. See `addOutput()` for outputs.
+       *
+       * The sparsity pattern of the Jacobian is detected with a propagation of dependency bits, see
+       * Algorithms::computeSparsityPattern. The columns are colored such that columns without a common nonzero are
+       * seeded in the same forward evaluation. Only the entries in the pattern are computed and stored on the tape.
+       *
+       * Falls back to the dense preaccumulation of finish() for tapes that do not support custom adjoint vectors of
+       * DependencyBits, that is, primal value tapes, and for regions that contain low level functions.
+       */
+      template<typename... Outputs>
+      void finishSparse(bool const storeAdjoints, Outputs&... outputs) {
+        finishInternal(true, storeAdjoints, outputs...);
+      }
+
+    private:
+
+      template<typename... Outputs>
+      void finishInternal(bool const sparse, bool const storeAdjoints, Outputs&... outputs) {
         Tape& tape = Type::getTape();
 
         if (tape.isActive()) {
@@ -157,7 +229,13 @@ namespace codi {
           }
 
           tape.setPassive();
-          doPreaccumulation();
+          if (sparse) {
+            doSparsePreaccumulation(TapeTraits::IsJacobianTape<Tape>());
+          } else if (PreaccumulationStrategy::VertexElimination == strategy) {
+            doVertexEliminationPreaccumulation(TapeTraits::IsJacobianTape<Tape>());
+          } else {
+            doPreaccumulation();
+          }
           tape.setActive();
 
           if (storeAdjoints) {
@@ -168,8 +246,6 @@ namespace codi {
         EventSystem<Tape>::notifyPreaccFinishListeners(tape);
       }
 
-    private:
-
       void addInputLogic(Type const& input) {
         EventSystem<Tape>::notifyPreaccAddInputListeners(Type::getTape(), input.getValue(), input.getIdentifier());
         Identifier const& identifier = input.getIdentifier();
@@ -256,67 +332,226 @@ namespace codi {
         tape.endUseAdjointVector();
 
         for (size_t curOut = 0; curOut < outputData.size(); ++curOut) {
-          Type& value = *outputValues[curOut];
-          if (0 != jacobian.nonZerosRow(curOut)) {
-            int nonZerosLeft = jacobian.nonZerosRow(curOut);
-            jacobian.nonZerosRow(curOut) = 0;
-
-            // We need to initialize with the output's current identifier such that it is correctly deleted in
-            // storeManual.
-            Identifier lastIdentifier = value.getIdentifier();
-            bool staggeringActive = false;
-            int curIn = 0;
-
-            // Push statements as long as there are nonzeros left.
-            // If there are more than MaxStatementIntValue nonzeros, then we need to stagger the
-            // statement pushes:
-            // e.g. The reverse mode of w = f(u0, ..., u530) which is \bar u_i += df/du_i * \bar w for i = 0 ... 530 is
-            //      separated into
-            //        Statement 1:
-            //          \bar u_i += df/du_i * \bar t_1 for i = 0 ... 253   (254 entries)
-            //        Statement 2:
-            //          \bar t_1 += \bar w                                 (1 entry)
-            //          \bar u_i += df/du_i * \bar t_2 for i = 254 ... 506 (253 entries)
-            //        Statement 3:
-            //          \bar t_2 += \bar w                                 (1 entry)
-            //          \bar u_i += df/du_i * \bar w for i = 507 ... 530   (24 entries)
-            //
-            while (nonZerosLeft > 0) {
-              // Calculate the number of Jacobians for this statement.
-              int jacobiansForStatement = nonZerosLeft;
-              if (jacobiansForStatement > (int)Config::MaxArgumentSize) {
-                jacobiansForStatement = (int)Config::MaxArgumentSize - 1;
-                if (staggeringActive) {  // Except in the first round, one Jacobian is reserved for the staggering.
-                  jacobiansForStatement -= 1;
-                }
-              }
-              nonZerosLeft -= jacobiansForStatement;  // Update nonzeros so that we know if it is the last round.
-
-              Identifier storedIdentifier = lastIdentifier;
-              // storeManual creates a new identifier which is either the identifier of the output w or the temporary
-              // staggering variables t_1, t_2, ...
-              tape.storeManual(value.getValue(), lastIdentifier, jacobiansForStatement + (int)staggeringActive);
-              if (staggeringActive) {  // Not the first staggering so push the last output.
-                tape.pushJacobianManual(1.0, 0.0, storedIdentifier);
+          int const nonZeros = jacobian.nonZerosRow(curOut);
+          jacobian.nonZerosRow(curOut) = 0;
+
+          storeOutput(*outputValues[curOut], nonZeros, [&](int const curIn) -> Real { return jacobian(curOut, curIn); },
+                      [&](int const curIn) -> Identifier const& { return inputData[curIn]; });
+        }
+      }
+
+      /// Sparse preaccumulation for tapes that support custom adjoint vectors.
+      void doSparsePreaccumulation(std::true_type) {
+        Tape& tape = Type::getTape();
+
+        Position endPos = tape.getPosition();
+        if (hasLowLevelFunctions(endPos)) {
+          // Low level functions cannot propagate the dependency bits.
+          doPreaccumulation();
+          return;
+        }
+
+        // Manage adjoints manually to reduce the impact of locking on the performance.
+        tape.resizeAdjointVector();
+        tape.beginUseAdjointVector();
+
+        Algorithms<Type, false>::computeSparsityPattern(tape, startPos, endPos, inputData.data(), inputData.size(),
+                                                        outputData.data(), outputData.size(), pattern, dependencies);
+        size_t const numberOfColors = pattern.computeColumnColoring(colors);
+
+        // One forward evaluation per GT::dim colors.
+        sparseValues.resize(pattern.getNonZeros());
+        for (size_t firstColor = 0; firstColor < numberOfColors; firstColor += GT::dim) {
+          size_t const endColor = firstColor + GT::dim;
+
+          for (size_t j = 0; j < inputData.size(); ++j) {
+            if (firstColor <= colors[j] && colors[j] < endColor) {
+              GT::at(tape.gradient(inputData[j], AdjointsManagement::Manual), colors[j] - firstColor) =
+                  typename GT::Real(1.0);
+            }
+          }
+
+          tape.evaluateForward(startPos, endPos, AdjointsManagement::Manual);
+
+          for (size_t i = 0; i < outputData.size(); ++i) {
+            Gradient const& tangent = tape.getGradient(outputData[i], AdjointsManagement::Manual);
+            for (size_t pos = pattern.rowBegin(i); pos < pattern.rowEnd(i); ++pos) {
+              size_t const color = colors[pattern.getColumn(pos)];
+              if (firstColor <= color && color < endColor) {
+                sparseValues[pos] = GT::at(tangent, color - firstColor);
               }
+            }
+          }
+
+          for (size_t j = 0; j < inputData.size(); ++j) {
+            tape.gradient(inputData[j], AdjointsManagement::Manual) = Gradient();
+          }
+          for (size_t i = 0; i < outputData.size(); ++i) {
+            tape.gradient(outputData[i], AdjointsManagement::Manual) = Gradient();
+          }
+        }
 
-              // Push the rest of the Jacobians for the statement.
-              while (jacobiansForStatement > 0) {
-                if (Real() != (Real)jacobian(curOut, curIn)) {
-                  tape.pushJacobianManual(jacobian(curOut, curIn), 0.0, inputData[curIn]);
-                  jacobiansForStatement -= 1;
-                }
-                curIn += 1;
+        // Store the Jacobian matrix.
+        tape.resetTo(startPos, true, AdjointsManagement::Manual);
+
+        tape.endUseAdjointVector();
+
+        for (size_t curOut = 0; curOut < outputData.size(); ++curOut) {
+          size_t const rowBegin = pattern.rowBegin(curOut);
+          int nonZeros = 0;
+          for (size_t pos = rowBegin; pos < pattern.rowEnd(curOut); ++pos) {
+            if (Real() != sparseValues[pos]) {
+              nonZeros += 1;
+            }
+          }
+
+          storeOutput(
+              *outputValues[curOut], nonZeros, [&](int const pos) -> Real { return sparseValues[rowBegin + pos]; },
+              [&](int const pos) -> Identifier const& { return inputData[pattern.getColumn(rowBegin + pos)]; });
+        }
+      }
+
+      /// Dense fallback for tapes without support for custom adjoint vectors.
+      void doSparsePreaccumulation(std::false_type) {
+        doPreaccumulation();
+      }
+
+      /// Adds the statements of the region to the elimination graph.
+      struct GraphBuilder {
+        public:
+          EliminationGraph<Real, Identifier>& graph;  ///< Graph of the region.
+
+          /// See JacobianLinearTape::iterateStatements.
+          template<typename JacobianPointer, typename RhsIdentifierPointer>
+          void operator()(Identifier const& lhsIdentifier, Config::ArgumentSize const& numberOfArguments,
+                          JacobianPointer const& jacobians, RhsIdentifierPointer const& rhsIdentifiers,
+                          size_t const& argumentPos) {
+            // Inputs registered in the region have no arguments.
+            size_t const size = Config::StatementInputTag == numberOfArguments ? 0 : (size_t)numberOfArguments;
+            graph.addStatement(lhsIdentifier, size, jacobians, rhsIdentifiers, argumentPos);
+          }
+      };
+
+      /// Vertex elimination for Jacobian tapes, the statements of the region are read from the tape.
+      void doVertexEliminationPreaccumulation(std::true_type) {
+        Tape& tape = Type::getTape();
+
+        Position endPos = tape.getPosition();
+        if (hasLowLevelFunctions(endPos)) {
+          // The Jacobians of low level functions are not available.
+          doPreaccumulation();
+          return;
+        }
+
+        graph.reset(tape.getParameter(TapeParameters::LargestIdentifier) + 1);
+        for (size_t j = 0; j < inputData.size(); ++j) {
+          graph.addInput(inputData[j], j);
+        }
+
+        GraphBuilder builder = {graph};
+        tape.iterateStatements(startPos, endPos, builder);
+
+        for (size_t i = 0; i < outputData.size(); ++i) {
+          graph.addOutput(outputData[i]);
+        }
+
+        graph.eliminate();
+
+        // Store the Jacobian matrix. The adjoints were not used.
+        tape.resetTo(startPos, false);
+
+        for (size_t curOut = 0; curOut < outputData.size(); ++curOut) {
+          int nonZeros = 0;
+          for (size_t k = 0; k < graph.getRowSize(curOut); ++k) {
+            if (Real() != graph.getJacobian(curOut, k)) {
+              nonZeros += 1;
+            }
+          }
+
+          storeOutput(
+              *outputValues[curOut], nonZeros, [&](int const k) -> Real { return graph.getJacobian(curOut, k); },
+              [&](int const k) -> Identifier const& { return inputData[graph.getColumn(curOut, k)]; });
+        }
+      }
+
+      /// Sweep based fallback for tapes that do not provide their statements.
+      void doVertexEliminationPreaccumulation(std::false_type) {
+        doPreaccumulation();
+      }
+
+      /// True if low level functions were recorded since start().
+      bool hasLowLevelFunctions(Position const& endPos) {
+        // The inner position tracks the low level function infos, its nested position is ignored in the comparison.
+        auto endInfoPos = endPos.inner;
+        endInfoPos.inner = startPos.inner.inner;
+
+        return startPos.inner != endInfoPos;
+      }
+
+      /// Store the nonzero entries of one row of the Jacobian as the statements for the output. The entry at pos is
+      /// given by jacobianAt(pos) and identifierAt(pos), zero entries are skipped.
+      template<typename JacobianAt, typename IdentifierAt>
+      void storeOutput(Type& value, int const nonZeros, JacobianAt&& jacobianAt, IdentifierAt&& identifierAt) {
+        Tape& tape = Type::getTape();
+
+        if (0 != nonZeros) {
+          int nonZerosLeft = nonZeros;
+
+          // We need to initialize with the output's current identifier such that it is correctly deleted in
+          // storeManual.
+          Identifier lastIdentifier = value.getIdentifier();
+          bool staggeringActive = false;
+          int curIn = 0;
+
+          // Push statements as long as there are nonzeros left.
+          // If there are more than MaxStatementIntValue nonzeros, then we need to stagger the
+          // statement pushes:
+          // e.g. The reverse mode of w = f(u0, ..., u530) which is \bar u_i += df/du_i * \bar w for i = 0 ... 530 is
+          //      separated into
+          //        Statement 1:
+          //          \bar u_i += df/du_i * \bar t_1 for i = 0 ... 253   (254 entries)
+          //        Statement 2:
+          //          \bar t_1 += \bar w                                 (1 entry)
+          //          \bar u_i += df/du_i * \bar t_2 for i = 254 ... 506 (253 entries)
+          //        Statement 3:
+          //          \bar t_2 += \bar w                                 (1 entry)
+          //          \bar u_i += df/du_i * \bar w for i = 507 ... 530   (24 entries)
+          //
+          while (nonZerosLeft > 0) {
+            // Calculate the number of Jacobians for this statement.
+            int jacobiansForStatement = nonZerosLeft;
+            if (jacobiansForStatement > (int)Config::MaxArgumentSize) {
+              jacobiansForStatement = (int)Config::MaxArgumentSize - 1;
+              if (staggeringActive) {  // Except in the first round, one Jacobian is reserved for the staggering.
+                jacobiansForStatement -= 1;
               }
+            }
+            nonZerosLeft -= jacobiansForStatement;  // Update nonzeros so that we know if it is the last round.
+
+            Identifier storedIdentifier = lastIdentifier;
+            // storeManual creates a new identifier which is either the identifier of the output w or the temporary
+            // staggering variables t_1, t_2, ...
+            tape.storeManual(value.getValue(), lastIdentifier, jacobiansForStatement + (int)staggeringActive);
+            if (staggeringActive) {  // Not the first staggering so push the last output.
+              tape.pushJacobianManual(1.0, 0.0, storedIdentifier);
+            }
 
-              staggeringActive = true;
+            // Push the rest of the Jacobians for the statement.
+            while (jacobiansForStatement > 0) {
+              if (Real() != (Real)jacobianAt(curIn)) {
+                tape.pushJacobianManual(jacobianAt(curIn), 0.0, identifierAt(curIn));
+                jacobiansForStatement -= 1;
+              }
+              curIn += 1;
             }
 
-            value.getIdentifier() = lastIdentifier; /* now set gradient data for the real output value */
-          } else {
-            // Disable tape index since there is no dependency.
-            tape.destroyIdentifier(value.value(), value.getIdentifier());
+            staggeringActive = true;
           }
+
+          value.getIdentifier() = lastIdentifier; /* now set gradient data for the real output value */
+        } else {
+          // Disable tape index since there is no dependency.
+          tape.destroyIdentifier(value.value(), value.getIdentifier());
         }
       }
   };
@@ -357,6 +592,19 @@ namespace codi {
         CODI_UNUSED(storeAdjoints, outputs...);
         // Do nothing.
       }
+
+      /// Does nothing.
+      template<typename... Outputs>
+      void finishSparse(bool const storeAdjoints, Outputs&... outputs) {
+        CODI_UNUSED(storeAdjoints, outputs...);
+        // Do nothing.
+      }
+
+      /// Does nothing.
+      void setStrategy(PreaccumulationStrategy const strategy) {
+        CODI_UNUSED(strategy);
+        // Do nothing.
+      }
   };
 
   /// Specialize PreaccumulationHelper for forward tapes.
@@ -452,6 +700,17 @@ namespace codi {
         }
       }
 
+      /// Same as finish(), the tags do not depend on the sparsity.
+      template<typename... Outputs>
+      void finishSparse(bool const storeAdjoints, Outputs&... outputs) {
+        finish(storeAdjoints, outputs...);
+      }
+
+      /// Does nothing, the tags do not depend on the strategy.
+      void setStrategy(PreaccumulationStrategy const strategy) {
+        CODI_UNUSED(strategy);
+      }
+
     private:
 
       /// Terminator for the recursive implementation.
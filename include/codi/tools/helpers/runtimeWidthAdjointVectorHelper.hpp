@@ -0,0 +1,485 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "../../config.h"
+#include "../../expressions/lhsExpressionInterface.hpp"
+#include "../../misc/macros.hpp"
+#include "../../tapes/interfaces/fullTapeInterface.hpp"
+#include "../../tapes/misc/vectorAccessInterface.hpp"
+#include "../../traits/gradientTraits.hpp"
+#include "../../traits/realTraits.hpp"
+#include "../data/direction.hpp"
+#include "customAdjointVectorHelper.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+  /**
+   * @brief Implementation of VectorAccessInterface for adjoint matrices with a runtime width.
+   *
+   * The adjoints of identifier i are stored in the row data[i * width, (i + 1) * width). No bounds checking is
+   * performed.
+   *
+   * @tparam T_Real        The computation type of a tape, usually chosen as ActiveType::Real.
+   * @tparam T_Identifier  The adjoint/tangent identification of a tape, usually chosen as ActiveType::Identifier.
+   */
+  template<typename T_Real, typename T_Identifier>
+  struct RuntimeWidthVectorAccess : public VectorAccessInterface<T_Real, T_Identifier> {
+    public:
+
+      using Real = CODI_DD(T_Real, double);           ///< See RuntimeWidthVectorAccess.
+      using Identifier = CODI_DD(T_Identifier, int);  ///< See RuntimeWidthVectorAccess.
+
+    private:
+
+      Real* data;
+      size_t width;
+
+      std::vector<Real> lhs;
+
+    public:
+
+      /// Constructor
+      RuntimeWidthVectorAccess(Real* data, size_t width) : data(data), width(width), lhs(width) {}
+
+      /*******************************************************************************/
+      /// @name Misc
+
+      /// \copydoc codi::VectorAccessInterface::getVectorSize
+      size_t getVectorSize() const {
+        return width;
+      }
+
+      /// \copydoc codi::VectorAccessInterface::isLhsZero
+      bool isLhsZero() {
+        for (size_t i = 0; i < width; ++i) {
+          if (!RealTraits::isTotalZero(lhs[i])) {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      /// \copydoc codi::VectorAccessInterface::clone
+      VectorAccessInterface<Real, Identifier>* clone() const {
+        return new RuntimeWidthVectorAccess(data, width);
+      }
+
+      /*******************************************************************************/
+      /// @name Indirect adjoint access
+
+      /// \copydoc codi::VectorAccessInterface::setLhsAdjoint
+      void setLhsAdjoint(Identifier const& index) {
+        Real* row = getRow(index);
+        for (size_t i = 0; i < width; ++i) {
+          lhs[i] = row[i];
+          row[i] = Real();
+        }
+      }
+
+      /// \copydoc codi::VectorAccessInterface::updateAdjointWithLhs
+      void updateAdjointWithLhs(Identifier const& index, Real const& jacobian) {
+        Real* row = getRow(index);
+        for (size_t i = 0; i < width; ++i) {
+          row[i] += jacobian * lhs[i];
+        }
+      }
+
+      /*******************************************************************************/
+      /// @name Indirect tangent access
+
+      /// \copydoc codi::VectorAccessInterface::setLhsTangent
+      void setLhsTangent(Identifier const& index) {
+        Real* row = getRow(index);
+        for (size_t i = 0; i < width; ++i) {
+          row[i] = lhs[i];
+          lhs[i] = Real();
+        }
+      }
+
+      /// \copydoc codi::VectorAccessInterface::updateTangentWithLhs
+      void updateTangentWithLhs(Identifier const& index, Real const& jacobian) {
+        Real* row = getRow(index);
+        for (size_t i = 0; i < width; ++i) {
+          lhs[i] += jacobian * row[i];
+        }
+      }
+
+      /*******************************************************************************/
+      /// @name Direct adjoint access
+
+      /// \copydoc codi::VectorAccessInterface::resetAdjoint
+      void resetAdjoint(Identifier const& index, size_t dim) {
+        getRow(index)[dim] = Real();
+      }
+
+      /// \copydoc codi::VectorAccessInterface::resetAdjointVec
+      void resetAdjointVec(Identifier const& index) {
+        std::fill_n(getRow(index), width, Real());
+      }
+
+      /// \copydoc codi::VectorAccessInterface::getAdjoint
+      Real getAdjoint(Identifier const& index, size_t dim) {
+        return getRow(index)[dim];
+      }
+
+      /// \copydoc codi::VectorAccessInterface::getAdjointVec
+      void getAdjointVec(Identifier const& index, Real* const vec) {
+        std::copy_n(getRow(index), width, vec);
+      }
+
+      /// \copydoc codi::VectorAccessInterface::getAdjointVec
+      Real const* getAdjointVec(Identifier const& index) {
+        return getRow(index);
+      }
+
+      /// \copydoc codi::VectorAccessInterface::updateAdjoint
+      void updateAdjoint(Identifier const& index, size_t dim, Real const& adjoint) {
+        getRow(index)[dim] += adjoint;
+      }
+
+      /// \copydoc codi::VectorAccessInterface::updateAdjointVec
+      void updateAdjointVec(Identifier const& index, Real const* const vec) {
+        Real* row = getRow(index);
+        for (size_t i = 0; i < width; ++i) {
+          row[i] += vec[i];
+        }
+      }
+
+      /*******************************************************************************/
+      /// @name Primal access
+
+      /// \copydoc codi::VectorAccessInterface::setPrimal <br><br>
+      /// Implementation: Not implemented, empty function.
+      void setPrimal(Identifier const& index, Real const& primal) {
+        CODI_UNUSED(index, primal);
+      }
+
+      /// \copydoc codi::VectorAccessInterface::getPrimal <br><br>
+      /// Implementation: Not implemented, returns zero.
+      Real getPrimal(Identifier const& index) {
+        CODI_UNUSED(index);
+
+        return Real();
+      }
+
+      /// \copydoc codi::VectorAccessInterface::hasPrimals <br><br>
+      /// Implementation: Always returns false.
+      bool hasPrimals() {
+        return false;
+      }
+
+    private:
+
+      CODI_INLINE Real* getRow(Identifier const& index) {
+        return &data[(size_t)index * width];
+      }
+  };
+
+  /**
+   * @brief Evaluates a recorded tape with an adjoint matrix whose width is chosen at runtime.
+   *
+   * The tape is recorded with a scalar CoDiPack type, e.g. codi::RealReverse. The adjoints are stored in a contiguous
+   * matrix with one row of getWidth() entries per identifier. The width can be changed between evaluations, so the
+   * same recording can compute 1, 8 or 64 directions per sweep.
+   *
+   * The matrix is evaluated in blocks of the widths 1, 2, 4, 8, 16, 32 and 64, e.g. 10 = 8 + 2. For each block the
+   * columns are copied into a vector of AlignedDirection adjoints of the block width, evaluated and copied back. A
+   * matrix of width one is evaluated directly.
+   *
+   * The tape needs to support custom adjoint vectors, see CustomAdjointVectorEvaluationTapeInterface. This is the case
+   * for all Jacobian tapes.
+   *
+   * \code{.cpp}
+   *   codi::RuntimeWidthAdjointVectorHelper<codi::RealReverse> helper(outputs.size());
+   *   for (size_t j = 0; j < outputs.size(); ++j) {
+   *     helper.gradient(outputs[j].getIdentifier(), j) = 1.0;
+   *   }
+   *   helper.evaluate();
+   *   // helper.getGradient(inputs[i].getIdentifier(), j) is the entry (j, i) of the Jacobian.
+   * \endcode
+   *
+   * @tparam T_Type  The underlying CoDiPack type.
+   */
+  template<typename T_Type>
+  struct RuntimeWidthAdjointVectorHelper : public CustomAdjointVectorInterface<T_Type> {
+    public:
+
+      /// See RuntimeWidthAdjointVectorHelper.
+      using Type = CODI_DD(T_Type, CODI_DEFAULT_LHS_EXPRESSION);
+
+      using Base = CustomAdjointVectorInterface<Type>;  ///< Abbreviation for the base class.
+
+      using Real = typename Type::Real;              ///< See LhsExpressionInterface.
+      using Identifier = typename Type::Identifier;  ///< See LhsExpressionInterface.
+
+      /// See LhsExpressionInterface
+      using Tape = CODI_DD(typename Type::Tape, CODI_DEFAULT_TAPE);
+      using Position = typename Tape::Position;  ///< See PositionalEvaluationTapeInterface.
+
+      static size_t constexpr MaxBlockWidth = 64;  ///< Largest block width of the evaluation.
+
+      static_assert(std::is_floating_point<Real>::value, "Runtime width adjoints require a scalar floating point type.");
+
+    private:
+
+      size_t width;
+      size_t rows;
+
+      std::vector<Real> adjointMatrix;
+
+      // One adjoint vector per block width, the position in the tuple is the binary logarithm of the width.
+      using BlockAdjoints =
+          std::tuple<std::vector<Real>, std::vector<AlignedDirection<Real, 2>>, std::vector<AlignedDirection<Real, 4>>,
+                     std::vector<AlignedDirection<Real, 8>>, std::vector<AlignedDirection<Real, 16>>,
+                     std::vector<AlignedDirection<Real, 32>>, std::vector<AlignedDirection<Real, 64>>>;
+      BlockAdjoints blockAdjoints;
+
+      Real zeroValue;
+
+      RuntimeWidthVectorAccess<Real, Identifier>* adjointInterface;
+
+    public:
+
+      /// Constructor
+      explicit RuntimeWidthAdjointVectorHelper(size_t width = 1)
+          : Base(), width(width), rows(0), adjointMatrix(), blockAdjoints(), zeroValue(), adjointInterface(nullptr) {
+        codiAssert(0 != width);
+      }
+
+      /// Destructor
+      ~RuntimeWidthAdjointVectorHelper() {
+        if (nullptr != adjointInterface) {
+          delete adjointInterface;
+        }
+      }
+
+      /// Number of adjoint entries per identifier.
+      size_t getWidth() const {
+        return width;
+      }
+
+      /// Change the number of adjoint entries per identifier. All adjoints are set to zero.
+      void setWidth(size_t newWidth) {
+        codiAssert(0 != newWidth);
+
+        width = newWidth;
+        rows = 0;
+        checkAdjointMatrixSize();
+      }
+
+      /*******************************************************************************/
+      /// @name Implementation of CustomAdjointVectorInterface interface
+      /// @{
+
+      /// \copydoc codi::CustomAdjointVectorInterface::clearAdjoints()
+      void clearAdjoints() {
+        std::fill_n(adjointMatrix.data(), rows * width, Real());
+      }
+
+      /// \copydoc codi::CustomAdjointVectorInterface::deleteAdjointVector()
+      void deleteAdjointVector() {
+        rows = 0;
+        adjointMatrix.resize(0);
+        adjointMatrix.shrink_to_fit();
+        blockAdjoints = BlockAdjoints();
+      }
+
+      /// \copydoc codi::CustomAdjointVectorInterface::evaluate()
+      void evaluate(Position const& start, Position const& end) {
+        checkAdjointMatrixSize();
+
+        evaluateBlocks<false>(start, end);
+      }
+      using Base::evaluate;
+
+      /// \copydoc codi::CustomAdjointVectorInterface::evaluateForward()
+      void evaluateForward(Position const& start, Position const& end) {
+        checkAdjointMatrixSize();
+
+        evaluateBlocks<true>(start, end);
+      }
+      using Base::evaluateForward;
+
+      /// \copydoc codi::CustomAdjointVectorInterface::getVectorInterface()
+      VectorAccessInterface<Real, Identifier>* getVectorInterface() {
+        if (nullptr != adjointInterface) {
+          delete adjointInterface;
+        }
+
+        checkAdjointMatrixSize();
+        adjointInterface = new RuntimeWidthVectorAccess<Real, Identifier>(adjointMatrix.data(), width);
+        return adjointInterface;
+      }
+
+      /// @}
+      /*******************************************************************************/
+      /// @name Gradient access methods
+      /// @{
+
+      /// Pointer to the row of adjoints of the identifier. Unchecked access.
+      Real* adjoints(Identifier const& identifier) {
+        return &adjointMatrix[(size_t)identifier * width];
+      }
+
+      /// Get the adjoint entry. Checked access.
+      Real getGradient(Identifier const& identifier, size_t dim) const {
+        if (0 != identifier && (size_t)identifier < rows) {
+          return adjointMatrix[(size_t)identifier * width + dim];
+        } else {
+          return Real();
+        }
+      }
+
+      /// Get a reference to the adjoint entry. Checked access.
+      Real& gradient(Identifier const& identifier, size_t dim) {
+        checkAdjointMatrixSize();
+
+        if (0 != identifier && (size_t)identifier < rows) {
+          return adjoints(identifier)[dim];
+        } else {
+          zeroValue = Real();
+          return zeroValue;
+        }
+      }
+
+      /// @}
+
+    private:
+
+      template<bool forward>
+      void evaluateBlocks(Position const& start, Position const& end) {
+        if (1 == width) {
+          evaluateTape<forward>(start, end, adjointMatrix.data());
+          return;
+        }
+
+        size_t column = 0;
+        while (column < width) {
+          size_t blockWidth = MaxBlockWidth;
+          while (blockWidth > width - column) {
+            blockWidth /= 2;
+          }
+
+          switch (blockWidth) {
+            case 1:
+              evaluateColumns<forward, 0>(start, end, column);
+              break;
+            case 2:
+              evaluateColumns<forward, 1>(start, end, column);
+              break;
+            case 4:
+              evaluateColumns<forward, 2>(start, end, column);
+              break;
+            case 8:
+              evaluateColumns<forward, 3>(start, end, column);
+              break;
+            case 16:
+              evaluateColumns<forward, 4>(start, end, column);
+              break;
+            case 32:
+              evaluateColumns<forward, 5>(start, end, column);
+              break;
+            case 64:
+              evaluateColumns<forward, 6>(start, end, column);
+              break;
+            default:
+              CODI_EXCEPTION("Unsupported block width %d.", (int)blockWidth);
+              break;
+          }
+
+          column += blockWidth;
+        }
+      }
+
+      /// Copy the block of columns that starts at column into the adjoints of the block width, evaluate and copy back.
+      template<bool forward, size_t blockPos>
+      void evaluateColumns(Position const& start, Position const& end, size_t column) {
+        using Adjoints = typename std::tuple_element<blockPos, BlockAdjoints>::type;
+        using Adjoint = typename Adjoints::value_type;
+
+        size_t constexpr blockWidth = GradientTraits::dim<Adjoint>();
+
+        Adjoints& adjoints = std::get<blockPos>(blockAdjoints);
+        if (adjoints.size() < rows) {
+          adjoints.resize(rows);
+        }
+
+        for (size_t i = 0; i < rows; ++i) {
+          Real const* row = &adjointMatrix[i * width + column];
+          for (size_t d = 0; d < blockWidth; ++d) {
+            GradientTraits::at(adjoints[i], d) = row[d];
+          }
+        }
+
+        evaluateTape<forward>(start, end, adjoints.data());
+
+        for (size_t i = 0; i < rows; ++i) {
+          Real* row = &adjointMatrix[i * width + column];
+          for (size_t d = 0; d < blockWidth; ++d) {
+            row[d] = GradientTraits::at(adjoints[i], d);
+          }
+        }
+      }
+
+      template<bool forward, typename Adjoint>
+      void evaluateTape(Position const& start, Position const& end, Adjoint* data) {
+        if (forward) {
+          Base::tape.evaluateForward(start, end, data);
+        } else {
+          Base::tape.evaluate(start, end, data);
+        }
+      }
+
+      void checkAdjointMatrixSize() {
+        size_t const requiredRows = (size_t)Base::tape.getParameter(TapeParameters::LargestIdentifier) + 1;
+        if (rows < requiredRows) {
+          // Keep the existing rows, new rows are zero. The rows are discarded if the width has changed.
+          if (0 == rows) {
+            adjointMatrix.clear();
+          }
+
+          rows = requiredRows;
+          adjointMatrix.resize(rows * width);
+        }
+      }
+  };
+}
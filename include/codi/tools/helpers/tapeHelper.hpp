@@ -43,6 +43,9 @@
 #include "../algorithms.hpp"
 #include "../data/hessian.hpp"
 #include "../data/jacobian.hpp"
+#include "../data/sparseHessian.hpp"
+#include "../data/sparseJacobian.hpp"
+#include "../data/sparsityPattern.hpp"
 
 /** \copydoc codi::Namespace */
 namespace codi {
@@ -85,9 +88,20 @@ namespace codi {
    * createJacobian(), createHessian(), createPrimalVectorInput() and createPrimalVectorOutput(). Each create function
    * has a corresponding delete function that deletes the objects.
    *
+   * Sparse Jacobians can be evaluated with fewer tape sweeps. A SparseJacobianType is created with
+   * createSparseJacobian(), either for a given sparsity pattern or, for Jacobian tapes, with the pattern detected from
+   * the recording. evalJacobian() then only computes the entries of the pattern, see Algorithms::computeSparseJacobian.
+   *
    * The computation of the Hessian could be performed as follows.
    * \snippet examples/Example_16_TapeHelper.cpp Hessian evaluation
    *
+   * Products with the transposed Jacobian or the Hessians can be computed with evalJacobianTransposeProducts() and
+   * evalHessianVectorProducts() without the assembly of the matrices.
+   *
+   * Sparse Hessians are created with createSparseHessian(), either for a given symmetric sparsity pattern or, for
+   * primal value tapes, with the pattern detected at the current point. evalHessian() then only computes the entries
+   * of the pattern, see Algorithms::computeSparseHessianPrimalValueTape.
+   *
    * A simple reverse evaluation works like this.
    * \snippet examples/Example_16_TapeHelper.cpp Reverse evaluation
    *
@@ -113,8 +127,10 @@ namespace codi {
 
       using PassiveReal = typename RealTraits::PassiveReal<Real>;  ///< Passive base of the CoDiPack type.
 
-      using JacobianType = Jacobian<PassiveReal>;  ///< Type of the Jacobian.
-      using HessianType = Hessian<PassiveReal>;    ///< Type of the Hessian.
+      using JacobianType = Jacobian<PassiveReal>;              ///< Type of the Jacobian.
+      using SparseJacobianType = SparseJacobian<PassiveReal>;  ///< Type of the sparse Jacobian.
+      using HessianType = Hessian<PassiveReal>;                ///< Type of the Hessian.
+      using SparseHessianType = SparseHessian<PassiveReal>;    ///< Type of the sparse Hessian.
 
     protected:
 
@@ -173,6 +189,22 @@ namespace codi {
         return *jacPointer;
       }
 
+      /**
+       * @brief Create a sparse Jacobian with the given sparsity pattern.
+       *
+       * Should only be called after the tape has been recorded. The pattern needs m rows and n columns and has to
+       * contain all nonzero entries of the Jacobian.
+       * Needs to be deleted with deleteSparseJacobian.
+       *
+       * @return A sparse Jacobian with the size m,n.
+       */
+      SparseJacobianType& createSparseJacobian(SparsityPattern const& pattern) {
+        codiAssert(pattern.getM() == getOutputSize() && pattern.getN() == getInputSize());
+        SparseJacobianType* jacPointer = new SparseJacobianType(pattern);
+
+        return *jacPointer;
+      }
+
       /**
        * @brief Create a Hessian that can hold the Hessian of the recorded tape.
        *
@@ -187,6 +219,22 @@ namespace codi {
         return *hesPointer;
       }
 
+      /**
+       * @brief Create a sparse Hessian with the given sparsity pattern.
+       *
+       * Should only be called after the tape has been recorded. The pattern needs n rows and n columns, it has to be
+       * symmetric and contain all nonzero entries of the Hessians of all outputs.
+       * Needs to be deleted with deleteSparseHessian.
+       *
+       * @return A sparse Hessian with the size m,n.
+       */
+      SparseHessianType& createSparseHessian(SparsityPattern const& pattern) {
+        codiAssert(pattern.getM() == getInputSize() && pattern.getN() == getInputSize());
+        SparseHessianType* hesPointer = new SparseHessianType(getOutputSize(), pattern);
+
+        return *hesPointer;
+      }
+
       /**
        * @brief Create a primal vector that can hold the primal seeding of the input variables.
        *
@@ -225,6 +273,13 @@ namespace codi {
         delete jacPointer;
       }
 
+      /// Delete the sparse Jacobian that was created with a createSparseJacobian function.
+      void deleteSparseJacobian(SparseJacobianType& jac) {
+        SparseJacobianType* jacPointer = &jac;
+
+        delete jacPointer;
+      }
+
       /// Delete the Hessian that was created with createHessian function.
       void deleteHessian(HessianType& hes) {
         HessianType* hesPointer = &hes;
@@ -232,6 +287,13 @@ namespace codi {
         delete hesPointer;
       }
 
+      /// Delete the sparse Hessian that was created with a createSparseHessian function.
+      void deleteSparseHessian(SparseHessianType& hes) {
+        SparseHessianType* hesPointer = &hes;
+
+        delete hesPointer;
+      }
+
       /// Delete a primal vector that was created with createPrimalVectorInput or createPrimalVectorOutput.
       void deletePrimalVector(Real* vec) {
         delete[] vec;
@@ -434,6 +496,50 @@ namespace codi {
         evalJacobian(jac);
       }
 
+      /**
+       * @brief Evaluates the entries of a sparse Jacobian of the recorded tape.
+       *
+       * Only the entries in the pattern of the sparse Jacobian are computed. The algorithm selects the evaluation mode
+       * with fewer colors, see Algorithms::computeSparseJacobian. It will also use the vector mode if the underlying
+       * tape was configured with such a mode.
+       *
+       * @param[out] jac  The storage for the Jacobian which is evaluated. Should be created with createSparseJacobian.
+       */
+      CODI_INLINE void evalJacobian(SparseJacobianType& jac) {
+        using Algo = Algorithms<Type>;
+        typename Algo::EvaluationType evalType = Algo::getSparseEvaluationChoice(jac);
+
+        if (Algo::EvaluationType::Forward == evalType) {
+          changeStateToForwardEvaluation();
+        } else if (Algo::EvaluationType::Reverse == evalType) {
+          changeStateToReverseEvaluation();
+        } else {
+          CODI_EXCEPTION("Evaluation type not implemented.");
+        }
+
+        Algo::template computeSparseJacobian<PassiveReal, false>(tape, tape.getZeroPosition(), tape.getPosition(),
+                                                                 inputValues.data(), inputValues.size(),
+                                                                 outputValues.data(), outputValues.size(), jac);
+      }
+
+      /**
+       * @brief Re-evaluate the tape with new input variables and compute the sparse Jacobian at the new inputs.
+       *
+       * This method is a shortcut for calling evalPrimal and evalJacobian in succession.
+       *
+       * @param[in]    x  The new seeding vector for the primal input variables. The sequence of variables is the same
+       *                  as for the register input call. The vector should be created with createPrimalVectorInput.
+       * @param[out] jac  The storage for the Jacobian which is evaluated. Should be created with createSparseJacobian.
+       * @param[out]   y  The result of the primal evaluation. The sequence of variables is the same as for the register
+       *                  output call. If the pointer is a null pointer then the result is not stored. The vector should
+       *                  be created with createPrimalVectorOutput.
+       */
+      CODI_INLINE void evalJacobianAt(Real const* x, SparseJacobianType& jac, Real* y = nullptr) {
+        evalPrimal(x, y);
+
+        evalJacobian(jac);
+      }
+
       /**
        * @brief Evaluates the full Jacobian of the recorded tape with a custom Jacobian type chosen by the user.
        *
@@ -459,6 +565,25 @@ namespace codi {
                                                                outputValues.data(), outputValues.size(), jac);
       }
 
+      /**
+       * @brief Evaluates the products of the transposed Jacobian of the recorded tape with multiple vectors.
+       *
+       * Computes \f$ J^T w_b \f$ without the assembly of the Jacobian. One reverse evaluation is performed for each
+       * batch of vectors, the batch size is the vector size of the underlying tape. See
+       * Algorithms::computeJacobianTransposeProducts.
+       *
+       * @param[in]      w  The weights of the outputs, w[b * m + i] is the weight of output i in vector b.
+       * @param[out]   jtw  The products, jtw[b * n + j] is the entry of input j in product b.
+       * @param[in]  count  Number of vectors.
+       */
+      CODI_INLINE void evalJacobianTransposeProducts(PassiveReal const* w, PassiveReal* jtw, size_t const count = 1) {
+        changeStateToReverseEvaluation();
+
+        Algorithms<Type>::template computeJacobianTransposeProducts<PassiveReal, false>(
+            tape, tape.getZeroPosition(), tape.getPosition(), inputValues.data(), inputValues.size(),
+            outputValues.data(), outputValues.size(), w, count, jtw);
+      }
+
       /**
        * @brief Evaluates the full Hessian of the recorded tape.
        *
@@ -500,6 +625,60 @@ namespace codi {
         cast().evalHessian(hes, jac);
       }
 
+      /**
+       * @brief Evaluates the products of the Hessians of the recorded tape with multiple vectors.
+       *
+       * Computes \f$ H_i v_b \f$ for all outputs i without the assembly of the Hessians. A forward-over-reverse
+       * evaluation is performed for each batch of vectors, the batch size is the second order vector size of the
+       * underlying tape. See Algorithms::computeHessianVectorProductsPrimalValueTape.
+       *
+       * @param[in]      v  The vectors, v[b * n + j] is the entry of input j in vector b.
+       * @param[out]    hv  The products, hv[(b * m + i) * n + k] is the entry k of \f$ H_i v_b \f$.
+       * @param[in]  count  Number of vectors.
+       */
+      void evalHessianVectorProducts(PassiveReal const* v, PassiveReal* hv, size_t const count = 1);
+
+      /**
+       * @brief Evaluates the entries of sparse Hessians of the recorded tape.
+       *
+       * Only the entries in the pattern of the sparse Hessian are computed with compressed evaluations, see
+       * Algorithms::computeSparseHessianPrimalValueTape. It will also use the vector mode if the underlying tape was
+       * configured with such a mode. The sparse Hessian should be created once and reused for all points, since the
+       * detection of its pattern costs as much as a dense Hessian evaluation.
+       *
+       * @param[out] hes  The storage for the Hessian which is evaluated. Should be created with createSparseHessian.
+       * @param[out] jac  If also the Jacobian should be computed alongside the Hessian, a storage for the Jacobian can
+       *                  be provided. Must have the correct size and should be created with createJacobian.
+       *
+       * @tparam Jac  Has to implement JacobianInterface.
+       */
+      template<typename Jac = DummyJacobian>
+      void evalHessian(SparseHessianType& hes, Jac& jac = StaticDummy<DummyJacobian>::dummy);
+
+      /**
+       * @brief Re-evaluate the tape with new input variables and compute the sparse Hessians at the new inputs.
+       *
+       * This method is a shortcut for calling evalPrimal and evalHessian.
+       *
+       * @param[in]    x  The new seeding vector for the primal input variables. The sequence of variables is the same
+       *                  as for the register input call. The vector should be created with createPrimalVectorInput.
+       * @param[out] hes  The storage for the Hessian which is evaluated. Should be created with createSparseHessian.
+       * @param[out]   y  The result of the primal evaluation. The sequence of variables is the same as for the register
+       *                  output call. If the pointer is a null pointer then the result is not stored. The vector should
+       *                  be created with createPrimalVectorOutput.
+       * @param[out] jac  If also the Jacobian should be computed alongside the Hessian, a storage for the Jacobian can
+       *                  be provided. Needs to have the correct size and should be created with createJacobian.
+       *
+       * @tparam Jac  Has to implement JacobianInterface.
+       */
+      template<typename Jac = DummyJacobian>
+      CODI_INLINE void evalHessianAt(Real const* x, SparseHessianType& hes, Real* y = nullptr,
+                                     Jac& jac = StaticDummy<DummyJacobian>::dummy) {
+        evalPrimal(x, y);
+
+        cast().evalHessian(hes, jac);
+      }
+
     protected:
 
       /// Cast to the implementing class.
@@ -549,6 +728,14 @@ namespace codi {
       /// Missing implementation will yield linker errors.
       template<typename Jac = DummyJacobian>
       void evalHessian(typename Base::HessianType& hes, Jac& jac = StaticDummy<DummyJacobian>::dummy);
+
+      /// Missing implementation will yield linker errors.
+      template<typename Jac = DummyJacobian>
+      void evalHessian(typename Base::SparseHessianType& hes, Jac& jac = StaticDummy<DummyJacobian>::dummy);
+
+      /// Missing implementation will yield linker errors.
+      void evalHessianVectorProducts(typename Base::PassiveReal const* v, typename Base::PassiveReal* hv,
+                                    size_t const count = 1);
   };
   // clang-format on
 
@@ -566,6 +753,35 @@ namespace codi {
 
       using Base = TapeHelperBase<Type, TapeHelperJacobi<Type>>;  ///< Base class abbreviation.
 
+      using SparseJacobianType = typename Base::SparseJacobianType;  ///< See TapeHelperBase.
+
+    private:
+
+      std::vector<std::vector<size_t>> indexSets;  ///< Workspace for the sparsity pattern detection.
+
+    public:
+
+      using Base::createSparseJacobian;
+
+      /**
+       * @brief Create a sparse Jacobian with the sparsity pattern of the recorded tape.
+       *
+       * The pattern is detected with Algorithms::computeSparsityPattern. It is the pattern of the recorded Jacobian
+       * values, i.e. entries whose Jacobians were zero or skipped during the recording are not part of it.
+       * Needs to be deleted with deleteSparseJacobian.
+       *
+       * @return A sparse Jacobian with the size m,n.
+       */
+      SparseJacobianType& createSparseJacobian() {
+        SparsityPattern pattern;
+        Algorithms<Type>::computeSparsityPattern(this->tape, this->tape.getZeroPosition(), this->tape.getPosition(),
+                                                 this->inputValues.data(), this->inputValues.size(),
+                                                 this->outputValues.data(), this->outputValues.size(), pattern,
+                                                 indexSets);
+
+        return *new SparseJacobianType(std::move(pattern));
+      }
+
       /// Throws an exception since primal evaluations are not support by Jacobian tapes.
       virtual void evalPrimal(Real const* x, Real* y = nullptr) {
         CODI_UNUSED(x, y);
@@ -585,6 +801,28 @@ namespace codi {
             "Please use codi::RealReversePrimal or codi::RealReversePrimalIndex types for this kind of functionality "
             "or the EvaluationHelper class.");
       }
+
+      /// Throws an exception since primal evaluations are not supported by Jacobian tapes.
+      template<typename Jac = DummyJacobian>
+      void evalHessian(typename Base::SparseHessianType& hes, Jac& jac = StaticDummy<DummyJacobian>::dummy) {
+        CODI_UNUSED(hes, jac);
+
+        CODI_EXCEPTION(
+            "No direct Hessian evaluation for Jacobian tapes. "
+            "Please use codi::RealReversePrimal or codi::RealReversePrimalIndex types for this kind of functionality "
+            "or Algorithms::computeSparseHessian.");
+      }
+
+      /// Throws an exception since primal evaluations are not supported by Jacobian tapes.
+      void evalHessianVectorProducts(typename Base::PassiveReal const* v, typename Base::PassiveReal* hv,
+                                    size_t const count = 1) {
+        CODI_UNUSED(v, hv, count);
+
+        CODI_EXCEPTION(
+            "No direct Hessian evaluation for Jacobian tapes. "
+            "Please use codi::RealReversePrimal or codi::RealReversePrimalIndex types for this kind of functionality "
+            "or Algorithms::computeHessianVectorProducts.");
+      }
   };
 
   /// TapeHelper implementation for the Jacobian taping strategy.
@@ -601,6 +839,32 @@ namespace codi {
 
       using Base = TapeHelperBase<Type, TapeHelperPrimal<Type>>;  ///< Base class abbreviation.
 
+      using SparseHessianType = typename Base::SparseHessianType;  ///< See TapeHelperBase.
+
+      using Base::createSparseHessian;
+
+      /**
+       * @brief Create a sparse Hessian with the sparsity pattern at the current point.
+       *
+       * The pattern is detected with Algorithms::computeHessianSparsityPatternPrimalValueTape. It is value based, the
+       * evaluation of the pattern has the cost of a dense Hessian evaluation. Therefore, the sparse Hessian has to be
+       * created once and reused for the evaluations at all other points, which then need fewer tape evaluations.
+       * Creating it for each point is more expensive than the dense evaluation with a HessianType.
+       * Needs to be deleted with deleteSparseHessian.
+       *
+       * @return A sparse Hessian with the size m,n.
+       */
+      SparseHessianType& createSparseHessian() {
+        this->changeStateToReverseEvaluation();
+
+        SparsityPattern pattern;
+        Algorithms<Type>::computeHessianSparsityPatternPrimalValueTape(
+            this->tape, this->tape.getZeroPosition(), this->tape.getPosition(), this->inputValues.data(),
+            this->inputValues.size(), this->outputValues.data(), this->outputValues.size(), pattern);
+
+        return *new SparseHessianType(this->outputValues.size(), std::move(pattern));
+      }
+
       /// \copydoc TapeHelperBase::evalPrimal
       virtual void evalPrimal(Real const* x, Real* y = nullptr) {
         for (size_t j = 0; j < this->inputValues.size(); j += 1) {
@@ -635,6 +899,26 @@ namespace codi {
             this->tape, this->tape.getZeroPosition(), this->tape.getPosition(), this->inputValues.data(),
             this->inputValues.size(), this->outputValues.data(), this->outputValues.size(), hes, jac);
       }
+
+      /// \copydoc TapeHelperBase::evalHessianVectorProducts
+      void evalHessianVectorProducts(typename Base::PassiveReal const* v, typename Base::PassiveReal* hv,
+                                    size_t const count = 1) {
+        this->changeStateToReverseEvaluation();
+
+        Algorithms<Type>::computeHessianVectorProductsPrimalValueTape(
+            this->tape, this->tape.getZeroPosition(), this->tape.getPosition(), this->inputValues.data(),
+            this->inputValues.size(), this->outputValues.data(), this->outputValues.size(), v, count, hv);
+      }
+
+      /// \copydoc TapeHelperBase::evalHessian(SparseHessianType&, Jac&)
+      template<typename Jac = DummyJacobian>
+      void evalHessian(SparseHessianType& hes, Jac& jac = StaticDummy<DummyJacobian>::dummy) {
+        this->changeStateToReverseEvaluation();
+
+        Algorithms<Type>::computeSparseHessianPrimalValueTape(
+            this->tape, this->tape.getZeroPosition(), this->tape.getPosition(), this->inputValues.data(),
+            this->inputValues.size(), this->outputValues.data(), this->outputValues.size(), hes, jac);
+      }
   };
 
   /// See TapeHelperBase.
@@ -41,9 +41,11 @@
 #include "../../data/direction.hpp"
 #include "openMPAtomic.hpp"
 #include "openMPMutex.hpp"
+#include "openMPReplicatedGlobalAdjoints.hpp"
 #include "openMPStaticThreadLocalPointer.hpp"
 #include "openMPSynchronization.hpp"
 #include "openMPThreadInformation.hpp"
+#include "openMPWavefrontEvaluator.hpp"
 
 /** \copydoc codi::Namespace */
 namespace codi {
@@ -62,11 +64,15 @@ namespace codi {
 
   /// \copydoc codi::RealReverseIndexGen <br><br>
   /// This a thread-safe implementation for use with OpenMP. See \ref Example_23_OpenMP_Parallel_Codes for an example.
+  ///
+  /// Adjoints selects how concurrent adjoint updates are handled. With OpenMPGlobalAdjoints, Gradient has to be an
+  /// atomic type. With OpenMPReplicatedGlobalAdjoints, Gradient has to be non-atomic and each thread works on its own
+  /// copy of the adjoints during the reverse sweep.
   template<typename Real, typename Gradient = OpenMPAtomic<Real>,
-           typename IndexManager = ParallelReuseIndexManager<int, OpenMPToolbox>>
+           typename IndexManager = ParallelReuseIndexManager<int, OpenMPToolbox>,
+           template<typename, typename, typename> class Adjoints = OpenMPGlobalAdjoints>
   using RealReverseIndexOpenMPGen = ParallelActiveType<
-      JacobianReuseTape<JacobianTapeTypes<Real, Gradient, IndexManager, DefaultChunkedData, OpenMPGlobalAdjoints>>,
-      OpenMPToolbox>;
+      JacobianReuseTape<JacobianTapeTypes<Real, Gradient, IndexManager, DefaultChunkedData, Adjoints>>, OpenMPToolbox>;
 
   /// \copydoc codi::RealReverseIndexOpenMPGen
   using RealReverseIndexOpenMP = RealReverseIndexOpenMPGen<double>;
@@ -74,4 +80,18 @@ namespace codi {
   /// \copydoc codi::RealReverseIndexOpenMPGen
   template<size_t dim>
   using RealReverseIndexVecOpenMP = RealReverseIndexOpenMPGen<double, Direction<OpenMPAtomic<double>, dim>>;
+
+  /// \copydoc codi::RealReverseIndexOpenMPGen <br><br>
+  /// Uses per-thread copies of the adjoints instead of atomic updates, see OpenMPReplicatedGlobalAdjoints.
+  template<typename Real, typename Gradient = Real,
+           typename IndexManager = ParallelReuseIndexManager<int, OpenMPToolbox>>
+  using RealReverseIndexOpenMPReplicatedGen =
+      RealReverseIndexOpenMPGen<Real, Gradient, IndexManager, OpenMPReplicatedGlobalAdjoints>;
+
+  /// \copydoc codi::RealReverseIndexOpenMPReplicatedGen
+  using RealReverseIndexOpenMPReplicated = RealReverseIndexOpenMPReplicatedGen<double>;
+
+  /// \copydoc codi::RealReverseIndexOpenMPReplicatedGen
+  template<size_t dim>
+  using RealReverseIndexVecOpenMPReplicated = RealReverseIndexOpenMPReplicatedGen<double, Direction<double, dim>>;
 }
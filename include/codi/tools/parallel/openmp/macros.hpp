@@ -42,7 +42,10 @@ namespace codi {
 #define CODI_PRAGMA(...) _Pragma(#__VA_ARGS__)
 #define CODI_OMP_ATOMIC(...) CODI_PRAGMA(omp atomic __VA_ARGS__)
 #define CODI_OMP_BARRIER(...) CODI_PRAGMA(omp barrier __VA_ARGS__)
+#define CODI_OMP_FOR(...) CODI_PRAGMA(omp for __VA_ARGS__)
 #define CODI_OMP_MASTER(...) CODI_PRAGMA(omp master __VA_ARGS__)
+#define CODI_OMP_PARALLEL(...) CODI_PRAGMA(omp parallel __VA_ARGS__)
+#define CODI_OMP_SINGLE(...) CODI_PRAGMA(omp single __VA_ARGS__)
 #define CODI_OMP_THREADPRIVATE(...) CODI_PRAGMA(omp threadprivate(__VA_ARGS__))
 
 }
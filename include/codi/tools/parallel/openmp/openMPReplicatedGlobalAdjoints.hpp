@@ -0,0 +1,276 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <omp.h>
+
+#include <vector>
+
+#include "../../../config.h"
+#include "../../../misc/macros.hpp"
+#include "../../../tapes/data/allocationPolicies.hpp"
+#include "../../../tapes/misc/internalAdjointsInterface.hpp"
+#include "../../../tapes/misc/tapeValues.hpp"
+#include "macros.hpp"
+#include "openMPAtomic.hpp"
+#include "openMPMutex.hpp"
+#include "openMPStaticThreadLocalPointer.hpp"
+#include "openMPSynchronization.hpp"
+#include "openMPThreadInformation.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+  /**
+   * @brief Global adjoint variables with one private copy per OpenMP thread for reverse sweeps without atomics.
+   *
+   * By default, this implementation behaves like ThreadSafeGlobalAdjoints. After startReplication() is called, each
+   * thread works on its own copy of the adjoint vector. The reverse evaluations of the threads can then use plain,
+   * non-atomic updates. This requires a non-atomic Gradient type, e.g., RealReverseIndexOpenMPReplicated.
+   *
+   * The copies have to be combined at each point where the threads synchronized in the primal code, e.g., at the
+   * reversal of a barrier, by calling reduceReplicas() from all threads of the team. stopReplication() performs a
+   * final reduction and returns to the shared adjoint vector.
+   *
+   * \code{.cpp}
+   *   Adjoints::startReplication();
+   *   #pragma omp parallel
+   *   {
+   *     // Evaluate the thread local tapes up to the reversal of a barrier.
+   *     Adjoints::reduceReplicas();
+   *     // ...
+   *   }
+   *   Adjoints::stopReplication();
+   * \endcode
+   *
+   * The reduction is dense. Its cost is the size of the adjoint vector times the number of threads. It pays off if
+   * the reverse sweeps between synchronization points are long compared to the adjoint vector.
+   *
+   * @tparam T_Gradient    The gradient type of a tape, usually chosen as ActiveType::Gradient.
+   * @tparam T_Identifier  The adjoint/tangent identification of a tape, usually chosen as ActiveType::Identifier.
+   * @tparam T_Tape        The associated tape type.
+   */
+  template<typename T_Gradient, typename T_Identifier, typename T_Tape>
+  struct OpenMPReplicatedGlobalAdjoints : public InternalAdjointsInterface<T_Gradient, T_Identifier, T_Tape> {
+    public:
+
+      /// See OpenMPReplicatedGlobalAdjoints.
+      using Tape = CODI_DD(T_Tape, CODI_T(FullTapeInterface<double, double, int, EmptyPosition>));
+      using Gradient = CODI_DD(T_Gradient, double);      ///< See OpenMPReplicatedGlobalAdjoints.
+      using Identifier = CODI_DD(T_Identifier, int);     ///< See OpenMPReplicatedGlobalAdjoints.
+      using AllocationPolicy = DefaultAllocationPolicy;  ///< Memory of the adjoint vectors.
+
+      /// Same toolbox as in codiOpenMP.hpp.
+      using ParallelToolbox = codi::ParallelToolbox<OpenMPThreadInformation, OpenMPAtomic, OpenMPMutex,
+                                                    OpenMPStaticThreadLocalPointer, OpenMPSynchronization>;
+
+      using ReadWriteMutex = typename ParallelToolbox::ReadWriteMutex;  ///< See ParallelToolbox.
+      using LockForUse = typename ParallelToolbox::LockForRead;         ///< See ParallelToolbox.
+      using LockForRealloc = typename ParallelToolbox::LockForWrite;    ///< See ParallelToolbox.
+
+    private:
+
+      using AdjointVector = std::vector<Gradient, PolicyAllocator<Gradient, AllocationPolicy>>;
+
+      static AdjointVector adjoints;               ///< Shared adjoint variables, value at the last reduction.
+      static std::vector<AdjointVector> replicas;  ///< One copy per thread while the replication is active.
+
+      /// @brief Protects adjoints and replicas.
+      /// Read lock locks for using the adjoint vectors. Write lock locks for reallocating them.
+      static ReadWriteMutex adjointsMutex;
+
+    public:
+
+      /// Constructor
+      OpenMPReplicatedGlobalAdjoints(size_t initialSize)
+          : InternalAdjointsInterface<Gradient, Identifier, Tape>(initialSize) {}
+
+      /// \copydoc InternalAdjointsInterface::operator[](Identifier const&) <br><br>
+      /// Implementation: No locking is performed, beginUse and endUse have to be used accordingly.
+      CODI_INLINE Gradient& operator[](Identifier const& identifier) {
+        return getVector()[(size_t)identifier];
+      }
+
+      /// \copydoc InternalAdjointsInterface::operator[](Identifier const&) const <br><br>
+      /// Implementation: No locking is performed, beginUse and endUse have to be used accordingly.
+      CODI_INLINE Gradient const& operator[](Identifier const& identifier) const {
+        return getVector()[(size_t)identifier];
+      }
+
+      /// \copydoc InternalAdjointsInterface::data <br><br>
+      /// Implementation: Returns the copy of the calling thread if the replication is active.
+      CODI_INLINE Gradient* data() {
+        LockForUse lock(adjointsMutex);
+        return getVector().data();
+      }
+
+      /// \copydoc InternalAdjointsInterface::size
+      CODI_INLINE size_t size() const {
+        LockForUse lock(adjointsMutex);
+        return adjoints.size();
+      }
+
+      /// \copydoc InternalAdjointsInterface::resize <br><br>
+      /// Implementation: Also resizes the copies of all threads.
+      CODI_NO_INLINE void resize(Identifier const& newSize) {
+        LockForRealloc lock(adjointsMutex);
+        adjoints.resize((size_t)newSize);
+        for (AdjointVector& replica : replicas) {
+          replica.resize((size_t)newSize);
+        }
+      }
+
+      /// \copydoc InternalAdjointsInterface::zeroAll <br><br>
+      /// Implementation: Also zeroes the copies of all threads.
+      CODI_INLINE void zeroAll() {
+        zeroVector(adjoints);
+        for (AdjointVector& replica : replicas) {
+          zeroVector(replica);
+        }
+      }
+
+      /// \copydoc InternalAdjointsInterface::swap
+      CODI_INLINE void swap(OpenMPReplicatedGlobalAdjoints&) {
+        /* Adjoints in this implementation are a static global member. Therefore, there is no need to swap them. */
+      }
+
+      /// \copydoc InternalAdjointsInterface::beginUse <br><br>
+      /// Implementation: Sets an internal lock.
+      CODI_INLINE void beginUse() {
+        adjointsMutex.lockRead();
+      }
+
+      /// \copydoc InternalAdjointsInterface::endUse <br><br>
+      /// Implementation: Unsets an internal lock.
+      CODI_INLINE void endUse() {
+        adjointsMutex.unlockRead();
+      }
+
+      /// \copydoc InternalAdjointsInterface::addToTapeValues
+      void addToTapeValues(TapeValues& values) const {
+        values.addStringEntry("Allocation policy", AllocationPolicy::getName());
+        values.addUnsignedLongEntry("Adjoint replicas", replicas.size());
+      }
+
+      /*******************************************************************************/
+      /// @name Replication
+
+      /// True if each thread works on its own copy of the adjoint vector.
+      static CODI_INLINE bool isReplicated() {
+        return !replicas.empty();
+      }
+
+      /// @brief Create a copy of the adjoint vector for each thread. Call outside of a parallel region.
+      ///
+      /// The adjoint vector has to be large enough for all identifiers that are used in the evaluations, see
+      /// DataManagementTapeInterface::resizeAdjointVector.
+      ///
+      /// @param numberOfThreads  Thread ids that will access the adjoints are in [0, numberOfThreads).
+      static void startReplication(int numberOfThreads = omp_get_max_threads()) {
+        LockForRealloc lock(adjointsMutex);
+        codiAssert(!isReplicated());
+        codiAssert(0 < numberOfThreads && numberOfThreads <= OpenMPThreadInformation::getMaxThreads());
+
+        replicas.assign((size_t)numberOfThreads, adjoints);
+      }
+
+      /// @brief Combine the updates of all threads. All copies and the shared vector have the same values afterwards.
+      ///
+      /// Inside of a parallel region, this has to be called by all threads of the team. The work is distributed over
+      /// the threads. Outside of a parallel region, the calling thread performs the whole reduction.
+      static void reduceReplicas() {
+        codiAssert(isReplicated());
+
+        CODI_OMP_BARRIER()  // All threads have finished their updates.
+
+        size_t const numberOfAdjoints = adjoints.size();
+        CODI_OMP_FOR(schedule(static))
+        for (size_t i = 0; i < numberOfAdjoints; i += 1) {
+          // Each copy started from the shared value, add the change of each copy.
+          Gradient const base = adjoints[i];
+          Gradient sum = base;
+          for (AdjointVector const& replica : replicas) {
+            sum += replica[i] - base;
+          }
+
+          adjoints[i] = sum;
+          for (AdjointVector& replica : replicas) {
+            replica[i] = sum;
+          }
+        }
+        // Implicit barrier of the worksharing loop.
+      }
+
+      /// Perform a final reduction and release the copies. Call outside of a parallel region.
+      static void stopReplication() {
+        reduceReplicas();
+
+        LockForRealloc lock(adjointsMutex);
+        replicas.clear();
+        replicas.shrink_to_fit();
+      }
+
+      /// @}
+
+    private:
+
+      static CODI_INLINE AdjointVector& getVector() {
+        if (CODI_Unlikely(isReplicated())) {
+          codiAssert((size_t)OpenMPThreadInformation::getThreadId() < replicas.size());
+          return replicas[OpenMPThreadInformation::getThreadId()];
+        } else {
+          return adjoints;
+        }
+      }
+
+      static CODI_INLINE void zeroVector(AdjointVector& vector) {
+        for (Gradient& gradient : vector) {
+          gradient = Gradient();
+        }
+      }
+  };
+
+  template<typename Gradient, typename Identifier, typename Tape>
+  typename OpenMPReplicatedGlobalAdjoints<Gradient, Identifier, Tape>::AdjointVector
+      OpenMPReplicatedGlobalAdjoints<Gradient, Identifier, Tape>::adjoints(1);
+
+  template<typename Gradient, typename Identifier, typename Tape>
+  std::vector<typename OpenMPReplicatedGlobalAdjoints<Gradient, Identifier, Tape>::AdjointVector>
+      OpenMPReplicatedGlobalAdjoints<Gradient, Identifier, Tape>::replicas;
+
+  template<typename Gradient, typename Identifier, typename Tape>
+  typename OpenMPReplicatedGlobalAdjoints<Gradient, Identifier, Tape>::ReadWriteMutex
+      OpenMPReplicatedGlobalAdjoints<Gradient, Identifier, Tape>::adjointsMutex;
+}
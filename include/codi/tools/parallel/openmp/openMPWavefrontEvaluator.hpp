@@ -0,0 +1,319 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <omp.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "../../../config.h"
+#include "../../../misc/exceptions.hpp"
+#include "../../../misc/macros.hpp"
+#include "../../../tapes/misc/tapeParameters.hpp"
+#include "macros.hpp"
+
+/** \copydoc codi::Namespace */
+namespace codi {
+
+  /**
+   * @brief Parallel reverse evaluation of a recorded JacobianLinearTape with OpenMP.
+   *
+   * analyze() reads the statements of the tape and builds, for each identifier, the list of the statements that use
+   * it as an argument. The statements are then sorted into levels. A statement is on level zero if no other statement
+   * uses its value, otherwise it is one level above the highest level of its users.
+   *
+   * evaluate() processes the levels in ascending order. Each statement gathers its adjoint from its users, which are
+   * all on lower levels:
+   * \f[ \bar w_i \mathrel{+}= \sum_{j \text{ uses } w_i} \frac{\partial \phi_j}{\partial w_i} \bar w_j . \f]
+   * Every thread only writes the adjoints of its own statements, so no atomic updates are required. Consecutive levels
+   * with fewer statements than minParallelWidth are evaluated by a single thread to avoid the synchronization.
+   *
+   * The result is the same as the one of a sequential reverse evaluation of the whole tape. Low level functions, e.g.
+   * external functions, cannot be analyzed. For tapes that contain them, evaluate() falls back to the sequential
+   * evaluation.
+   *
+   * The analysis is valid until the tape is modified.
+   *
+   * @tparam T_Tape  A JacobianLinearTape.
+   */
+  template<typename T_Tape>
+  struct OpenMPWavefrontEvaluator {
+    public:
+
+      using Tape = CODI_DD(T_Tape, CODI_DEFAULT_TAPE);  ///< See OpenMPWavefrontEvaluator.
+
+      using Real = typename Tape::Real;              ///< See TapeTypesInterface.
+      using Gradient = typename Tape::Gradient;      ///< See TapeTypesInterface.
+      using Identifier = typename Tape::Identifier;  ///< See TapeTypesInterface.
+      using Position = typename Tape::Position;      ///< See TapeTypesInterface.
+
+    private:
+
+      /// Range of the statement order that is evaluated in one step.
+      struct Phase {
+        public:
+          size_t begin;   ///< First entry in statementOrder.
+          size_t end;     ///< One past the last entry in statementOrder.
+          bool parallel;  ///< If the statements are distributed over the threads.
+      };
+
+      /// Collects the arguments of all statements.
+      struct StatementCollector {
+        public:
+          std::vector<size_t>& argumentStart;
+          std::vector<Identifier>& argumentIdentifiers;
+          std::vector<Real>& argumentJacobians;
+          std::vector<bool>& isInput;
+          bool& hasLowLevelFunctions;
+
+          template<typename JacobianPointer, typename RhsIdentifierPointer>
+          void operator()(Identifier const& lhsIdentifier, Config::ArgumentSize const& numberOfArguments,
+                          JacobianPointer const& jacobians, RhsIdentifierPointer const& rhsIdentifiers,
+                          size_t const& argumentPos) {
+            codiAssert((size_t)lhsIdentifier == argumentStart.size());
+            CODI_UNUSED(lhsIdentifier);
+
+            argumentStart.push_back(argumentIdentifiers.size());
+            isInput.push_back(Config::StatementInputTag == numberOfArguments);
+
+            if (Config::StatementLowLevelFunctionTag == numberOfArguments) {
+              hasLowLevelFunctions = true;
+            } else if (Config::StatementInputTag != numberOfArguments) {
+              for (size_t i = 0; i < numberOfArguments; i += 1) {
+                codiAssert(rhsIdentifiers[argumentPos + i] < lhsIdentifier);
+                argumentIdentifiers.push_back(rhsIdentifiers[argumentPos + i]);
+                argumentJacobians.push_back(jacobians[argumentPos + i]);
+              }
+            }
+          }
+      };
+
+      Tape& tape;
+      size_t minParallelWidth;
+
+      Position analyzedPosition;
+      bool hasLowLevelFunctions;
+      size_t numberOfStatements;
+      size_t numberOfLevels;
+
+      std::vector<bool> isInput;
+      std::vector<size_t> userStart;
+      std::vector<Identifier> userStatements;
+      std::vector<Real> userJacobians;
+
+      std::vector<Identifier> statementOrder;
+      std::vector<Phase> phases;
+
+    public:
+
+      /// Constructor
+      explicit OpenMPWavefrontEvaluator(Tape& tape, size_t minParallelWidth = 1024)
+          : tape(tape),
+            minParallelWidth(minParallelWidth),
+            analyzedPosition(),
+            hasLowLevelFunctions(false),
+            numberOfStatements(0),
+            numberOfLevels(0),
+            isInput(),
+            userStart(),
+            userStatements(),
+            userJacobians(),
+            statementOrder(),
+            phases() {}
+
+      /// Analyze the whole recording of the tape. Needs to be called again after the tape was modified.
+      void analyze() {
+        analyzedPosition = tape.getPosition();
+
+        std::vector<size_t> argumentStart(1, 0);  // Identifier zero is not a statement.
+        std::vector<Identifier> argumentIdentifiers;
+        std::vector<Real> argumentJacobians;
+        isInput.assign(1, false);
+        hasLowLevelFunctions = false;
+
+        StatementCollector collector = {argumentStart, argumentIdentifiers, argumentJacobians, isInput,
+                                        hasLowLevelFunctions};
+        tape.iterateStatements(tape.getZeroPosition(), analyzedPosition, collector);
+
+        numberOfStatements = argumentStart.size() - 1;
+        argumentStart.push_back(argumentIdentifiers.size());
+
+        buildUsers(argumentStart, argumentIdentifiers, argumentJacobians);
+        buildLevels();
+      }
+
+      /// Number of statements in the analyzed tape, including inputs.
+      size_t getNumberOfStatements() const {
+        return numberOfStatements;
+      }
+
+      /// Number of levels, which is the length of the longest dependency chain.
+      size_t getNumberOfLevels() const {
+        return numberOfLevels;
+      }
+
+      /// False if the tape contains low level functions. evaluate() is then sequential.
+      bool isParallelizable() const {
+        return !hasLowLevelFunctions;
+      }
+
+      /// Reverse evaluation with the adjoints of the tape.
+      void evaluate() {
+        if (!isParallelizable()) {
+          tape.evaluate(analyzedPosition, tape.getZeroPosition());
+          return;
+        }
+
+        tape.gradient((Identifier)numberOfStatements);  // Resize the adjoints.
+        evaluate(&tape.gradient(0, AdjointsManagement::Manual));
+      }
+
+      /// Reverse evaluation with a custom adjoint vector, see CustomAdjointVectorEvaluationTapeInterface.
+      template<typename Adjoint>
+      void evaluate(Adjoint* adjoints) {
+        codiAssert(tape.getPosition() == analyzedPosition);
+
+        if (!isParallelizable()) {
+          tape.evaluate(analyzedPosition, tape.getZeroPosition(), adjoints);
+          return;
+        }
+
+        CODI_OMP_PARALLEL() {
+          for (Phase const& phase : phases) {
+            if (phase.parallel) {
+              CODI_OMP_FOR(schedule(static))
+              for (size_t pos = phase.begin; pos < phase.end; pos += 1) {
+                gatherAdjoint(adjoints, statementOrder[pos]);
+              }
+            } else {
+              CODI_OMP_SINGLE()
+              for (size_t pos = phase.begin; pos < phase.end; pos += 1) {
+                gatherAdjoint(adjoints, statementOrder[pos]);
+              }
+            }
+          }
+
+          if (Config::ReversalZeroesAdjoints) {
+            CODI_OMP_FOR(schedule(static))
+            for (size_t identifier = 1; identifier <= numberOfStatements; identifier += 1) {
+              if (!isInput[identifier]) {
+                adjoints[identifier] = Adjoint();
+              }
+            }
+          }
+        }
+      }
+
+    private:
+
+      template<typename Adjoint>
+      CODI_INLINE void gatherAdjoint(Adjoint* adjoints, Identifier const& identifier) {
+        Adjoint adjoint = adjoints[identifier];
+        for (size_t pos = userStart[identifier]; pos < userStart[identifier + 1]; pos += 1) {
+          adjoint += userJacobians[pos] * adjoints[userStatements[pos]];
+        }
+        adjoints[identifier] = adjoint;
+      }
+
+      void buildUsers(std::vector<size_t> const& argumentStart, std::vector<Identifier> const& argumentIdentifiers,
+                      std::vector<Real> const& argumentJacobians) {
+        // Count the users of each identifier and compute the offsets.
+        userStart.assign(numberOfStatements + 2, 0);
+        for (Identifier const& argument : argumentIdentifiers) {
+          userStart[argument + 1] += 1;
+        }
+        for (size_t identifier = 1; identifier < userStart.size(); identifier += 1) {
+          userStart[identifier] += userStart[identifier - 1];
+        }
+
+        // Transpose the arguments.
+        std::vector<size_t> fillPos(userStart.begin(), userStart.end() - 1);
+        userStatements.resize(argumentIdentifiers.size());
+        userJacobians.resize(argumentIdentifiers.size());
+        for (size_t statement = 1; statement <= numberOfStatements; statement += 1) {
+          for (size_t pos = argumentStart[statement]; pos < argumentStart[statement + 1]; pos += 1) {
+            size_t& userPos = fillPos[argumentIdentifiers[pos]];
+            userStatements[userPos] = (Identifier)statement;
+            userJacobians[userPos] = argumentJacobians[pos];
+            userPos += 1;
+          }
+        }
+      }
+
+      void buildLevels() {
+        // Users are recorded after their arguments, therefore a backward pass computes all levels.
+        std::vector<size_t> level(numberOfStatements + 1, 0);
+        numberOfLevels = 0 == numberOfStatements ? 0 : 1;
+        for (size_t identifier = numberOfStatements; identifier > 0; identifier -= 1) {
+          size_t curLevel = 0;
+          for (size_t pos = userStart[identifier]; pos < userStart[identifier + 1]; pos += 1) {
+            curLevel = std::max(curLevel, level[userStatements[pos]] + 1);
+          }
+          level[identifier] = curLevel;
+          numberOfLevels = std::max(numberOfLevels, curLevel + 1);
+        }
+
+        // Sort the statements by level. Statements on level zero have no users and need no evaluation.
+        std::vector<size_t> levelStart(numberOfLevels + 1, 0);
+        for (size_t identifier = 1; identifier <= numberOfStatements; identifier += 1) {
+          levelStart[level[identifier] + 1] += 1;
+        }
+        for (size_t curLevel = 1; curLevel <= numberOfLevels; curLevel += 1) {
+          levelStart[curLevel] += levelStart[curLevel - 1];
+        }
+
+        std::vector<size_t> fillPos(levelStart.begin(), levelStart.end() - 1);
+        statementOrder.resize(numberOfStatements);
+        for (size_t identifier = 1; identifier <= numberOfStatements; identifier += 1) {
+          statementOrder[fillPos[level[identifier]]++] = (Identifier)identifier;
+        }
+
+        // Narrow consecutive levels are merged into one sequential phase.
+        phases.clear();
+        for (size_t curLevel = 1; curLevel < numberOfLevels; curLevel += 1) {
+          size_t const begin = levelStart[curLevel];
+          size_t const end = levelStart[curLevel + 1];
+          bool const parallel = end - begin >= minParallelWidth;
+
+          if (!parallel && !phases.empty() && !phases.back().parallel) {
+            phases.back().end = end;
+          } else {
+            phases.push_back(Phase{begin, end, parallel});
+          }
+        }
+      }
+  };
+}
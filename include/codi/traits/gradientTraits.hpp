@@ -44,7 +44,7 @@
 /** \copydoc codi::Namespace */
 namespace codi {
 
-  template<typename Real, size_t dim>
+  template<typename Real, size_t dim, size_t alignment = alignof(Real)>
   struct Direction;
 
   /// Traits for everything that can be an used as a gradient (adjoint, tangent) usually the second template argument
@@ -129,7 +129,8 @@ namespace codi {
 #ifndef DOXYGEN_DISABLE
     template<typename Gradient>
     struct IsDirection<Gradient,
-                       typename enable_if_same<Gradient, Direction<typename Gradient::Real, Gradient::dim> >::type>
+                       typename enable_if_same<
+                           Gradient, Direction<typename Gradient::Real, Gradient::dim, Gradient::alignment> >::type>
         : std::true_type {};
 #endif
 
@@ -143,6 +144,70 @@ namespace codi {
     template<typename Gradient>
     using EnableIfDirection = typename std::enable_if<IsDirection<Gradient>::value>::type;
 
+    /// @}
+    /*******************************************************************************/
+    /// @name Explicit vectorization of gradient operations
+    /// @{
+
+    /// Instruction sets for the explicit vectorization of the operations on Direction.
+    enum class SimdInstructionSet {
+      None,   ///< No vector instructions, operations are implemented with loops.
+      SSE2,   ///< 128 bit registers.
+      AVX2,   ///< 256 bit registers.
+      AVX512  ///< 512 bit registers.
+    };
+
+    /// Widest instruction set that is enabled by the compiler flags, e.g. -march=native.
+    SimdInstructionSet constexpr NativeSimdInstructionSet =
+#if defined(__AVX512F__)
+        SimdInstructionSet::AVX512;
+#elif defined(__AVX2__)
+        SimdInstructionSet::AVX2;
+#elif defined(__SSE2__) || defined(_M_X64)
+        SimdInstructionSet::SSE2;
+#else
+        SimdInstructionSet::None;
+#endif
+
+    /// Size of the vector registers of an instruction set in bytes.
+    CODI_INLINE size_t constexpr simdRegisterSize(SimdInstructionSet set) {
+      return SimdInstructionSet::AVX512 == set ? 64
+             : SimdInstructionSet::AVX2 == set ? 32
+             : SimdInstructionSet::SSE2 == set ? 16
+                                               : 0;
+    }
+
+    /**
+     * @brief Alignment of a Direction with dim entries such that all entries can be processed with full vector
+     * registers.
+     *
+     * The largest register size of the native instruction set that divides the size of the entries is used. Only
+     * floating point entries are vectorized, for all other types the alignment of the type is used.
+     *
+     * @tparam T_Real  Type of the entries.
+     * @tparam T_dim   Number of entries.
+     */
+    template<typename T_Real, size_t T_dim>
+    struct SimdAlignment {
+      private:
+
+        using Real = CODI_DD(T_Real, double);
+        static size_t constexpr dim = T_dim;
+
+        static size_t constexpr select(size_t registerSize) {
+          return registerSize <= alignof(Real) ? alignof(Real)
+                 : 0 == (dim * sizeof(Real)) % registerSize ? registerSize
+                                                            : select(registerSize / 2);
+        }
+
+      public:
+
+        /// Alignment in bytes.
+        static size_t constexpr value = std::is_floating_point<Real>::value
+                                            ? select(simdRegisterSize(NativeSimdInstructionSet))
+                                            : alignof(Real);
+    };
+
     /// @}
   }
 }
@@ -0,0 +1,298 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Representative kernels for the benchmark suite.
+ *
+ * Each kernel defines:
+ *  - getName(): Name used in the output.
+ *  - getInputSize() / getOutputSize(): Number of inputs and outputs.
+ *  - initInputs(x): Deterministic initialization of the input values.
+ *  - evaluate(x, y): The kernel itself, templated on the number type.
+ *
+ * The size of all kernels is scaled with the scale argument of the constructor. A scale of 1 results in roughly one
+ * million statements per kernel.
+ */
+
+/// Number of entries for a scaled size. Always at least minSize.
+inline size_t scaleSize(double scale, double baseSize, size_t minSize) {
+  return std::max(minSize, (size_t)(scale * baseSize));
+}
+
+/// Five point Jacobi stencil on a square grid. Boundary values are kept constant.
+struct StencilKernel {
+  public:
+
+    size_t n;
+    size_t iterations;
+
+    StencilKernel(double scale) : n(scaleSize(std::sqrt(scale), 320.0, 4)), iterations(10) {}
+
+    static char const* getName() {
+      return "stencil";
+    }
+
+    size_t getInputSize() const {
+      return n * n;
+    }
+
+    size_t getOutputSize() const {
+      return n * n;
+    }
+
+    template<typename Number>
+    void initInputs(std::vector<Number>& x) const {
+      for (size_t i = 0; i < x.size(); i += 1) {
+        x[i] = 1.0 + 0.1 * std::sin(0.01 * (double)i);
+      }
+    }
+
+    template<typename Number>
+    void evaluate(std::vector<Number> const& x, std::vector<Number>& y) const {
+      double const alpha = 0.2;
+
+      std::vector<Number> cur(x);
+      std::vector<Number> next(x);
+
+      for (size_t iter = 0; iter < iterations; iter += 1) {
+        for (size_t i = 1; i < n - 1; i += 1) {
+          for (size_t j = 1; j < n - 1; j += 1) {
+            size_t c = i * n + j;
+            next[c] = cur[c] + alpha * (cur[c - n] + cur[c + n] + cur[c - 1] + cur[c + 1] - 4.0 * cur[c]);
+          }
+        }
+        std::swap(cur, next);
+      }
+
+      for (size_t i = 0; i < y.size(); i += 1) {
+        y[i] = cur[i];
+      }
+    }
+};
+
+/// Dense matrix vector product y = A * x. Matrix and vector are inputs.
+struct MatVecKernel {
+  public:
+
+    size_t n;
+
+    MatVecKernel(double scale) : n(scaleSize(std::sqrt(scale), 700.0, 2)) {}
+
+    static char const* getName() {
+      return "matvec";
+    }
+
+    size_t getInputSize() const {
+      return n * n + n;
+    }
+
+    size_t getOutputSize() const {
+      return n;
+    }
+
+    template<typename Number>
+    void initInputs(std::vector<Number>& x) const {
+      for (size_t i = 0; i < x.size(); i += 1) {
+        x[i] = std::cos(0.001 * (double)i);
+      }
+    }
+
+    template<typename Number>
+    void evaluate(std::vector<Number> const& x, std::vector<Number>& y) const {
+      Number const* a = &x[0];
+      Number const* v = &x[n * n];
+
+      for (size_t i = 0; i < n; i += 1) {
+        Number sum = 0.0;
+        for (size_t j = 0; j < n; j += 1) {
+          sum += a[i * n + j] * v[j];
+        }
+        y[i] = sum;
+      }
+    }
+};
+
+/// Long chain of dependent scalar statements with one input and one output.
+struct ScalarChainKernel {
+  public:
+
+    size_t length;
+
+    ScalarChainKernel(double scale) : length(scaleSize(scale, 1000000.0, 1)) {}
+
+    static char const* getName() {
+      return "scalar_chain";
+    }
+
+    size_t getInputSize() const {
+      return 1;
+    }
+
+    size_t getOutputSize() const {
+      return 1;
+    }
+
+    template<typename Number>
+    void initInputs(std::vector<Number>& x) const {
+      x[0] = 0.5;
+    }
+
+    template<typename Number>
+    void evaluate(std::vector<Number> const& x, std::vector<Number>& y) const {
+      using std::cos;
+      using std::sin;
+
+      Number w = x[0];
+      for (size_t i = 0; i < length; i += 1) {
+        w = 0.5 * sin(w) + 0.5 * cos(w) * w;
+      }
+
+      y[0] = w;
+    }
+};
+
+/// Reduction of many inputs into one output.
+struct ReductionKernel {
+  public:
+
+    size_t n;
+
+    ReductionKernel(double scale) : n(scaleSize(scale, 1000000.0, 1)) {}
+
+    static char const* getName() {
+      return "reduction";
+    }
+
+    size_t getInputSize() const {
+      return n;
+    }
+
+    size_t getOutputSize() const {
+      return 1;
+    }
+
+    template<typename Number>
+    void initInputs(std::vector<Number>& x) const {
+      for (size_t i = 0; i < x.size(); i += 1) {
+        x[i] = 1.0 / (1.0 + (double)i);
+      }
+    }
+
+    template<typename Number>
+    void evaluate(std::vector<Number> const& x, std::vector<Number>& y) const {
+      Number sum = 0.0;
+      for (size_t i = 0; i < n; i += 1) {
+        sum += x[i] * x[i];
+      }
+
+      y[0] = sum;
+    }
+};
+
+/// One dimensional Euler flux residual with a Rusanov flux. Resembles the inner loop of a finite volume CFD code.
+struct FluxKernel {
+  public:
+
+    size_t cells;
+
+    FluxKernel(double scale) : cells(scaleSize(scale, 30000.0, 2)) {}
+
+    static char const* getName() {
+      return "flux";
+    }
+
+    size_t getInputSize() const {
+      return 3 * cells;
+    }
+
+    size_t getOutputSize() const {
+      return 3 * cells;
+    }
+
+    template<typename Number>
+    void initInputs(std::vector<Number>& x) const {
+      for (size_t i = 0; i < cells; i += 1) {
+        x[3 * i + 0] = 1.0 + 0.1 * std::sin(0.01 * (double)i);  // density
+        x[3 * i + 1] = 0.5 + 0.1 * std::cos(0.01 * (double)i);  // velocity
+        x[3 * i + 2] = 1.0 + 0.05 * std::sin(0.02 * (double)i);  // pressure
+      }
+    }
+
+    template<typename Number>
+    void evaluate(std::vector<Number> const& x, std::vector<Number>& y) const {
+      using std::abs;
+      using std::sqrt;
+
+      double const gamma = 1.4;
+
+      for (size_t i = 0; i < y.size(); i += 1) {
+        y[i] = 0.0;
+      }
+
+      for (size_t i = 0; i + 1 < cells; i += 1) {
+        Number const& rhoL = x[3 * i + 0];
+        Number const& uL = x[3 * i + 1];
+        Number const& pL = x[3 * i + 2];
+        Number const& rhoR = x[3 * i + 3];
+        Number const& uR = x[3 * i + 4];
+        Number const& pR = x[3 * i + 5];
+
+        Number eL = pL / (gamma - 1.0) + 0.5 * rhoL * uL * uL;
+        Number eR = pR / (gamma - 1.0) + 0.5 * rhoR * uR * uR;
+        Number cL = sqrt(gamma * pL / rhoL);
+        Number cR = sqrt(gamma * pR / rhoR);
+        Number aL = abs(uL) + cL;
+        Number aR = abs(uR) + cR;
+        Number sMax = std::max(aL, aR);
+
+        Number f0 = 0.5 * (rhoL * uL + rhoR * uR) - 0.5 * sMax * (rhoR - rhoL);
+        Number f1 = 0.5 * (rhoL * uL * uL + pL + rhoR * uR * uR + pR) - 0.5 * sMax * (rhoR * uR - rhoL * uL);
+        Number f2 = 0.5 * (uL * (eL + pL) + uR * (eR + pR)) - 0.5 * sMax * (eR - eL);
+
+        y[3 * i + 0] -= f0;
+        y[3 * i + 1] -= f1;
+        y[3 * i + 2] -= f2;
+        y[3 * i + 3] += f0;
+        y[3 * i + 4] += f1;
+        y[3 * i + 5] += f2;
+      }
+    }
+};
@@ -0,0 +1,325 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <codi.hpp>
+
+/// Settings for all benchmarks, parsed from the command line.
+struct BenchmarkSettings {
+  public:
+
+    double scale;
+    size_t repetitions;
+    std::string output;
+    std::vector<std::string> kernels;
+    bool resetHard;
+
+    BenchmarkSettings() : scale(1.0), repetitions(3), output(), kernels(), resetHard(false) {}
+
+    bool parse(int nargs, char** args) {
+      bool allOk = true;
+
+      std::string const SCALE_OPTION("-s");
+      std::string const REPETITIONS_OPTION("-r");
+      std::string const OUTPUT_OPTION("-o");
+      std::string const KERNEL_OPTION("-k");
+      std::string const RESET_OPTION("-m");
+
+      for (int curArg = 1; curArg < nargs && allOk; curArg += 1) {
+        std::string option(args[curArg]);
+
+        if (curArg + 1 >= nargs) {
+          std::cerr << "Error: Missing value for option " << option << "." << std::endl;
+          allOk = false;
+          break;
+        }
+        curArg += 1;
+
+        if (SCALE_OPTION == option) {
+          scale = std::atof(args[curArg]);
+        } else if (REPETITIONS_OPTION == option) {
+          repetitions = std::max(1, std::atoi(args[curArg]));
+        } else if (OUTPUT_OPTION == option) {
+          output = args[curArg];
+        } else if (KERNEL_OPTION == option) {
+          kernels.push_back(args[curArg]);
+        } else if (RESET_OPTION == option) {
+          std::string mode(args[curArg]);
+          if ("hard" == mode || "soft" == mode) {
+            resetHard = "hard" == mode;
+          } else {
+            std::cerr << "Error: Unknown reset mode: " << mode << std::endl;
+            allOk = false;
+          }
+        } else {
+          std::cerr << "Error: Unknown argument: " << option << std::endl;
+          allOk = false;
+        }
+      }
+
+      if (!allOk) {
+        std::cerr << "Usage: " << args[0]
+                  << " [-s <scale>] [-r <repetitions>] [-o <file>] [-m <soft|hard>] [-k <kernel>]..." << std::endl;
+      }
+
+      return allOk;
+    }
+
+    bool isKernelSelected(std::string const& name) const {
+      return kernels.empty() || kernels.end() != std::find(kernels.begin(), kernels.end(), name);
+    }
+};
+
+/// Measurements of one kernel on one tape. Times are in seconds, the minimum over all repetitions is taken.
+struct BenchmarkResult {
+  public:
+
+    std::string kernel;
+    size_t inputs;
+    size_t outputs;
+    size_t statements;
+    double memoryUsed;
+    double memoryAllocated;
+    double recordTime;
+    double reverseTime;
+    double forwardTime;
+    double primalTime;  ///< Negative if the tape has no primal evaluation.
+    double reverseChecksum;
+    double forwardChecksum;
+
+    BenchmarkResult()
+        : kernel(),
+          inputs(),
+          outputs(),
+          statements(),
+          memoryUsed(),
+          memoryAllocated(),
+          recordTime(),
+          reverseTime(),
+          forwardTime(),
+          primalTime(-1.0),
+          reverseChecksum(),
+          forwardChecksum() {}
+
+    template<typename Stream>
+    void writeJson(Stream& out, std::string const& indent) const {
+      out << indent << "{\n";
+      writeEntry(out, indent, "kernel", "\"" + kernel + "\"");
+      writeEntry(out, indent, "inputs", inputs);
+      writeEntry(out, indent, "outputs", outputs);
+      writeEntry(out, indent, "statements", statements);
+      writeEntry(out, indent, "bytes_per_statement", memoryUsed / std::max((double)statements, 1.0));
+      writeEntry(out, indent, "memory_used", memoryUsed);
+      writeEntry(out, indent, "memory_allocated", memoryAllocated);
+      writeEntry(out, indent, "record_time", recordTime);
+      writeEntry(out, indent, "record_statements_per_second", perSecond(recordTime));
+      writeEntry(out, indent, "reverse_time", reverseTime);
+      writeEntry(out, indent, "reverse_statements_per_second", perSecond(reverseTime));
+      writeEntry(out, indent, "forward_time", forwardTime);
+      writeEntry(out, indent, "forward_statements_per_second", perSecond(forwardTime));
+      if (0.0 <= primalTime) {
+        writeEntry(out, indent, "primal_time", primalTime);
+        writeEntry(out, indent, "primal_statements_per_second", perSecond(primalTime));
+      } else {
+        writeEntry(out, indent, "primal_time", "null");
+        writeEntry(out, indent, "primal_statements_per_second", "null");
+      }
+      writeEntry(out, indent, "reverse_checksum", reverseChecksum);
+      writeEntry(out, indent, "forward_checksum", forwardChecksum, true);
+      out << indent << "}";
+    }
+
+  private:
+
+    double perSecond(double time) const {
+      return (double)statements / std::max(time, std::numeric_limits<double>::min());
+    }
+
+    template<typename Stream, typename T>
+    static void writeEntry(Stream& out, std::string const& indent, char const* name, T const& value,
+                           bool last = false) {
+      out << indent << "  \"" << name << "\": " << value << (last ? "\n" : ",\n");
+    }
+};
+
+/**
+ * Records and evaluates the benchmark kernels with one CoDiPack type.
+ *
+ * For each kernel the recording, the reverse sweep, the forward sweep and (if available) the primal sweep are timed.
+ * All timings are the minimum over the number of repetitions.
+ */
+template<typename T_Type>
+struct TapeBenchmark {
+  public:
+
+    using Type = T_Type;
+    using Tape = typename Type::Tape;
+    using Gradient = typename Type::Gradient;
+    using Clock = std::chrono::steady_clock;
+
+    BenchmarkSettings const& settings;
+    std::vector<BenchmarkResult> results;
+
+    TapeBenchmark(BenchmarkSettings const& settings) : settings(settings), results() {}
+
+    template<typename Kernel>
+    void run() {
+      if (!settings.isKernelSelected(Kernel::getName())) {
+        return;
+      }
+
+      Kernel kernel(settings.scale);
+      Tape& tape = Type::getTape();
+
+      BenchmarkResult result;
+      result.kernel = Kernel::getName();
+      result.inputs = kernel.getInputSize();
+      result.outputs = kernel.getOutputSize();
+      result.recordTime = std::numeric_limits<double>::max();
+      result.reverseTime = std::numeric_limits<double>::max();
+      result.forwardTime = std::numeric_limits<double>::max();
+
+      std::vector<Type> x(kernel.getInputSize());
+      std::vector<Type> y(kernel.getOutputSize());
+
+      for (size_t rep = 0; rep < settings.repetitions; rep += 1) {
+        // A hard reset frees the tape memory, the next recording has to allocate it again.
+        if (settings.resetHard) {
+          tape.resetHard();
+        } else {
+          tape.reset();
+        }
+        kernel.initInputs(x);
+
+        Clock::time_point start = Clock::now();
+
+        tape.setActive();
+        for (Type& value : x) {
+          tape.registerInput(value);
+        }
+        kernel.evaluate(x, y);
+        for (Type& value : y) {
+          tape.registerOutput(value);
+        }
+        tape.setPassive();
+
+        result.recordTime = std::min(result.recordTime, elapsed(start));
+      }
+
+      codi::TapeValues values = tape.getTapeValues();
+      result.statements = tape.getParameter(codi::TapeParameters::StatementSize);
+      result.memoryUsed = values.getUsedMemorySize();
+      result.memoryAllocated = values.getAllocatedMemorySize();
+
+      for (size_t rep = 0; rep < settings.repetitions; rep += 1) {
+        tape.clearAdjoints();
+        for (Type& value : y) {
+          value.gradient() = Gradient(1.0);
+        }
+
+        Clock::time_point start = Clock::now();
+        tape.evaluate();
+        result.reverseTime = std::min(result.reverseTime, elapsed(start));
+      }
+      result.reverseChecksum = checksum(x);
+
+      for (size_t rep = 0; rep < settings.repetitions; rep += 1) {
+        tape.clearAdjoints();
+        for (Type& value : x) {
+          value.gradient() = Gradient(1.0);
+        }
+
+        Clock::time_point start = Clock::now();
+        tape.evaluateForward();
+        result.forwardTime = std::min(result.forwardTime, elapsed(start));
+      }
+      result.forwardChecksum = checksum(y);
+
+      if (Tape::HasPrimalValues) {
+        result.primalTime = std::numeric_limits<double>::max();
+        for (size_t rep = 0; rep < settings.repetitions; rep += 1) {
+          Clock::time_point start = Clock::now();
+          tape.evaluatePrimal();
+          result.primalTime = std::min(result.primalTime, elapsed(start));
+        }
+      }
+
+      tape.clearAdjoints();
+      tape.reset();
+
+      results.push_back(result);
+    }
+
+    template<typename Stream>
+    void writeJson(Stream& out, std::string const& typeName) const {
+      out << "{\n";
+      out << "  \"type\": \"" << typeName << "\",\n";
+      out << "  \"scale\": " << settings.scale << ",\n";
+      out << "  \"repetitions\": " << settings.repetitions << ",\n";
+      out << "  \"reset\": \"" << (settings.resetHard ? "hard" : "soft") << "\",\n";
+      out << "  \"results\": [\n";
+      for (size_t i = 0; i < results.size(); i += 1) {
+        results[i].writeJson(out, "    ");
+        out << (i + 1 < results.size() ? ",\n" : "\n");
+      }
+      out << "  ]\n";
+      out << "}\n";
+    }
+
+  private:
+
+    static double elapsed(Clock::time_point const& start) {
+      return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    static double checksum(std::vector<Type>& values) {
+      double sum = 0.0;
+      for (Type& value : values) {
+        for (auto const& entry : codi::GradientTraits::toArray(value.getGradient())) {
+          sum += codi::RealTraits::getPassiveValue(entry);
+        }
+      }
+
+      return sum;
+    }
+};
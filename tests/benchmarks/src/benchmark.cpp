@@ -0,0 +1,75 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+
+#include <codi.hpp>
+#include <fstream>
+#include <iostream>
+
+#include "../include/kernels.hpp"
+#include "../include/tapeBenchmark.hpp"
+
+#ifndef CODI_TYPE
+  #error Please define CODI_TYPE, e.g. -DCODI_TYPE=codi::RealReverse.
+#endif
+#ifndef CODI_TYPE_NAME
+  #error Please define CODI_TYPE_NAME, e.g. -DCODI_TYPE_NAME=RealReverse.
+#endif
+
+#define STRINGIFY_INNER(x) #x
+#define STRINGIFY(x) STRINGIFY_INNER(x)
+
+int main(int nargs, char** args) {
+  BenchmarkSettings settings;
+  if (!settings.parse(nargs, args)) {
+    return -1;
+  }
+
+  TapeBenchmark<CODI_TYPE> benchmark(settings);
+
+  benchmark.run<StencilKernel>();
+  benchmark.run<MatVecKernel>();
+  benchmark.run<ScalarChainKernel>();
+  benchmark.run<ReductionKernel>();
+  benchmark.run<FluxKernel>();
+
+  if (settings.output.empty()) {
+    benchmark.writeJson(std::cout, STRINGIFY(CODI_TYPE_NAME));
+  } else {
+    std::ofstream out(settings.output);
+    benchmark.writeJson(out, STRINGIFY(CODI_TYPE_NAME));
+  }
+
+  return 0;
+}
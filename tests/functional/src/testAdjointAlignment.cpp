@@ -0,0 +1,98 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#include <codi.hpp>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+
+using Gradient = codi::Direction<double, 4, 64>;
+using Tape = typename codi::RealReverseVec<4>::Tape;
+
+template<typename T>
+bool isAligned(T const* pointer) {
+  return 0 == reinterpret_cast<std::uintptr_t>(pointer) % alignof(T);
+}
+
+template<typename Adjoints>
+void testAdjoints(std::ofstream& out, std::string const& name) {
+  bool aligned = true;
+
+  Adjoints adjoints(1);
+  for (int size = 1; size < 5000; size = size * 3 + 1) {
+    adjoints.resize(size);
+    aligned &= isAligned(adjoints.data());
+
+    Adjoints other(size);
+    aligned &= isAligned(other.data());
+  }
+
+  out << name << ": " << (aligned ? "aligned" : "misaligned") << std::endl;
+}
+
+template<typename Policy>
+void testChunks(std::ofstream& out, std::string const& name) {
+  bool aligned = true;
+
+  for (size_t size = 1; size < 5000; size = size * 3 + 1) {
+    codi::Chunk2<Gradient, char> chunk(size, Policy::getMemoryResource());
+    Gradient* gradients;
+    char* chars;
+    chunk.dataPointer(0, gradients, chars);
+    aligned &= isAligned(gradients);
+
+    codi::Chunk1<double> doubleChunk(size, Policy::getMemoryResource());  // Reuses arrays in the pool.
+    codi::Chunk1<Gradient> gradientChunk(size, Policy::getMemoryResource());
+    gradientChunk.dataPointer(0, gradients);
+    aligned &= isAligned(gradients);
+  }
+
+  out << name << ": " << (aligned ? "aligned" : "misaligned") << std::endl;
+}
+
+int main(int nargs, char** args) {
+  std::ofstream out("run.out");
+
+  testAdjoints<codi::LocalAdjoints<Gradient, int, Tape>>(out, "Local adjoints");
+  testAdjoints<codi::LocalAdjointsWithPolicy<Gradient, int, Tape, codi::StaticChunkPool<>>>(
+      out, "Local adjoints with chunk pool");
+  testAdjoints<codi::HugePageLocalAdjoints<Gradient, int, Tape>>(out, "Huge page local adjoints");
+  testAdjoints<codi::InterleavedLocalAdjoints<Gradient, int, Tape>>(out, "Interleaved local adjoints");
+
+  testChunks<codi::DefaultAllocationPolicy>(out, "Chunks");
+  testChunks<codi::StaticChunkPool<>>(out, "Chunks with chunk pool");
+  testChunks<codi::TransparentHugePagePolicy>(out, "Chunks with huge pages");
+
+  return 0;
+}
@@ -0,0 +1,98 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#include <codi.hpp>
+#include <fstream>
+#include <iostream>
+
+using Data = codi::CompressedChunkedData<codi::Chunk2<int, double>>;
+
+int const Items = 1000;
+
+template<typename Check>
+bool checkAll(Data& data, Check check) {
+  bool valid = true;
+  int pos = 0;
+  auto func = [&](int* identifier, double* value) {
+    valid &= check(pos, *identifier, *value);
+    pos += 1;
+  };
+  data.forEachForward(data.getZeroPosition(), data.getPosition(), func);
+
+  return valid && Items == pos;
+}
+
+int main(int nargs, char** args) {
+  std::ofstream out("run.out");
+
+  codi::EmptyData empty;
+  Data data(64, &empty);  // Full chunks are compressed.
+  for (int i = 0; i < Items; i += 1) {
+    data.reserveItems(1);
+    data.pushData(3 * i, 0.5 * i);
+  }
+
+  bool recorded = checkAll(data, [](int i, int identifier, double value) {
+    return 3 * i == identifier && 0.5 * i == value;
+  });
+  out << "Recorded data: " << (recorded ? "valid" : "invalid") << std::endl;
+
+  // Modifies the integral arrays, which are bit packed, and the copied double arrays.
+  auto modify = [](size_t& curPos, size_t const& endPos, int* identifiers, double* values) {
+    for (; curPos < endPos; curPos += 1) {
+      identifiers[curPos] += 1000;
+      values[curPos] += 1.0;
+    }
+  };
+  data.evaluateForward(data.getZeroPosition(), data.getPosition(), modify);
+
+  bool modified = checkAll(data, [](int i, int identifier, double value) {
+    return 3 * i + 1000 == identifier && 0.5 * i + 1.0 == value;
+  });
+  out << "Modified data: " << (modified ? "valid" : "invalid") << std::endl;
+
+  // Reverse evaluations only read the data.
+  auto read = [](size_t& curPos, size_t const& endPos, int* identifiers, double* values) {
+    codi::CODI_UNUSED(identifiers, values);
+    curPos = endPos;
+  };
+  data.evaluateReverse(data.getPosition(), data.getZeroPosition(), read);
+
+  bool unchanged = checkAll(data, [](int i, int identifier, double value) {
+    return 3 * i + 1000 == identifier && 0.5 * i + 1.0 == value;
+  });
+  out << "Data after reverse evaluation: " << (unchanged ? "valid" : "invalid") << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,208 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#define CODI_EnableOpenMP true
+
+#include <codi.hpp>
+#include <omp.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using Real = codi::RealReverseIndexOpenMP;
+using Tape = typename Real::Tape;
+using IndexManager = typename Tape::IndexManager;
+using Pool = codi::LockFreeIndexBatchPool<int>;
+
+int const Threads = 4;
+
+/// Read an unsigned long entry from the human readable output of the tape values.
+unsigned long getEntry(codi::TapeValues const& values, std::string const& name) {
+  std::stringstream ss;
+  values.formatDefault(ss);
+
+  std::string line;
+  while (std::getline(ss, line)) {
+    size_t namePos = line.find(name);
+    size_t separatorPos = line.find(" : ");
+    if (std::string::npos != namePos && namePos < separatorPos) {
+      return std::stoul(line.substr(separatorPos + 3));
+    }
+  }
+
+  return 0;
+}
+
+/// True if the indices contain no duplicates and no inactive index.
+bool isUnique(std::vector<int> indices) {
+  std::sort(indices.begin(), indices.end());
+
+  return (indices.empty() || 0 != indices[0]) && indices.end() == std::adjacent_find(indices.begin(), indices.end());
+}
+
+/// All threads push and pop batches concurrently. Every pushed index has to be taken exactly once.
+void testPool(std::ofstream& out) {
+  int const batches = 2000;
+  int const batchSize = 64;
+
+  Pool pool;
+  std::vector<std::vector<int>> taken(Threads);
+
+#pragma omp parallel num_threads(Threads)
+  {
+    int const thread = omp_get_thread_num();
+    std::vector<int> batch(batchSize);
+    std::vector<int> buffer;
+
+    for (int b = 0; b < batches; b += 1) {
+      for (int i = 0; i < batchSize; i += 1) {
+        batch[i] = (thread * batches + b) * batchSize + i + 1;
+      }
+      pool.push(batch.data(), batch.data() + batchSize);
+
+      if (1 == b % 2) {
+        size_t size = pool.pop(buffer, 0);
+        taken[thread].insert(taken[thread].end(), buffer.begin(), buffer.begin() + size);
+      }
+    }
+  }
+
+  std::vector<int> all;
+  for (std::vector<int> const& indices : taken) {
+    all.insert(all.end(), indices.begin(), indices.end());
+  }
+
+  std::vector<int> buffer;
+  size_t size = 0;
+  while (0 != (size = pool.pop(buffer, 0))) {
+    all.insert(all.end(), buffer.begin(), buffer.begin() + size);
+  }
+
+  bool complete = (size_t)(Threads * batches * batchSize) == all.size();
+  out << "Pool returns every index exactly once: " << (complete && isUnique(all) ? "yes" : "no") << std::endl;
+  out << "Pool is empty: " << (0 == pool.getNumberOfBatches() ? "yes" : "no") << std::endl;
+}
+
+/// Pairs of threads, one thread assigns indices and the other one frees them. The freeing managers move blocks to the
+/// global pool, the assigning managers steal them.
+void testIndexManagers(std::ofstream& out) {
+  int const pairs = Threads / 2;
+  int const rounds = 50;
+  int const perRound = 100000;
+  unsigned long const increment = codi::Config::SmallChunkSize;
+
+  std::vector<std::vector<int>> slots(pairs, std::vector<int>(perRound, 0));
+
+  bool unique = true;
+  unsigned long storedAssigning = 0;
+  unsigned long storedFreeing = 0;
+  unsigned long stolen = 0;
+  unsigned long minted = 0;
+  unsigned long pooledBlocks = 0;
+
+#pragma omp parallel num_threads(Threads)
+  {
+    int const thread = omp_get_thread_num();
+    std::vector<int>& pairSlots = slots[thread / 2];
+    bool const assigning = 0 == thread % 2;
+
+    IndexManager manager(0);
+
+    for (int round = 0; round < rounds; round += 1) {
+      if (assigning) {
+        for (int& index : pairSlots) {
+          manager.template assignIndex<Tape>(index);
+        }
+      }
+
+#pragma omp barrier
+#pragma omp single
+      {
+        std::vector<int> live;
+        for (std::vector<int> const& indices : slots) {
+          live.insert(live.end(), indices.begin(), indices.end());
+        }
+        unique &= isUnique(live);
+      }
+
+      if (!assigning) {
+        for (int& index : pairSlots) {
+          manager.template freeIndex<Tape>(index);
+        }
+      }
+
+#pragma omp barrier
+    }
+
+    codi::TapeValues values("Index manager");
+    manager.addToTapeValues(values);
+
+#pragma omp critical
+    {
+      if (assigning) {
+        storedAssigning += getEntry(values, "Indices stored");
+      } else {
+        storedFreeing += getEntry(values, "Indices stored");
+      }
+      stolen = getEntry(values, "Indices stolen");
+      minted = getEntry(values, "Indices minted");
+      pooledBlocks = getEntry(values, "Pooled index blocks");
+    }
+
+#pragma omp barrier
+  }
+
+  unsigned long const assigned = (unsigned long)pairs * rounds * perRound;
+  // The freeing managers only create indices in their constructor.
+  unsigned long const mintedByAssigning = minted - pairs * increment;
+
+  out << "No index is handed out twice: " << (unique ? "yes" : "no") << std::endl;
+  out << "Indices are stolen: " << (0 != stolen ? "yes" : "no") << std::endl;
+  out << "Assigned indices are minted or stolen: "
+      << (assigned == mintedByAssigning + stolen - storedAssigning ? "yes" : "no") << std::endl;
+  out << "Minted indices are stored or pooled: "
+      << (minted == storedAssigning + storedFreeing + pooledBlocks * increment ? "yes" : "no") << std::endl;
+  out << "Fewer indices minted than assigned: " << (minted < assigned ? "yes" : "no") << std::endl;
+}
+
+int main(int nargs, char** args) {
+  std::ofstream out("run.out");
+
+  testPool(out);
+  testIndexManagers(out);
+
+  return 0;
+}
@@ -0,0 +1 @@
+#define DRIVER_TESTS 	TestPreaccumulationVertexElimination,TestPreaccumulationSparse,TestPreaccumulation
@@ -0,0 +1 @@
+#define DRIVER_TESTS 	TestCopy,TestCopyHigherOrder,TestExpr,TestExprHigherOrder,TestIndices,TestOutput,TestOneArgumentExceptions,TestTwoArgumentExceptions,TestAssignOperators1,TestAssignOperators2,TestBigExpressions,TestIncrementOperators,TestOneArgumentExpr1,TestOneArgumentExpr2,TestOneArgumentExpr3,TestTwoArgumentExpr1,TestTwoArgumentExpr2,TestExtFunctionCall,TestExtFunctionCallMultiple,TestIO,TestSwap,TestReferenceActiveType,TestNumericLimits,TestEigenLinearSystemSolverHandler,TestEigenSparseLinearSystemSolverHandler,TestEnzymeExternalFunctionHelper,TestExternalFunctionHelper,TestExternalFunctionHelperPassive,TestPreaccumulation,TestPreaccumulationForward,TestPreaccumulationForwardInvalidAdjoint,TestPreaccumulationLargeStatement,TestPreaccumulationPassiveValue,TestPreaccumulationSparse,TestPreaccumulationVertexElimination,TestPreaccumulationZeroJacobi,TestReset,TestStatementPushHelper,TestMatrixMatrixMultiplication
@@ -0,0 +1,168 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <codi.hpp>
+#include <codi/tools/data/jacobian.hpp>
+#include <omp.h>
+
+#include <limits>
+#include <vector>
+
+#include "../driver1stOrderBase.hpp"
+
+#include DRIVER_TESTS_INC
+
+struct CoDiReverse1stOrderReplicated : public Driver1stOrderBase<CODI_TYPE> {
+  public:
+
+    using Number = CODI_DECLARE_DEFAULT(
+        CODI_TYPE, CODI_TEMPLATE(codi::LhsExpressionInterface<double, double, CODI_ANY, CODI_ANY>));
+
+    using Tape = CODI_DD(typename Number::Tape, CODI_T(codi::FullTapeInterface<double, double, int, CODI_ANY>));
+    using Base = Driver1stOrderBase<Number>;
+
+    using Gradient = typename Number::Gradient;
+    using Adjoints = typename Tape::Adjoints;
+
+    static int constexpr Threads = 4;
+
+    CoDiReverse1stOrderReplicated() : Base(CODI_TO_STRING(CODI_TYPE_NAME)) {}
+
+    void createAllTests(TestVector<Number>& tests) {
+      createTests<Number, DRIVER_TESTS>(tests);
+    }
+
+    void evaluateJacobian(TestInfo<Number>& info, Number* x, size_t inputs, Number* y, size_t outputs,
+                          codi::Jacobian<double>& jac) {
+      size_t constexpr gradDim = codi::GradientTraits::dim<Gradient>();
+
+      // Each thread records the function on its own tape with its own copy of the inputs.
+      std::vector<std::vector<Number>> threadX(Threads, std::vector<Number>(inputs));
+      std::vector<std::vector<Number>> threadY(Threads, std::vector<Number>(outputs));
+
+#pragma omp parallel num_threads(Threads)
+      {
+        int const thread = omp_get_thread_num();
+        std::vector<Number>& curX = threadX[thread];
+        std::vector<Number>& curY = threadY[thread];
+
+        // The test functions are not thread-safe, only the tapes are thread local.
+#pragma omp critical
+        {
+          Tape& tape = Number::getTape();
+          tape.setActive();
+
+          for (size_t i = 0; i < inputs; ++i) {
+            curX[i] = x[i].getValue();
+            tape.registerInput(curX[i]);
+          }
+
+          info.func(curX.data(), curY.data());
+
+          for (size_t i = 0; i < outputs; ++i) {
+            tape.registerOutput(curY[i]);
+          }
+
+          tape.setPassive();
+        }
+      }
+
+      for (size_t i = 0; i < outputs; ++i) {
+        y[i] = threadY[0][i].getValue();
+      }
+
+      Tape& tape = Number::getTape();
+      tape.resizeAdjointVector();
+
+      size_t runs = outputs / gradDim;
+      if (outputs % gradDim != 0) {
+        runs += 1;
+      }
+
+      for (size_t curOut = 0; curOut < runs; ++curOut) {
+        size_t curSize = gradDim;
+        if ((curOut + 1) * gradDim > (size_t)outputs) {
+          curSize = outputs % gradDim;
+        }
+
+        for (int thread = 0; thread < Threads; ++thread) {
+          for (size_t curDim = 0; curDim < curSize; ++curDim) {
+            Number& output = threadY[thread][curOut * gradDim + curDim];
+            if (tape.isIdentifierActive(output.getIdentifier())) {
+              codi::GradientTraits::at(tape.gradient(output.getIdentifier()), curDim) = 1.0;
+            }
+          }
+        }
+
+        // Each thread reverses its own tape on its own copy of the adjoints.
+        Adjoints::startReplication(Threads);
+#pragma omp parallel num_threads(Threads)
+        {
+          Number::getTape().evaluate();
+          Adjoints::reduceReplicas();
+        }
+        Adjoints::stopReplication();
+
+        for (size_t curDim = 0; curDim < curSize; ++curDim) {
+          for (size_t curIn = 0; curIn < inputs; ++curIn) {
+            double value = getAdjoint(tape, threadX[0][curIn], curDim);
+
+            // All threads evaluated the same function, a mismatch fails the comparison with the reference.
+            for (int thread = 1; thread < Threads; ++thread) {
+              if (value != getAdjoint(tape, threadX[thread][curIn], curDim)) {
+                value = std::numeric_limits<double>::quiet_NaN();
+              }
+            }
+
+            jac(curOut * gradDim + curDim, curIn) = value;
+          }
+        }
+
+        tape.clearAdjoints();
+      }
+
+#pragma omp parallel num_threads(Threads)
+      {
+        Number::getTape().reset();
+      }
+    }
+
+  private:
+
+    static double getAdjoint(Tape& tape, Number const& value, size_t dim) {
+      return codi::GradientTraits::at<Gradient>(tape.getGradient(value.getIdentifier()), dim);
+    }
+};
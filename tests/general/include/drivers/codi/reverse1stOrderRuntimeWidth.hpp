@@ -0,0 +1,96 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <codi.hpp>
+#include <codi/tools/data/jacobian.hpp>
+
+#include "../driver1stOrderBase.hpp"
+
+#include DRIVER_TESTS_INC
+
+struct CoDiReverse1stOrderRuntimeWidth : public Driver1stOrderBase<CODI_TYPE> {
+  public:
+
+    using Number = CODI_DECLARE_DEFAULT(
+        CODI_TYPE, CODI_TEMPLATE(codi::LhsExpressionInterface<double, double, CODI_ANY, CODI_ANY>));
+
+    using Tape = CODI_DD(typename Number::Tape, CODI_T(codi::FullTapeInterface<double, double, int, CODI_ANY>));
+    using Base = Driver1stOrderBase<Number>;
+
+    CoDiReverse1stOrderRuntimeWidth() : Base(CODI_TO_STRING(CODI_TYPE_NAME)) {}
+
+    void createAllTests(TestVector<Number>& tests) {
+      createTests<Number, DRIVER_TESTS>(tests);
+    }
+
+    void evaluateJacobian(TestInfo<Number>& info, Number* x, size_t inputs, Number* y, size_t outputs,
+                          codi::Jacobian<double>& jac) {
+      Tape& tape = Number::getTape();
+
+      tape.setActive();
+
+      for (size_t i = 0; i < inputs; ++i) {
+        tape.registerInput(x[i]);
+      }
+
+      info.func(x, y);
+
+      for (size_t i = 0; i < outputs; ++i) {
+        tape.registerOutput(y[i]);
+      }
+
+      tape.setPassive();
+
+      // All outputs are evaluated in one sweep.
+      codi::RuntimeWidthAdjointVectorHelper<Number> helper(std::max(outputs, (size_t)1));
+
+      for (size_t curOut = 0; curOut < outputs; ++curOut) {
+        if (tape.isIdentifierActive(y[curOut].getIdentifier())) {
+          helper.gradient(y[curOut].getIdentifier(), curOut) = 1.0;
+        }
+      }
+
+      helper.evaluate();
+
+      for (size_t curOut = 0; curOut < outputs; ++curOut) {
+        for (size_t curIn = 0; curIn < inputs; ++curIn) {
+          jac(curOut, curIn) = helper.getGradient(x[curIn].getIdentifier(), curOut);
+        }
+      }
+
+      tape.reset();
+    }
+};
@@ -0,0 +1,124 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#pragma once
+
+#include <codi.hpp>
+#include <codi/tools/data/sparseHessian.hpp>
+
+#include "../driver2ndOrderBase.hpp"
+
+#include DRIVER_TESTS_INC
+
+struct CoDiReverse2ndOrderSparseHessian : public Driver2ndOrderBase<CODI_TYPE> {
+  public:
+
+    using Number = CODI_TYPE;
+
+    using Base = Driver2ndOrderBase;
+
+    using Tape = Number::Tape;
+
+    CoDiReverse2ndOrderSparseHessian() : Base(CODI_TO_STRING(CODI_TYPE_NAME)) {}
+
+    void createAllTests(TestVector<Number>& tests) {
+      createTests<Number, DRIVER_TESTS>(tests);
+    }
+
+    void evaluateHessian(TestInfo<Number>& info, Number* x, size_t inputs, Number* y, size_t outputs,
+                         codi::Hessian<double>& hes) {
+      evaluateHessian<Number>(info, x, inputs, y, outputs, hes, codi::TapeTraits::IsPrimalValueTape<Tape>());
+    }
+
+  private:
+
+    // Pattern detection and compressed evaluation on the recorded tape.
+    template<typename Num>
+    void evaluateHessian(TestInfo<Num>& info, Num* x, size_t inputs, Num* y, size_t outputs,
+                         codi::Hessian<double>& hes, std::true_type) {
+      codi::TapeHelper<Num> th;
+
+      th.startRecording();
+
+      for (size_t i = 0; i < inputs; ++i) {
+        th.registerInput(x[i]);
+      }
+
+      info.func(x, y);
+
+      for (size_t i = 0; i < outputs; ++i) {
+        th.registerOutput(y[i]);
+      }
+
+      th.stopRecording();
+
+      typename codi::TapeHelper<Num>::SparseHessianType& sparseHes = th.createSparseHessian();
+
+      th.evalHessian(sparseHes);
+
+      copyHessian(sparseHes, inputs, outputs, hes);
+
+      th.deleteSparseHessian(sparseHes);
+      Num::getTape().reset();
+    }
+
+    // Pattern detection and compressed evaluation with a recording for each color.
+    template<typename Num>
+    void evaluateHessian(TestInfo<Num>& info, Num* x, size_t inputs, Num* /*y*/, size_t outputs,
+                         codi::Hessian<double>& hes, std::false_type) {
+      std::vector<Num> xVec(x, x + inputs);
+      std::vector<Num> yVec(outputs);
+
+      auto evalFunc = [&](std::vector<Num>& x, std::vector<Num>& y) { info.func(x.data(), y.data()); };
+
+      codi::SparsityPattern pattern;
+      codi::Algorithms<Num>::computeHessianSparsityPattern(evalFunc, xVec, yVec, pattern);
+
+      codi::SparseHessian<double> sparseHes(outputs, std::move(pattern));
+      codi::Algorithms<Num>::computeSparseHessian(evalFunc, xVec, yVec, sparseHes);
+
+      copyHessian(sparseHes, inputs, outputs, hes);
+    }
+
+    void copyHessian(codi::SparseHessian<double> const& sparseHes, size_t inputs, size_t outputs,
+                     codi::Hessian<double>& hes) {
+      for (size_t i = 0; i < outputs; ++i) {
+        for (size_t j = 0; j < inputs; ++j) {
+          for (size_t k = 0; k < inputs; ++k) {
+            hes(i, j, k) = sparseHes(i, j, k);
+          }
+        }
+      }
+    }
+};
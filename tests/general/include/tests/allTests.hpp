@@ -65,6 +65,8 @@
 #include "tools/helpers/testPreaccumulationForwardInvalidAdjoint.hpp"
 #include "tools/helpers/testPreaccumulationLargeStatement.hpp"
 #include "tools/helpers/testPreaccumulationPassiveValue.hpp"
+#include "tools/helpers/testPreaccumulationSparse.hpp"
+#include "tools/helpers/testPreaccumulationVertexElimination.hpp"
 #include "tools/helpers/testPreaccumulationZeroJacobi.hpp"
 #include "tools/helpers/testReset.hpp"
 #include "tools/helpers/testStatementPushHelper.hpp"
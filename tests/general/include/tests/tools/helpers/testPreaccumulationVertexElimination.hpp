@@ -0,0 +1,91 @@
+/*
+ * CoDiPack, a Code Differentiation Package
+ *
+ * Copyright (C) 2015-2024 Chair for Scientific Computing (SciComp), University of Kaiserslautern-Landau
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum, Johannes Blühdorn (SciComp, University of Kaiserslautern-Landau)
+ *
+ * This file is part of CoDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * CoDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * CoDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with CoDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For other licensing options please contact us.
+ *
+ * Authors:
+ *  - SciComp, University of Kaiserslautern-Landau:
+ *    - Max Sagebaum
+ *    - Johannes Blühdorn
+ *    - Former members:
+ *      - Tim Albring
+ */
+#include "../../../testInterface.hpp"
+
+struct TestPreaccumulationVertexElimination : public TestInterface {
+  public:
+    NAME("PreaccumulationVertexElimination")
+    IN(2)
+    OUT(2)
+    POINTS(1) = {{1.0, 0.5}};
+
+    template<typename Number>
+    static void evalFunc(Number* x, Number* y, size_t size) {
+      // All outputs depend on the inputs through the scalar s.
+      Number t = 0.0;
+      for (size_t i = 0; i < size; ++i) {
+        t += x[i] * x[i];
+      }
+      Number s = sqrt(t);
+
+      for (size_t i = 0; i < size; ++i) {
+        y[i] = s * x[(i + 1) % size];
+      }
+      y[size - 1] += sin(y[0]);  // Output that depends on another output.
+    }
+
+    template<typename Number>
+    static void func(Number* x, Number* y) {
+      codi::PreaccumulationHelper<Number> ph;
+      ph.setStrategy(codi::PreaccumulationStrategy::VertexElimination);
+
+      size_t const size = 8;
+      Number intermediate[size];
+      Number local[size];
+
+      for (size_t i = 0; i < size; ++i) {
+        intermediate[i] = x[0] * (double)i + x[1];
+      }
+
+      ph.start();
+      for (size_t i = 0; i < size; ++i) {
+        ph.addInput(intermediate[i]);
+      }
+
+      evalFunc(intermediate, local, size);
+
+      for (size_t i = 0; i < size; ++i) {
+        ph.addOutput(local[i]);
+      }
+      ph.finish(false);
+
+      y[0] = 0.0;
+      y[1] = 0.0;
+      for (size_t i = 0; i < size; ++i) {
+        y[0] += local[i];
+        y[1] += (double)i * local[i];
+      }
+    }
+};